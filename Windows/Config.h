@@ -2,14 +2,11 @@
 
 #include <string>
 #include <vector>
+#include <memory>
 #include <stdint.h>
+#include "TRTCConfigLoader.h"
 
-struct UserInfo
-{
-    std::string userId;
-    std::string userSig;
-};
-
+//Config.json ֻͼ TRTCGetUserIDAndUserSig  TRTCConfigLoader Ľ
 class Config
 {
 protected:
@@ -24,8 +21,8 @@ public:
     bool load();
 
     uint32_t getSdkAppId() const;
-    std::vector<UserInfo> getUserInfos() const;
+    //ûбͨĿշʣзص shared_ptr ڼ伴ʹ load Ҳᱻͷ
+    std::shared_ptr<const UserInfoTable> getUserTable() const;
 private:
-    uint32_t m_sdkAppId;
-    std::vector<UserInfo> m_userInfos;
+    std::shared_ptr<const UserInfoTable> m_userTable;
 };
@@ -0,0 +1,755 @@
+/*
+* Module:   TRTCCallbackDispatcher
+*
+* Function:  SDK صתߣÿԼ߳ϴļ߲ס SDK ص̺߳
+*/
+
+#include "TRTCCallbackDispatcher.h"
+#include "BoundedQueue.h"
+#include "LatencyHistogram.h"
+
+#include <string>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+#include <chrono>
+#include <algorithm>
+
+typedef std::chrono::steady_clock DispatchClock;
+
+enum CallbackEventType
+{
+    EventError,
+    EventWarning,
+    EventEnterRoom,
+    EventExitRoom,
+    EventUserEnter,
+    EventUserExit,
+    EventUserVideoAvailable,
+    EventUserSubStreamAvailable,
+    EventUserAudioAvailable,
+    EventUserVoiceVolume,
+    EventNetworkQuality,
+    EventStatistics,
+    EventFirstVideoFrame,
+    EventFirstAudioFrame,
+    EventPlayBGMBegin,
+    EventPlayBGMProgress,
+    EventPlayBGMComplete,
+    EventConnectionLost,
+    EventTryToReconnect,
+    EventConnectionRecovery,
+    EventSpeedTest,
+    EventCameraDidReady,
+    EventMicDidReady,
+    EventDeviceChange,
+    EventTestMicVolume,
+    EventTestSpeakerVolume,
+    EventRecvCustomCmdMsg,
+    EventMissCustomCmdMsg,
+    EventStartPublishCDNStream,
+    EventStopPublishCDNStream,
+    EventScreenCaptureCovered,
+    EventScreenCaptureStarted,
+    EventScreenCapturePaused,
+    EventScreenCaptureResumed,
+    EventScreenCaptureStoped,
+};
+
+//Ժϲ״̬صÿÿռһλ
+static const int kCoalesceSlotCount = 6;
+
+static int coalesceSlot(int type)
+{
+    switch (type)
+    {
+    case EventUserVoiceVolume: return 0;
+    case EventNetworkQuality: return 1;
+    case EventStatistics: return 2;
+    case EventPlayBGMProgress: return 3;
+    case EventTestMicVolume: return 4;
+    case EventTestSpeakerVolume: return 5;
+    default: return -1;
+    }
+}
+
+//һλصĲ߹ظʱֶֻΣַ
+struct TRTCCallbackDispatcher::Event
+{
+    int type = EventError;
+    std::atomic<int> refCount;
+    DispatchClock::time_point postTime;
+
+    int64_t arg0 = 0;
+    int64_t arg1 = 0;
+    int64_t arg2 = 0;
+    void* ptr = NULL;
+    std::string str;        //userIddeviceId  errMsg
+    std::vector<uint8_t> bytes;
+
+    std::vector<TRTCVolumeInfo> volumes;
+    TRTCQualityInfo localQuality;
+    std::vector<TRTCQualityInfo> qualities;
+    TRTCStatistics statis;
+    std::vector<TRTCLocalStatistics> localStats;
+    std::vector<TRTCRemoteStatistics> remoteStats;
+    TRTCSpeedTestResult speedResult;
+
+    Event() : refCount(0) {}
+};
+
+typedef TRTCCallbackDispatcher::Event CallbackEvent;
+
+struct TRTCCallbackDispatcher::EventPool
+{
+    EventPool() : freeEvents(1024) {}
+
+    ~EventPool()
+    {
+        CallbackEvent* event = NULL;
+        while (freeEvents.TryPop(event))
+            delete event;
+    }
+
+    CallbackEvent* acquire()
+    {
+        CallbackEvent* event = NULL;
+        if (!freeEvents.TryPop(event))
+            event = new CallbackEvent();
+        return event;
+    }
+
+    void release(CallbackEvent* event)
+    {
+        if (event == NULL || event->refCount.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+        if (!freeEvents.TryPush(event))
+            delete event;
+    }
+
+    CBoundedQueue<CallbackEvent*> freeEvents;
+};
+
+//һֱָ¼ָһϲλʱȡλµ¼
+struct DispatchEntry
+{
+    CallbackEvent* event;
+    int slot;
+};
+
+struct TRTCCallbackDispatcher::Listener
+{
+    Listener(ITRTCCloudCallback* callback, const TRTCCallbackListenerOptions& options, const std::shared_ptr<EventPool>& pool)
+        : callback(callback)
+        , options(options)
+        , pool(pool)
+        , queue(std::max<uint32_t>(options.queueCapacity, 2))
+        , bSleeping(false)
+        , bStop(false)
+        , maxDepth(0)
+        , delivered(0)
+        , dropped(0)
+        , coalesced(0)
+        , totalLatencyUs(0)
+        , maxLatencyUs(0)
+        , totalHandleUs(0)
+    {
+        for (int i = 0; i < kCoalesceSlotCount; ++i)
+            latest[i].store(NULL);
+    }
+
+    ~Listener()
+    {
+        DispatchEntry entry;
+        while (queue.TryPop(entry))
+            discard(entry);
+        for (int i = 0; i < kCoalesceSlotCount; ++i)
+            pool->release(latest[i].exchange(NULL));
+    }
+
+    void discard(const DispatchEntry& entry)
+    {
+        CallbackEvent* event = entry.event ? entry.event : latest[entry.slot].exchange(NULL);
+        if (event)
+        {
+            pool->release(event);
+            ++dropped;
+        }
+    }
+
+    //ߵãܺ͹߳Լ߲
+    void enqueue(CallbackEvent* event)
+    {
+        DispatchEntry entry = { event, -1 };
+        int slot = options.bCoalescePeriodic ? coalesceSlot(event->type) : -1;
+        if (slot >= 0)
+        {
+            //λѾδͬ¼ʱѾռλ滻µļ
+            CallbackEvent* old = latest[slot].exchange(event);
+            if (old)
+            {
+                pool->release(old);
+                ++coalesced;
+                return;
+            }
+            entry.event = NULL;
+            entry.slot = slot;
+        }
+
+        if (!push(entry))
+        {
+            discard(entry);
+            return;
+        }
+
+        uint32_t depth = (uint32_t)queue.SizeApprox();
+        uint32_t oldMax = maxDepth.load(std::memory_order_relaxed);
+        while (depth > oldMax && !maxDepth.compare_exchange_weak(oldMax, depth))
+        {
+        }
+
+        //빤̵߳ bSleeping Ͷмԣ֤©
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (bSleeping.load(std::memory_order_relaxed))
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            cond.notify_one();
+        }
+    }
+
+    bool push(const DispatchEntry& entry)
+    {
+        if (queue.TryPush(entry))
+            return true;
+        if (options.overflowPolicy != TRTCCallbackOverflowDropOldest)
+            return false;
+
+        //¼ʱܱȣԼȻʧܾͷǰ¼
+        for (int i = 0; i < 4; ++i)
+        {
+            DispatchEntry oldest;
+            if (queue.TryPop(oldest))
+                discard(oldest);
+            if (queue.TryPush(entry))
+                return true;
+        }
+        return false;
+    }
+
+    void threadProc()
+    {
+        while (!bStop.load())
+        {
+            DispatchEntry entry;
+            if (queue.TryPop(entry))
+            {
+                deliver(entry);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(mutex);
+            bSleeping.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            cond.wait(lock, [this]() { return bStop.load() || queue.SizeApprox() > 0; });
+            bSleeping.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    void deliver(const DispatchEntry& entry)
+    {
+        CallbackEvent* event = entry.event ? entry.event : latest[entry.slot].exchange(NULL);
+        if (event == NULL)
+            return;
+
+        DispatchClock::time_point start = DispatchClock::now();
+        uint64_t latencyUs = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(start - event->postTime).count();
+        invoke(*event);
+        uint64_t handleUs = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(DispatchClock::now() - start).count();
+        pool->release(event);
+
+        ++delivered;
+        totalLatencyUs += latencyUs;
+        totalHandleUs += handleUs;
+        uint64_t oldMax = maxLatencyUs.load(std::memory_order_relaxed);
+        while (latencyUs > oldMax && !maxLatencyUs.compare_exchange_weak(oldMax, latencyUs))
+        {
+        }
+        latencyHistogram.Add(latencyUs);
+    }
+
+    void invoke(CallbackEvent& event);
+
+    ITRTCCloudCallback* callback;
+    TRTCCallbackListenerOptions options;
+    std::shared_ptr<EventPool> pool;
+    CBoundedQueue<DispatchEntry> queue;
+    std::atomic<CallbackEvent*> latest[kCoalesceSlotCount];
+
+    std::mutex mutex;       //ֻڹ߳ߺͻ
+    std::condition_variable cond;
+    std::atomic<bool> bSleeping;
+    std::atomic<bool> bStop;
+    std::thread thread;
+
+    std::atomic<uint32_t> maxDepth;
+    std::atomic<uint64_t> delivered;
+    std::atomic<uint64_t> dropped;
+    std::atomic<uint64_t> coalesced;
+    std::atomic<uint64_t> totalLatencyUs;
+    std::atomic<uint64_t> maxLatencyUs;
+    std::atomic<uint64_t> totalHandleUs;
+    CAtomicLatencyHistogram latencyHistogram;
+};
+
+void TRTCCallbackDispatcher::Listener::invoke(CallbackEvent& event)
+{
+    const char* str = event.str.c_str();
+    switch (event.type)
+    {
+    case EventError: callback->onError((TXLiteAVError)event.arg0, str, event.ptr); break;
+    case EventWarning: callback->onWarning((TXLiteAVWarning)event.arg0, str, event.ptr); break;
+    case EventEnterRoom: callback->onEnterRoom((uint64_t)event.arg0); break;
+    case EventExitRoom: callback->onExitRoom((int)event.arg0); break;
+    case EventUserEnter: callback->onUserEnter(str); break;
+    case EventUserExit: callback->onUserExit(str, (int)event.arg0); break;
+    case EventUserVideoAvailable: callback->onUserVideoAvailable(str, event.arg0 != 0); break;
+    case EventUserSubStreamAvailable: callback->onUserSubStreamAvailable(str, event.arg0 != 0); break;
+    case EventUserAudioAvailable: callback->onUserAudioAvailable(str, event.arg0 != 0); break;
+    case EventUserVoiceVolume:
+        callback->onUserVoiceVolume(event.volumes.empty() ? NULL : &event.volumes[0], (uint32_t)event.volumes.size(), (uint32_t)event.arg0);
+        break;
+    case EventNetworkQuality:
+        callback->onNetworkQuality(event.localQuality, event.qualities.empty() ? NULL : &event.qualities[0], (uint32_t)event.qualities.size());
+        break;
+    case EventStatistics: callback->onStatistics(event.statis); break;
+    case EventFirstVideoFrame: callback->onFirstVideoFrame(str, (uint32_t)event.arg0, (uint32_t)event.arg1); break;
+    case EventFirstAudioFrame: callback->onFirstAudioFrame(str); break;
+    case EventPlayBGMBegin: callback->onPlayBGMBegin((TXLiteAVError)event.arg0); break;
+    case EventPlayBGMProgress: callback->onPlayBGMProgress((uint32_t)event.arg0, (uint32_t)event.arg1); break;
+    case EventPlayBGMComplete: callback->onPlayBGMComplete((TXLiteAVError)event.arg0); break;
+    case EventConnectionLost: callback->onConnectionLost(); break;
+    case EventTryToReconnect: callback->onTryToReconnect(); break;
+    case EventConnectionRecovery: callback->onConnectionRecovery(); break;
+    case EventSpeedTest: callback->onSpeedTest(event.speedResult, (uint32_t)event.arg0, (uint32_t)event.arg1); break;
+    case EventCameraDidReady: callback->onCameraDidReady(); break;
+    case EventMicDidReady: callback->onMicDidReady(); break;
+    case EventDeviceChange: callback->onDeviceChange(str, (TRTCDeviceType)event.arg0, (TRTCDeviceState)event.arg1); break;
+    case EventTestMicVolume: callback->onTestMicVolume((uint32_t)event.arg0); break;
+    case EventTestSpeakerVolume: callback->onTestSpeakerVolume((uint32_t)event.arg0); break;
+    case EventRecvCustomCmdMsg:
+        callback->onRecvCustomCmdMsg(str, (int32_t)event.arg0, (uint32_t)event.arg1, event.bytes.empty() ? NULL : &event.bytes[0], (uint32_t)event.bytes.size());
+        break;
+    case EventMissCustomCmdMsg: callback->onMissCustomCmdMsg(str, (int32_t)event.arg0, (int32_t)event.arg1, (int32_t)event.arg2); break;
+    case EventStartPublishCDNStream: callback->onStartPublishCDNStream((int)event.arg0, str); break;
+    case EventStopPublishCDNStream: callback->onStopPublishCDNStream((int)event.arg0, str); break;
+    case EventScreenCaptureCovered: callback->onScreenCaptureCovered(); break;
+    case EventScreenCaptureStarted: callback->onScreenCaptureStarted(); break;
+    case EventScreenCapturePaused: callback->onScreenCapturePaused((int)event.arg0); break;
+    case EventScreenCaptureResumed: callback->onScreenCaptureResumed((int)event.arg0); break;
+    case EventScreenCaptureStoped: callback->onScreenCaptureStoped((int)event.arg0); break;
+    }
+}
+
+static void listenerThreadProc(std::shared_ptr<TRTCCallbackDispatcher::Listener> listener)
+{
+    listener->threadProc();
+}
+
+TRTCCallbackDispatcher::TRTCCallbackDispatcher()
+    : m_pool(std::make_shared<EventPool>())
+    , m_listeners(std::make_shared<ListenerList>())
+{
+
+}
+
+TRTCCallbackDispatcher::~TRTCCallbackDispatcher()
+{
+    std::shared_ptr<const ListenerList> listeners = std::atomic_load(&m_listeners);
+    for (size_t i = 0; i < listeners->size(); ++i)
+        removeListener((*listeners)[i]->callback);
+}
+
+void TRTCCallbackDispatcher::addListener(ITRTCCloudCallback* listener, const TRTCCallbackListenerOptions& options)
+{
+    if (listener == NULL)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_listenerMutex);
+    std::shared_ptr<const ListenerList> listeners = std::atomic_load(&m_listeners);
+    for (size_t i = 0; i < listeners->size(); ++i)
+    {
+        if ((*listeners)[i]->callback == listener)
+            return;
+    }
+
+    std::shared_ptr<Listener> item = std::make_shared<Listener>(listener, options, m_pool);
+    item->thread = std::thread(listenerThreadProc, item);
+
+    std::shared_ptr<ListenerList> newListeners = std::make_shared<ListenerList>(*listeners);
+    newListeners->push_back(item);
+    std::atomic_store(&m_listeners, std::shared_ptr<const ListenerList>(newListeners));
+}
+
+void TRTCCallbackDispatcher::removeListener(ITRTCCloudCallback* listener)
+{
+    std::shared_ptr<Listener> item;
+    {
+        std::lock_guard<std::mutex> lock(m_listenerMutex);
+        std::shared_ptr<const ListenerList> listeners = std::atomic_load(&m_listeners);
+        std::shared_ptr<ListenerList> newListeners = std::make_shared<ListenerList>();
+        for (size_t i = 0; i < listeners->size(); ++i)
+        {
+            if ((*listeners)[i]->callback == listener)
+                item = (*listeners)[i];
+            else
+                newListeners->push_back((*listeners)[i]);
+        }
+        if (!item)
+            return;
+        std::atomic_store(&m_listeners, std::shared_ptr<const ListenerList>(newListeners));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(item->mutex);
+        item->bStop.store(true);
+    }
+    item->cond.notify_one();
+
+    //ڼԼĻصƳԼʱܵԼ̳߳ Listener ã˳ͷ
+    if (item->thread.get_id() == std::this_thread::get_id())
+        item->thread.detach();
+    else
+        item->thread.join();
+}
+
+std::vector<TRTCCallbackListenerStats> TRTCCallbackDispatcher::getStats() const
+{
+    std::shared_ptr<const ListenerList> listeners = std::atomic_load(&m_listeners);
+    std::vector<TRTCCallbackListenerStats> result(listeners->size());
+    for (size_t i = 0; i < listeners->size(); ++i)
+    {
+        const Listener& listener = *(*listeners)[i];
+        TRTCCallbackListenerStats& stats = result[i];
+        stats.listener = listener.callback;
+        stats.queueDepth = (uint32_t)listener.queue.SizeApprox();
+        stats.maxQueueDepth = listener.maxDepth.load();
+        stats.deliveredCount = listener.delivered.load();
+        stats.droppedCount = listener.dropped.load();
+        stats.coalescedCount = listener.coalesced.load();
+        stats.maxLatencyUs = listener.maxLatencyUs.load();
+        if (stats.deliveredCount > 0)
+        {
+            stats.avgLatencyUs = listener.totalLatencyUs.load() / stats.deliveredCount;
+            stats.avgHandleUs = listener.totalHandleUs.load() / stats.deliveredCount;
+        }
+        stats.p99LatencyUs = listener.latencyHistogram.P99(stats.maxLatencyUs);
+    }
+    return result;
+}
+
+TRTCCallbackDispatcher::Event* TRTCCallbackDispatcher::newEvent(int type)
+{
+    Event* event = m_pool->acquire();
+    event->type = type;
+    event->arg0 = 0;
+    event->arg1 = 0;
+    event->arg2 = 0;
+    event->ptr = NULL;
+    event->str.clear();
+    return event;
+}
+
+void TRTCCallbackDispatcher::post(Event* event)
+{
+    std::shared_ptr<const ListenerList> listeners = std::atomic_load(&m_listeners);
+    if (listeners->empty())
+    {
+        event->refCount.store(1);
+        m_pool->release(event);
+        return;
+    }
+
+    event->postTime = DispatchClock::now();
+    event->refCount.store((int)listeners->size());
+    for (size_t i = 0; i < listeners->size(); ++i)
+        (*listeners)[i]->enqueue(event);
+}
+
+void TRTCCallbackDispatcher::onError(TXLiteAVError errCode, const char* errMsg, void* arg)
+{
+    Event* event = newEvent(EventError);
+    event->arg0 = errCode;
+    event->str = errMsg ? errMsg : "";
+    event->ptr = arg;
+    post(event);
+}
+
+void TRTCCallbackDispatcher::onWarning(TXLiteAVWarning warningCode, const char* warningMsg, void* arg)
+{
+    Event* event = newEvent(EventWarning);
+    event->arg0 = warningCode;
+    event->str = warningMsg ? warningMsg : "";
+    event->ptr = arg;
+    post(event);
+}
+
+void TRTCCallbackDispatcher::onEnterRoom(uint64_t elapsed)
+{
+    Event* event = newEvent(EventEnterRoom);
+    event->arg0 = (int64_t)elapsed;
+    post(event);
+}
+
+void TRTCCallbackDispatcher::onExitRoom(int reason)
+{
+    Event* event = newEvent(EventExitRoom);
+    event->arg0 = reason;
+    post(event);
+}
+
+void TRTCCallbackDispatcher::onUserEnter(const char* userId)
+{
+    Event* event = newEvent(EventUserEnter);
+    event->str = userId ? userId : "";
+    post(event);
+}
+
+void TRTCCallbackDispatcher::onUserExit(const char* userId, int reason)
+{
+    Event* event = newEvent(EventUserExit);
+    event->str = userId ? userId : "";
+    event->arg0 = reason;
+    post(event);
+}
+
+void TRTCCallbackDispatcher::onUserVideoAvailable(const char* userId, bool available)
+{
+    Event* event = newEvent(EventUserVideoAvailable);
+    event->str = userId ? userId : "";
+    event->arg0 = available;
+    post(event);
+}
+
+void TRTCCallbackDispatcher::onUserSubStreamAvailable(const char* userId, bool available)
+{
+    Event* event = newEvent(EventUserSubStreamAvailable);
+    event->str = userId ? userId : "";
+    event->arg0 = available;
+    post(event);
+}
+
+void TRTCCallbackDispatcher::onUserAudioAvailable(const char* userId, bool available)
+{
+    Event* event = newEvent(EventUserAudioAvailable);
+    event->str = userId ? userId : "";
+    event->arg0 = available;
+    post(event);
+}
+
+void TRTCCallbackDispatcher::onUserVoiceVolume(TRTCVolumeInfo* userVolumes, uint32_t userVolumesCount, uint32_t totalVolume)
+{
+    Event* event = newEvent(EventUserVoiceVolume);
+    if (userVolumes)
+        event->volumes.assign(userVolumes, userVolumes + userVolumesCount);
+    else
+        event->volumes.clear();
+    event->arg0 = totalVolume;
+    post(event);
+}
+
+void TRTCCallbackDispatcher::onNetworkQuality(TRTCQualityInfo localQuality, TRTCQualityInfo* remoteQuality, uint32_t remoteQualityCount)
+{
+    Event* event = newEvent(EventNetworkQuality);
+    event->localQuality = localQuality;
+    if (remoteQuality)
+        event->qualities.assign(remoteQuality, remoteQuality + remoteQualityCount);
+    else
+        event->qualities.clear();
+    post(event);
+}
+
+void TRTCCallbackDispatcher::onStatistics(const TRTCStatistics& statis)
+{
+    Event* event = newEvent(EventStatistics);
+    event->statis = statis;
+    if (statis.localStatisticsArray)
+        event->localStats.assign(statis.localStatisticsArray, statis.localStatisticsArray + statis.localStatisticsArraySize);
+    else
+        event->localStats.clear();
+    if (statis.remoteStatisticsArray)
+        event->remoteStats.assign(statis.remoteStatisticsArray, statis.remoteStatisticsArray + statis.remoteStatisticsArraySize);
+    else
+        event->remoteStats.clear();
+
+    //ָ¼Լĸ
+    event->statis.localStatisticsArray = event->localStats.empty() ? NULL : &event->localStats[0];
+    event->statis.localStatisticsArraySize = (uint32_t)event->localStats.size();
+    event->statis.remoteStatisticsArray = event->remoteStats.empty() ? NULL : &event->remoteStats[0];
+    event->statis.remoteStatisticsArraySize = (uint32_t)event->remoteStats.size();
+    post(event);
+}
+
+void TRTCCallbackDispatcher::onFirstVideoFrame(const char* userId, uint32_t width, uint32_t height)
+{
+    Event* event = newEvent(EventFirstVideoFrame);
+    event->str = userId ? userId : "";
+    event->arg0 = width;
+    event->arg1 = height;
+    post(event);
+}
+
+void TRTCCallbackDispatcher::onFirstAudioFrame(const char* userId)
+{
+    Event* event = newEvent(EventFirstAudioFrame);
+    event->str = userId ? userId : "";
+    post(event);
+}
+
+void TRTCCallbackDispatcher::onPlayBGMBegin(TXLiteAVError errCode)
+{
+    Event* event = newEvent(EventPlayBGMBegin);
+    event->arg0 = errCode;
+    post(event);
+}
+
+void TRTCCallbackDispatcher::onPlayBGMProgress(uint32_t progressMS, uint32_t durationMS)
+{
+    Event* event = newEvent(EventPlayBGMProgress);
+    event->arg0 = progressMS;
+    event->arg1 = durationMS;
+    post(event);
+}
+
+void TRTCCallbackDispatcher::onPlayBGMComplete(TXLiteAVError errCode)
+{
+    Event* event = newEvent(EventPlayBGMComplete);
+    event->arg0 = errCode;
+    post(event);
+}
+
+void TRTCCallbackDispatcher::onConnectionLost()
+{
+    post(newEvent(EventConnectionLost));
+}
+
+void TRTCCallbackDispatcher::onTryToReconnect()
+{
+    post(newEvent(EventTryToReconnect));
+}
+
+void TRTCCallbackDispatcher::onConnectionRecovery()
+{
+    post(newEvent(EventConnectionRecovery));
+}
+
+void TRTCCallbackDispatcher::onSpeedTest(const TRTCSpeedTestResult& currentResult, uint32_t finishedCount, uint32_t totalCount)
+{
+    Event* event = newEvent(EventSpeedTest);
+    event->speedResult = currentResult;
+    event->arg0 = finishedCount;
+    event->arg1 = totalCount;
+    post(event);
+}
+
+void TRTCCallbackDispatcher::onCameraDidReady()
+{
+    post(newEvent(EventCameraDidReady));
+}
+
+void TRTCCallbackDispatcher::onMicDidReady()
+{
+    post(newEvent(EventMicDidReady));
+}
+
+void TRTCCallbackDispatcher::onDeviceChange(const char* deviceId, TRTCDeviceType type, TRTCDeviceState state)
+{
+    Event* event = newEvent(EventDeviceChange);
+    event->str = deviceId ? deviceId : "";
+    event->arg0 = type;
+    event->arg1 = state;
+    post(event);
+}
+
+void TRTCCallbackDispatcher::onTestMicVolume(uint32_t volume)
+{
+    Event* event = newEvent(EventTestMicVolume);
+    event->arg0 = volume;
+    post(event);
+}
+
+void TRTCCallbackDispatcher::onTestSpeakerVolume(uint32_t volume)
+{
+    Event* event = newEvent(EventTestSpeakerVolume);
+    event->arg0 = volume;
+    post(event);
+}
+
+void TRTCCallbackDispatcher::onRecvCustomCmdMsg(const char* userId, int32_t cmdId, uint32_t seq, const uint8_t* msg, uint32_t msgSize)
+{
+    Event* event = newEvent(EventRecvCustomCmdMsg);
+    event->str = userId ? userId : "";
+    event->arg0 = cmdId;
+    event->arg1 = seq;
+    if (msg)
+        event->bytes.assign(msg, msg + msgSize);
+    else
+        event->bytes.clear();
+    post(event);
+}
+
+void TRTCCallbackDispatcher::onMissCustomCmdMsg(const char* userId, int32_t cmdId, int32_t errCode, int32_t missed)
+{
+    Event* event = newEvent(EventMissCustomCmdMsg);
+    event->str = userId ? userId : "";
+    event->arg0 = cmdId;
+    event->arg1 = errCode;
+    event->arg2 = missed;
+    post(event);
+}
+
+void TRTCCallbackDispatcher::onStartPublishCDNStream(int errCode, const char* errMsg)
+{
+    Event* event = newEvent(EventStartPublishCDNStream);
+    event->arg0 = errCode;
+    event->str = errMsg ? errMsg : "";
+    post(event);
+}
+
+void TRTCCallbackDispatcher::onStopPublishCDNStream(int errCode, const char* errMsg)
+{
+    Event* event = newEvent(EventStopPublishCDNStream);
+    event->arg0 = errCode;
+    event->str = errMsg ? errMsg : "";
+    post(event);
+}
+
+void TRTCCallbackDispatcher::onScreenCaptureCovered()
+{
+    post(newEvent(EventScreenCaptureCovered));
+}
+
+void TRTCCallbackDispatcher::onScreenCaptureStarted()
+{
+    post(newEvent(EventScreenCaptureStarted));
+}
+
+void TRTCCallbackDispatcher::onScreenCapturePaused(int reason)
+{
+    Event* event = newEvent(EventScreenCapturePaused);
+    event->arg0 = reason;
+    post(event);
+}
+
+void TRTCCallbackDispatcher::onScreenCaptureResumed(int reason)
+{
+    Event* event = newEvent(EventScreenCaptureResumed);
+    event->arg0 = reason;
+    post(event);
+}
+
+void TRTCCallbackDispatcher::onScreenCaptureStoped(int reason)
+{
+    Event* event = newEvent(EventScreenCaptureStoped);
+    event->arg0 = reason;
+    post(event);
+}
@@ -0,0 +1,118 @@
+#pragma once
+/*
+* Module:   TRTCCallbackDispatcher
+*
+* Function:  SDK صתߣÿԼ߳ϴļ߲ס SDK ص̺߳
+*
+*    1. ΪΨһ ITRTCCloudCallback ע TRTCCloudÿصĲֻһε¼м߹һݣ
+*       ¼صأԸãȶʱٷڴ档
+*
+*    2. ÿһ̶кһ̡߳ʱ overflowPolicy »¼
+*       ͳơԵ״̬صԺϲͬһֻµһ
+*
+*    3. յָ顢ͳȣڶ֮乲ֻܶȡصغʧЧ
+*
+*    4. getStats ÿߵĶȡͺϲԼ SDK ص߿ʼʱӡ
+*/
+
+#include "TRTCCloudCallback.h"
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+
+enum TRTCCallbackOverflowPolicy
+{
+    TRTCCallbackOverflowDropNewest,     //ʱ¼
+    TRTCCallbackOverflowDropOldest,     //ʱ¼
+};
+
+struct TRTCCallbackListenerOptions
+{
+    uint32_t queueCapacity = 256;       //ȡ 2 
+    TRTCCallbackOverflowPolicy overflowPolicy = TRTCCallbackOverflowDropOldest;
+    bool bCoalescePeriodic = true;      //Ե״̬صֻһ
+};
+
+struct TRTCCallbackListenerStats
+{
+    ITRTCCloudCallback* listener = NULL;
+    uint32_t queueDepth = 0;
+    uint32_t maxQueueDepth = 0;
+    uint64_t deliveredCount = 0;
+    uint64_t droppedCount = 0;
+    uint64_t coalescedCount = 0;
+
+    // SDK ص߿ʼʱӣ΢룩p99  2 ݷͰͳƣͰϽ
+    uint64_t avgLatencyUs = 0;
+    uint64_t p99LatencyUs = 0;
+    uint64_t maxLatencyUs = 0;
+    uint64_t avgHandleUs = 0;           //ߴһصƽʱ
+};
+
+class TRTCCallbackDispatcher : public ITRTCCloudCallback
+{
+public:
+    TRTCCallbackDispatcher();
+    virtual ~TRTCCallbackDispatcher();
+
+    void addListener(ITRTCCloudCallback* listener, const TRTCCallbackListenerOptions& options = TRTCCallbackListenerOptions());
+    //غ󲻻лص listener listener ԼĻصʱǰصغֹͣ
+    void removeListener(ITRTCCloudCallback* listener);
+
+    std::vector<TRTCCallbackListenerStats> getStats() const;
+
+    struct Event;
+    struct Listener;
+    struct EventPool;
+public:
+    virtual void onError(TXLiteAVError errCode, const char* errMsg, void* arg);
+    virtual void onWarning(TXLiteAVWarning warningCode, const char* warningMsg, void* arg);
+    virtual void onEnterRoom(uint64_t elapsed);
+    virtual void onExitRoom(int reason);
+    virtual void onUserEnter(const char* userId);
+    virtual void onUserExit(const char* userId, int reason);
+    virtual void onUserVideoAvailable(const char* userId, bool available);
+    virtual void onUserSubStreamAvailable(const char* userId, bool available);
+    virtual void onUserAudioAvailable(const char* userId, bool available);
+    virtual void onUserVoiceVolume(TRTCVolumeInfo* userVolumes, uint32_t userVolumesCount, uint32_t totalVolume);
+    virtual void onNetworkQuality(TRTCQualityInfo localQuality, TRTCQualityInfo* remoteQuality, uint32_t remoteQualityCount);
+    virtual void onStatistics(const TRTCStatistics& statis);
+    virtual void onFirstVideoFrame(const char* userId, uint32_t width, uint32_t height);
+    virtual void onFirstAudioFrame(const char* userId);
+    virtual void onPlayBGMBegin(TXLiteAVError errCode);
+    virtual void onPlayBGMProgress(uint32_t progressMS, uint32_t durationMS);
+    virtual void onPlayBGMComplete(TXLiteAVError errCode);
+    virtual void onConnectionLost();
+    virtual void onTryToReconnect();
+    virtual void onConnectionRecovery();
+    virtual void onSpeedTest(const TRTCSpeedTestResult& currentResult, uint32_t finishedCount, uint32_t totalCount);
+    virtual void onCameraDidReady();
+    virtual void onMicDidReady();
+    virtual void onDeviceChange(const char* deviceId, TRTCDeviceType type, TRTCDeviceState state);
+    virtual void onTestMicVolume(uint32_t volume);
+    virtual void onTestSpeakerVolume(uint32_t volume);
+    virtual void onRecvCustomCmdMsg(const char* userId, int32_t cmdId, uint32_t seq, const uint8_t* msg, uint32_t msgSize);
+    virtual void onMissCustomCmdMsg(const char* userId, int32_t cmdId, int32_t errCode, int32_t missed);
+    virtual void onStartPublishCDNStream(int errCode, const char* errMsg);
+    virtual void onStopPublishCDNStream(int errCode, const char* errMsg);
+    virtual void onScreenCaptureCovered();
+    virtual void onScreenCaptureStarted();
+    virtual void onScreenCapturePaused(int reason);
+    virtual void onScreenCaptureResumed(int reason);
+    virtual void onScreenCaptureStoped(int reason);
+private:
+    TRTCCallbackDispatcher(const TRTCCallbackDispatcher&);
+    TRTCCallbackDispatcher& operator =(const TRTCCallbackDispatcher&);
+
+    Event* newEvent(int type);
+    void post(Event* event);
+private:
+    std::shared_ptr<EventPool> m_pool;
+
+    //SDK ص߳ atomic_load ȡǰļбɾʱ滻
+    typedef std::vector<std::shared_ptr<Listener>> ListenerList;
+    std::shared_ptr<const ListenerList> m_listeners;
+    std::mutex m_listenerMutex;     //лɾ
+};
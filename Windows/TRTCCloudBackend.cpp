@@ -0,0 +1,212 @@
+/*
+* Module:   TRTCCloudBackend
+*
+* Function: ѽõ TRTCCloud ӿڳѹȲͨ SDK 򱾵ģʵ
+*/
+
+#include "TRTCCloudBackend.h"
+
+TRTCCloudBackend::TRTCCloudBackend()
+{
+
+}
+
+TRTCCloudBackend::~TRTCCloudBackend()
+{
+
+}
+
+TRTCCloudBackendFactory TRTCCloudBackend::factory()
+{
+    return []() {
+        return std::unique_ptr<ITRTCCloudBackend>(new TRTCCloudBackend());
+    };
+}
+
+void TRTCCloudBackend::addCallback(ITRTCCloudCallback* callback)
+{
+    m_cloud.addCallback(callback);
+}
+
+void TRTCCloudBackend::removeCallback(ITRTCCloudCallback* callback)
+{
+    m_cloud.removeCallback(callback);
+}
+
+void TRTCCloudBackend::enterRoom(const TRTCParams& params, TRTCAppScene scene)
+{
+    m_cloud.enterRoom(params, scene);
+}
+
+void TRTCCloudBackend::exitRoom()
+{
+    m_cloud.exitRoom();
+}
+
+void TRTCCloudBackend::setVideoEncoderParam(const TRTCVideoEncParam& params)
+{
+    m_cloud.setVideoEncoderParam(params);
+}
+
+void TRTCCloudBackend::setNetworkQosParam(const TRTCNetworkQosParam& params)
+{
+    m_cloud.setNetworkQosParam(params);
+}
+
+void TRTCCloudBackend::enableSmallVideoStream(bool enable, const TRTCVideoEncParam& smallVideoParam)
+{
+    m_cloud.enableSmallVideoStream(enable, smallVideoParam);
+}
+
+void TRTCCloudBackend::setPriorRemoteVideoStreamType(TRTCVideoStreamType type)
+{
+    m_cloud.setPriorRemoteVideoStreamType(type);
+}
+
+void TRTCCloudBackend::setLocalViewFillMode(TRTCVideoFillMode mode)
+{
+    m_cloud.setLocalViewFillMode(mode);
+}
+
+void TRTCCloudBackend::startLocalPreview(HWND rendHwnd)
+{
+    m_cloud.startLocalPreview(rendHwnd);
+}
+
+void TRTCCloudBackend::stopLocalPreview()
+{
+    m_cloud.stopLocalPreview();
+}
+
+void TRTCCloudBackend::startLocalAudio()
+{
+    m_cloud.startLocalAudio();
+}
+
+void TRTCCloudBackend::stopLocalAudio()
+{
+    m_cloud.stopLocalAudio();
+}
+
+void TRTCCloudBackend::setRemoteViewFillMode(const char* userId, TRTCVideoFillMode mode)
+{
+    m_cloud.setRemoteViewFillMode(userId, mode);
+}
+
+void TRTCCloudBackend::startRemoteView(const char* userId, HWND rendHwnd)
+{
+    m_cloud.startRemoteView(userId, rendHwnd);
+}
+
+void TRTCCloudBackend::stopRemoteView(const char* userId)
+{
+    m_cloud.stopRemoteView(userId);
+}
+
+void TRTCCloudBackend::stopAllRemoteView()
+{
+    m_cloud.stopAllRemoteView();
+}
+
+TRTCFakeCloudBackend::TRTCFakeCloudBackend(const TRTCFakeCloudParams& fakeParams)
+    : m_cloud(fakeParams)
+{
+
+}
+
+TRTCFakeCloudBackend::~TRTCFakeCloudBackend()
+{
+
+}
+
+TRTCCloudBackendFactory TRTCFakeCloudBackend::factory(const TRTCFakeCloudParams& fakeParams)
+{
+    return [fakeParams]() {
+        return std::unique_ptr<ITRTCCloudBackend>(new TRTCFakeCloudBackend(fakeParams));
+    };
+}
+
+void TRTCFakeCloudBackend::addCallback(ITRTCCloudCallback* callback)
+{
+    m_cloud.addCallback(callback);
+}
+
+void TRTCFakeCloudBackend::removeCallback(ITRTCCloudCallback* callback)
+{
+    m_cloud.removeCallback(callback);
+}
+
+void TRTCFakeCloudBackend::enterRoom(const TRTCParams& params, TRTCAppScene scene)
+{
+    m_cloud.enterRoom(params, scene);
+}
+
+void TRTCFakeCloudBackend::exitRoom()
+{
+    m_cloud.exitRoom();
+}
+
+void TRTCFakeCloudBackend::setVideoEncoderParam(const TRTCVideoEncParam& params)
+{
+    m_cloud.setVideoEncoderParam(params);
+}
+
+void TRTCFakeCloudBackend::setNetworkQosParam(const TRTCNetworkQosParam& params)
+{
+    m_cloud.setNetworkQosParam(params);
+}
+
+void TRTCFakeCloudBackend::enableSmallVideoStream(bool enable, const TRTCVideoEncParam& smallVideoParam)
+{
+    m_cloud.enableSmallVideoStream(enable, smallVideoParam);
+}
+
+void TRTCFakeCloudBackend::setPriorRemoteVideoStreamType(TRTCVideoStreamType type)
+{
+    m_cloud.setPriorRemoteVideoStreamType(type);
+}
+
+void TRTCFakeCloudBackend::setLocalViewFillMode(TRTCVideoFillMode mode)
+{
+    m_cloud.setLocalViewFillMode(mode);
+}
+
+void TRTCFakeCloudBackend::startLocalPreview(HWND rendHwnd)
+{
+    m_cloud.startLocalPreview(rendHwnd);
+}
+
+void TRTCFakeCloudBackend::stopLocalPreview()
+{
+    m_cloud.stopLocalPreview();
+}
+
+void TRTCFakeCloudBackend::startLocalAudio()
+{
+    m_cloud.startLocalAudio();
+}
+
+void TRTCFakeCloudBackend::stopLocalAudio()
+{
+    m_cloud.stopLocalAudio();
+}
+
+void TRTCFakeCloudBackend::setRemoteViewFillMode(const char* userId, TRTCVideoFillMode mode)
+{
+    m_cloud.setRemoteViewFillMode(userId, mode);
+}
+
+void TRTCFakeCloudBackend::startRemoteView(const char* userId, HWND rendHwnd)
+{
+    m_cloud.startRemoteView(userId, rendHwnd);
+}
+
+void TRTCFakeCloudBackend::stopRemoteView(const char* userId)
+{
+    m_cloud.stopRemoteView(userId);
+}
+
+void TRTCFakeCloudBackend::stopAllRemoteView()
+{
+    m_cloud.stopAllRemoteView();
+}
@@ -0,0 +1,106 @@
+#pragma once
+/*
+* Module:   TRTCCloudBackend
+*
+* Function: ѽõ TRTCCloud ӿڳѹȲͨ SDK 򱾵ģʵ
+*
+*    1. ITRTCCloudBackend ĺ TRTCCloud ͬͬΣTRTCMainViewController ĵÿԭ
+*
+*    2. TRTCCloudBackend תʵ TRTCCloudTRTCFakeCloudBackend ת TRTCFakeCloud
+*       ʹ÷ֻ TRTCCloudBackendFactoryлʵֲҪĶ̡
+*/
+
+#include "TRTCCloud.h"
+#include "TRTCFakeCloud.h"
+
+#include <memory>
+#include <functional>
+
+class ITRTCCloudBackend
+{
+public:
+    virtual ~ITRTCCloudBackend() {}
+
+    virtual void addCallback(ITRTCCloudCallback* callback) = 0;
+    virtual void removeCallback(ITRTCCloudCallback* callback) = 0;
+
+    virtual void enterRoom(const TRTCParams& params, TRTCAppScene scene) = 0;
+    virtual void exitRoom() = 0;
+
+    virtual void setVideoEncoderParam(const TRTCVideoEncParam& params) = 0;
+    virtual void setNetworkQosParam(const TRTCNetworkQosParam& params) = 0;
+    virtual void enableSmallVideoStream(bool enable, const TRTCVideoEncParam& smallVideoParam) = 0;
+    virtual void setPriorRemoteVideoStreamType(TRTCVideoStreamType type) = 0;
+
+    virtual void setLocalViewFillMode(TRTCVideoFillMode mode) = 0;
+    virtual void startLocalPreview(HWND rendHwnd) = 0;
+    virtual void stopLocalPreview() = 0;
+    virtual void startLocalAudio() = 0;
+    virtual void stopLocalAudio() = 0;
+
+    virtual void setRemoteViewFillMode(const char* userId, TRTCVideoFillMode mode) = 0;
+    virtual void startRemoteView(const char* userId, HWND rendHwnd) = 0;
+    virtual void stopRemoteView(const char* userId) = 0;
+    virtual void stopAllRemoteView() = 0;
+};
+
+typedef std::function<std::unique_ptr<ITRTCCloudBackend>()> TRTCCloudBackendFactory;
+
+//ÿʵһ TRTCCloud
+class TRTCCloudBackend : public ITRTCCloudBackend
+{
+public:
+    TRTCCloudBackend();
+    virtual ~TRTCCloudBackend();
+
+    static TRTCCloudBackendFactory factory();
+
+    virtual void addCallback(ITRTCCloudCallback* callback);
+    virtual void removeCallback(ITRTCCloudCallback* callback);
+    virtual void enterRoom(const TRTCParams& params, TRTCAppScene scene);
+    virtual void exitRoom();
+    virtual void setVideoEncoderParam(const TRTCVideoEncParam& params);
+    virtual void setNetworkQosParam(const TRTCNetworkQosParam& params);
+    virtual void enableSmallVideoStream(bool enable, const TRTCVideoEncParam& smallVideoParam);
+    virtual void setPriorRemoteVideoStreamType(TRTCVideoStreamType type);
+    virtual void setLocalViewFillMode(TRTCVideoFillMode mode);
+    virtual void startLocalPreview(HWND rendHwnd);
+    virtual void stopLocalPreview();
+    virtual void startLocalAudio();
+    virtual void stopLocalAudio();
+    virtual void setRemoteViewFillMode(const char* userId, TRTCVideoFillMode mode);
+    virtual void startRemoteView(const char* userId, HWND rendHwnd);
+    virtual void stopRemoteView(const char* userId);
+    virtual void stopAllRemoteView();
+private:
+    TRTCCloud m_cloud;
+};
+
+class TRTCFakeCloudBackend : public ITRTCCloudBackend
+{
+public:
+    explicit TRTCFakeCloudBackend(const TRTCFakeCloudParams& fakeParams = TRTCFakeCloudParams());
+    virtual ~TRTCFakeCloudBackend();
+
+    static TRTCCloudBackendFactory factory(const TRTCFakeCloudParams& fakeParams = TRTCFakeCloudParams());
+
+    virtual void addCallback(ITRTCCloudCallback* callback);
+    virtual void removeCallback(ITRTCCloudCallback* callback);
+    virtual void enterRoom(const TRTCParams& params, TRTCAppScene scene);
+    virtual void exitRoom();
+    virtual void setVideoEncoderParam(const TRTCVideoEncParam& params);
+    virtual void setNetworkQosParam(const TRTCNetworkQosParam& params);
+    virtual void enableSmallVideoStream(bool enable, const TRTCVideoEncParam& smallVideoParam);
+    virtual void setPriorRemoteVideoStreamType(TRTCVideoStreamType type);
+    virtual void setLocalViewFillMode(TRTCVideoFillMode mode);
+    virtual void startLocalPreview(HWND rendHwnd);
+    virtual void stopLocalPreview();
+    virtual void startLocalAudio();
+    virtual void stopLocalAudio();
+    virtual void setRemoteViewFillMode(const char* userId, TRTCVideoFillMode mode);
+    virtual void startRemoteView(const char* userId, HWND rendHwnd);
+    virtual void stopRemoteView(const char* userId);
+    virtual void stopAllRemoteView();
+private:
+    TRTCFakeCloud m_cloud;
+};
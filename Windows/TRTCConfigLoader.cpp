@@ -0,0 +1,140 @@
+/*
+* Module:   TRTCConfigLoader
+*
+* Function: Config.json ͳһڣConfig  TRTCGetUserIDAndUserSig ͬһݽ
+*/
+
+#include "TRTCConfigLoader.h"
+#include "Base.h"
+#include "json.h"
+#include <stdio.h>
+
+const UserInfo* UserInfoTable::findUser(const std::string& userId) const
+{
+    std::unordered_map<std::string, size_t>::const_iterator it = userIndex.find(userId);
+    if (it == userIndex.end())
+        return nullptr;
+    return &userInfos[it->second];
+}
+
+bool TRTCConfigLoader::FileStamp::operator==(const FileStamp& other) const
+{
+    return lastWriteTime == other.lastWriteTime && size == other.size;
+}
+
+TRTCConfigLoader::TRTCConfigLoader()
+{
+
+}
+
+TRTCConfigLoader::~TRTCConfigLoader()
+{
+
+}
+
+TRTCConfigLoader& TRTCConfigLoader::instance()
+{
+    static TRTCConfigLoader uniqueInstance;
+    return uniqueInstance;
+}
+
+std::shared_ptr<const UserInfoTable> TRTCConfigLoader::load(const std::wstring& path)
+{
+    FileStamp stamp;
+    if (!queryStamp(path, stamp))
+        return nullptr;
+
+    //ع̳ͬʱĶ÷ֻһȥļ
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::map<std::wstring, CacheEntry>::iterator it = m_cache.find(path);
+    if (it != m_cache.end() && it->second.stamp == stamp)
+        return it->second.table;
+
+    std::string data;
+    if (!readFile(path, data))
+        return nullptr;
+
+    std::shared_ptr<UserInfoTable> table = std::make_shared<UserInfoTable>();
+    if (!parseConfig(data, *table))
+        return nullptr;
+
+    CacheEntry& entry = m_cache[path];
+    entry.stamp = stamp;
+    entry.table = table;
+    return entry.table;
+}
+
+void TRTCConfigLoader::invalidate()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cache.clear();
+}
+
+bool TRTCConfigLoader::parseConfig(const std::string& data, UserInfoTable& table)
+{
+    Json::Reader reader;
+    Json::Value root;
+    if (!reader.parse(data, root))
+    {
+        return false;
+    }
+
+    if (!root.isMember("sdkappid") || !root.isMember("users"))
+    {
+        return false;
+    }
+
+    table.sdkAppId = root["sdkappid"].asUInt();
+    if (root.isMember("secretkey"))
+        table.secretKey = root["secretkey"].asString();
+
+    const Json::Value& users = root["users"];
+    for (Json::ArrayIndex i = 0; i < users.size(); ++i)
+    {
+        const Json::Value& item = users[i];
+        if (!item.isMember("userId") || !item.isMember("userToken"))
+        {
+            return false;
+        }
+
+        UserInfo info;
+        info.userId = item["userId"].asString();
+        info.userSig = item["userToken"].asString();
+
+        //userId ظʱԵһγֵΪ׼
+        if (table.userIndex.emplace(info.userId, table.userInfos.size()).second)
+            table.userInfos.push_back(info);
+    }
+
+    return true;
+}
+
+bool TRTCConfigLoader::queryStamp(const std::wstring& path, FileStamp& stamp)
+{
+    WIN32_FILE_ATTRIBUTE_DATA attr = { 0 };
+    if (!::GetFileAttributesExW(path.c_str(), GetFileExInfoStandard, &attr))
+        return false;
+
+    stamp.lastWriteTime = ((uint64_t)attr.ftLastWriteTime.dwHighDateTime << 32) | attr.ftLastWriteTime.dwLowDateTime;
+    stamp.size = ((uint64_t)attr.nFileSizeHigh << 32) | attr.nFileSizeLow;
+    return true;
+}
+
+bool TRTCConfigLoader::readFile(const std::wstring& path, std::string& data)
+{
+    FILE* file = NULL;
+    _wfopen_s(&file, path.c_str(), L"rb");
+    if (!file)
+    {
+        return false;
+    }
+
+    char buffer[4096];
+    size_t count = 0;
+    while ((count = ::fread(buffer, 1, sizeof(buffer), file)) > 0)
+    {
+        data.append(buffer, count);
+    }
+    ::fclose(file);
+    return true;
+}
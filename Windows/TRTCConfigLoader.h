@@ -0,0 +1,75 @@
+#pragma once
+/*
+* Module:   TRTCConfigLoader
+*
+* Function: Config.json ͳһڣConfig  TRTCGetUserIDAndUserSig ͬһݽ
+*
+*    1. ļ·棬¼ļ޸ʱʹСٴμʱ߶ûֱӷػ棬ٶļͽ Json
+*
+*    2. ǲ޸ĵ UserInfoTable shared_ptr ʹ÷ļ仯󻻳±ɱɳȻͷš
+*/
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <stdint.h>
+
+struct UserInfo
+{
+    std::string userId;
+    std::string userSig;
+};
+
+//ļصûɺ޸ģڶ߳йȡ
+struct UserInfoTable
+{
+    uint32_t sdkAppId = 0;
+    std::string secretKey;                                  //Ժѹ⻷ãڱؼ UserSig
+    std::vector<UserInfo> userInfos;                        //ļе˳
+    std::unordered_map<std::string, size_t> userIndex;      //userId -> userInfos ±
+
+    // userId ңҲ nullptr
+    const UserInfo* findUser(const std::string& userId) const;
+};
+
+class TRTCConfigLoader
+{
+protected:
+    TRTCConfigLoader();
+    TRTCConfigLoader(const TRTCConfigLoader&);
+    TRTCConfigLoader operator =(const TRTCConfigLoader&);
+public:
+    ~TRTCConfigLoader();
+    static TRTCConfigLoader& instance();
+
+    //ļļδ仯ʱػĽļڻʽ󷵻 nullptr
+    std::shared_ptr<const UserInfoTable> load(const std::wstring& path = L"Config.json");
+
+    //棬´ load ʱ½
+    void invalidate();
+
+    // Config.json ʽݣsdkappidusersѡ secretkey
+    static bool parseConfig(const std::string& data, UserInfoTable& table);
+private:
+    struct FileStamp
+    {
+        uint64_t lastWriteTime = 0;
+        uint64_t size = 0;
+
+        bool operator==(const FileStamp& other) const;
+    };
+    struct CacheEntry
+    {
+        FileStamp stamp;
+        std::shared_ptr<const UserInfoTable> table;
+    };
+
+    static bool queryStamp(const std::wstring& path, FileStamp& stamp);
+    static bool readFile(const std::wstring& path, std::string& data);
+private:
+    std::mutex m_mutex;
+    std::map<std::wstring, CacheEntry> m_cache;
+};
@@ -0,0 +1,194 @@
+/*
+* Module:   TRTCCredentialStore
+*
+* Function:  sdkAppId  userId ĶӦ˺ſ⣬һ̿ͬʱΪ sdkAppId ķṩ userId/userSig
+*/
+
+#include "TRTCCredentialStore.h"
+#include <atomic>
+
+TRTCCredentialStore::TRTCCredentialStore()
+    : m_apps(std::make_shared<AppTableMap>())
+{
+
+}
+
+TRTCCredentialStore::~TRTCCredentialStore()
+{
+
+}
+
+TRTCCredentialStore& TRTCCredentialStore::instance()
+{
+    static TRTCCredentialStore uniqueInstance;
+    return uniqueInstance;
+}
+
+bool TRTCCredentialStore::loadFromFile(const std::wstring& path)
+{
+    std::shared_ptr<const UserInfoTable> parsed = TRTCConfigLoader::instance().load(path);
+    if (!parsed)
+        return false;
+
+    mergeTable(*parsed);
+    return true;
+}
+
+bool TRTCCredentialStore::loadFromJson(const std::string& data)
+{
+    UserInfoTable parsed;
+    if (!TRTCConfigLoader::parseConfig(data, parsed))
+        return false;
+
+    mergeTable(parsed);
+    return true;
+}
+
+void TRTCCredentialStore::mergeTable(const UserInfoTable& parsed)
+{
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    mergeUsers(parsed.sdkAppId, parsed.userInfos, parsed.secretKey);
+}
+
+void TRTCCredentialStore::addUsers(uint32_t sdkAppId, const std::vector<UserInfo>& users)
+{
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    mergeUsers(sdkAppId, users, std::string());
+}
+
+bool TRTCCredentialStore::removeUser(uint32_t sdkAppId, const std::string& userId)
+{
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    AppTableMap::const_iterator it = m_apps->find(sdkAppId);
+    if (it == m_apps->end() || it->second->findUser(userId) == nullptr)
+        return false;
+
+    size_t shardIndex = shardOf(userId);
+    std::shared_ptr<AppCredentials> app = std::make_shared<AppCredentials>(*it->second);
+    std::shared_ptr<UserShard> shard = std::make_shared<UserShard>(*app->shards[shardIndex]);
+    shard->erase(userId);
+    app->shards[shardIndex] = shard->empty() ? nullptr : shard;
+    --app->userCount;
+
+    publishApp(sdkAppId, app);
+    return true;
+}
+
+bool TRTCCredentialStore::removeApp(uint32_t sdkAppId)
+{
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    if (m_apps->find(sdkAppId) == m_apps->end())
+        return false;
+
+    publishApp(sdkAppId, nullptr);
+    return true;
+}
+
+void TRTCCredentialStore::clear()
+{
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    std::atomic_store(&m_apps, std::shared_ptr<const AppTableMap>(std::make_shared<AppTableMap>()));
+}
+
+std::shared_ptr<const TRTCCredentialStore::AppCredentials> TRTCCredentialStore::getApp(uint32_t sdkAppId) const
+{
+    std::shared_ptr<const AppTableMap> apps = std::atomic_load(&m_apps);
+    AppTableMap::const_iterator it = apps->find(sdkAppId);
+    if (it == apps->end())
+        return nullptr;
+    return it->second;
+}
+
+bool TRTCCredentialStore::findUser(uint32_t sdkAppId, const std::string& userId, UserInfo& info) const
+{
+    std::shared_ptr<const AppCredentials> app = getApp(sdkAppId);
+    if (!app)
+        return false;
+
+    const UserInfo* pInfo = app->findUser(userId);
+    if (pInfo == nullptr)
+        return false;
+
+    info = *pInfo;
+    return true;
+}
+
+std::vector<uint32_t> TRTCCredentialStore::getAppIds() const
+{
+    std::shared_ptr<const AppTableMap> apps = std::atomic_load(&m_apps);
+    std::vector<uint32_t> appIds;
+    appIds.reserve(apps->size());
+    for (AppTableMap::const_iterator it = apps->begin(); it != apps->end(); ++it)
+        appIds.push_back(it->first);
+    return appIds;
+}
+
+std::shared_ptr<const TRTCCredentialStore::AppTableMap> TRTCCredentialStore::getAllApps() const
+{
+    return std::atomic_load(&m_apps);
+}
+
+const UserInfo* TRTCCredentialStore::AppCredentials::findUser(const std::string& userId) const
+{
+    const std::shared_ptr<const UserShard>& shard = shards[shardOf(userId)];
+    if (!shard)
+        return nullptr;
+
+    UserShard::const_iterator it = shard->find(userId);
+    return it != shard->end() ? &it->second : nullptr;
+}
+
+size_t TRTCCredentialStore::shardOf(const std::string& userId)
+{
+    return std::hash<std::string>()(userId) % kShardCount;
+}
+
+void TRTCCredentialStore::mergeUsers(uint32_t sdkAppId, const std::vector<UserInfo>& users, const std::string& secretKey)
+{
+    AppTableMap::const_iterator it = m_apps->find(sdkAppId);
+    std::shared_ptr<AppCredentials> app;
+    if (it != m_apps->end())
+    {
+        app = std::make_shared<AppCredentials>(*it->second);
+    }
+    else
+    {
+        app = std::make_shared<AppCredentials>();
+        app->sdkAppId = sdkAppId;
+        app->shards.resize(kShardCount);
+    }
+    if (!secretKey.empty())
+        app->secretKey = secretKey;
+
+    //ͬһͬһƬ˺ֻһθ÷Ƭ
+    std::vector<std::shared_ptr<UserShard>> copied(kShardCount);
+    for (size_t i = 0; i < users.size(); ++i)
+    {
+        size_t shardIndex = shardOf(users[i].userId);
+        std::shared_ptr<UserShard>& shard = copied[shardIndex];
+        if (!shard)
+        {
+            shard = app->shards[shardIndex] ? std::make_shared<UserShard>(*app->shards[shardIndex]) : std::make_shared<UserShard>();
+            app->shards[shardIndex] = shard;
+        }
+
+        std::pair<UserShard::iterator, bool> ret = shard->emplace(users[i].userId, users[i]);
+        if (ret.second)
+            ++app->userCount;
+        else
+            ret.first->second.userSig = users[i].userSig;
+    }
+
+    publishApp(sdkAppId, app);
+}
+
+void TRTCCredentialStore::publishApp(uint32_t sdkAppId, const std::shared_ptr<const AppCredentials>& app)
+{
+    //ָֻ룬ĴӦøȣ˺Ÿ޹
+    std::shared_ptr<AppTableMap> apps = std::make_shared<AppTableMap>(*m_apps);
+    if (app)
+        (*apps)[sdkAppId] = app;
+    else
+        apps->erase(sdkAppId);
+    std::atomic_store(&m_apps, std::shared_ptr<const AppTableMap>(apps));
+}
@@ -0,0 +1,80 @@
+#pragma once
+/*
+* Module:   TRTCCredentialStore
+*
+* Function:  sdkAppId  userId ĶӦ˺ſ⣬һ̿ͬʱΪ sdkAppId ķṩ userId/userSig
+*
+*    1. ÿ sdkAppId Ӧһ޸ĵ AppCredentials˺Ű userId Ĺϣɢ kShardCount ޸ĵķƬУ
+*       ӦһŲ޸ĵȡʱֻԭӵȡһգ sdkAppIduserId ϣң
+*
+*    2. ɾİƬдʱƣֻӰķƬӦõķƬָָֻ룩Ȼ滻
+*       ɾһ˺ŵĴԼΪ Ӧ˺ / kShardCount + kShardCount + Ӧøд֮С
+*
+*    3. ˺ſԶ Config.json ʽԴͬһ sdkAppId ˺Żϲһ
+*/
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <stdint.h>
+#include "TRTCConfigLoader.h"
+
+class TRTCCredentialStore
+{
+protected:
+    TRTCCredentialStore();
+    TRTCCredentialStore(const TRTCCredentialStore&);
+    TRTCCredentialStore operator =(const TRTCCredentialStore&);
+public:
+    ~TRTCCredentialStore();
+    static TRTCCredentialStore& instance();
+
+    static const size_t kShardCount = 64;
+
+    //һƬе˺ţuserId -> UserInfo޸
+    typedef std::unordered_map<std::string, UserInfo> UserShard;
+
+    //һӦõ˺ţ޸
+    struct AppCredentials
+    {
+        uint32_t sdkAppId = 0;
+        std::string secretKey;
+        size_t userCount = 0;
+        std::vector<std::shared_ptr<const UserShard>> shards;  //kShardCount û˺ŵķƬΪָ
+
+        // userId ңҲ nullptr
+        const UserInfo* findUser(const std::string& userId) const;
+    };
+    typedef std::unordered_map<uint32_t, std::shared_ptr<const AppCredentials>> AppTableMap;
+
+    //ȡһ Config.json ʽԴе˺źϲӦ sdkAppId £ļ TRTCConfigLoader 
+    bool loadFromFile(const std::wstring& path);
+    bool loadFromJson(const std::string& data);
+
+    //һѽûϲӦ sdkAppId £ addUsers ֻͬͬʱ secretKeyԴ˺ű
+    void mergeTable(const UserInfoTable& parsed);
+
+    //˺ţѴڵ userId  userSig
+    void addUsers(uint32_t sdkAppId, const std::vector<UserInfo>& users);
+    bool removeUser(uint32_t sdkAppId, const std::string& userId);
+    bool removeApp(uint32_t sdkAppId);
+    void clear();
+
+    std::shared_ptr<const AppCredentials> getApp(uint32_t sdkAppId) const;
+    bool findUser(uint32_t sdkAppId, const std::string& userId, UserInfo& info) const;
+    std::vector<uint32_t> getAppIds() const;
+
+    //ӦõĿգʱܲ޸Ӱ
+    std::shared_ptr<const AppTableMap> getAllApps() const;
+private:
+    static size_t shardOf(const std::string& userId);
+    //е˺Ϻϲ userssecretKey ΪʱԭԿ÷ m_writeMutex
+    void mergeUsers(uint32_t sdkAppId, const std::vector<UserInfo>& users, const std::string& secretKey);
+    //滻ĳӦãapp Ϊձʾɾ÷ m_writeMutex
+    void publishApp(uint32_t sdkAppId, const std::shared_ptr<const AppCredentials>& app);
+private:
+    std::mutex m_writeMutex;
+    std::shared_ptr<const AppTableMap> m_apps;
+};
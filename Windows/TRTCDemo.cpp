@@ -5,6 +5,15 @@
 #include "stdafx.h"
 #include "TRTCDemo.h"
 #include "TRTCLoginViewController.h"
+#include "TRTCGetUserIDAndUserSig.h"
+#include "TRTCGenerateTestUserSig.h"
+#include "TRTCUserSigCache.h"
+#include "TRTCLoadGenerator.h"
+#include "TRTCVideoConvert.h"
+#include "TRTCVideoTransform.h"
+#include "StorageConfigMgr.h"
+#include "UTFConvert.h"
+#include "Benchmark.h"
 
 #ifdef _DEBUG
 #define new DEBUG_NEW
@@ -34,6 +43,72 @@ CTRTCDemo::CTRTCDemo()
 
 CTRTCDemo theApp;
 
+// û Config.json ʱģʵʹõ sdkAppIdģʵֻ
+static const uint32_t kFakeLoadTestSdkAppId = 1400000000;
+
+// ʾ棬 1101001000 ·ѹ⣬д LoadTestReport.txt
+static void RunLoadTest(bool bFakeCloud)
+{
+    TRTCStorageConfigMgr::GetInstance()->ReadStorageConfig();
+    TRTCGetUserIDAndUserSig::instance().loadFromConfig();
+
+    TRTCLoadTestOptions options;
+    options.sdkAppId = TRTCGetUserIDAndUserSig::instance().getConfigSdkAppId();
+
+    TRTCCloudBackendFactory factory = TRTCCloudBackend::factory();
+    if (bFakeCloud)
+    {
+        factory = TRTCFakeCloudBackend::factory();
+        if (options.sdkAppId == 0)
+            options.sdkAppId = kFakeLoadTestSdkAppId;
+
+        // ģʵֲУǩû secretkey ʱù̶Կڱ
+        options.userSigFetcher = [](uint32_t sdkAppId, const std::string& userId, uint32_t roomId) {
+            std::string userSig;
+            if (!TRTCUserSigCache::instance().getUserSig(sdkAppId, userId, roomId, userSig))
+                userSig = TRTCGenerateTestUserSig(sdkAppId, "loadtest").genUserSig(userId);
+            return userSig;
+        };
+    }
+
+    TRTCLoadGenerator generator(factory, options);
+    std::string report = TRTCLoadGenerator::formatReport(generator.runLevels());
+
+    FILE* file = NULL;
+    if (_wfopen_s(&file, L"LoadTestReport.txt", L"wb") == 0 && file != NULL)
+    {
+        fwrite(report.data(), 1, report.size(), file);
+        fclose(file);
+    }
+}
+
+// ʾ棬ÿֱַ I420  BGRA32 תĺʱԼתתһĶԱȣд VideoConvertReport.txt
+static void RunVideoConvertBenchmark()
+{
+    std::string report = TRTCVideoConvert::formatBenchmark(TRTCVideoConvert::runBenchmark());
+    report += "\r\n";
+    report += TRTCVideoTransform::formatBenchmark(TRTCVideoTransform::runBenchmark());
+    WriteBenchmarkReport(L"VideoConvertReport.txt", report);
+}
+
+// ʾ棬Աȵ밴ڵ㷴ַʽINIĺʱд ConfigParseReport.txt
+static void RunConfigParseBenchmark()
+{
+    WriteBenchmarkReport(L"ConfigParseReport.txt", CConfigMgr::FormatBenchmark(CConfigMgr::RunBenchmark()));
+}
+
+// ʾ棬Աȴ ASCII ӢĻıתϵͳ API µתд UTFConvertReport.txt
+static void RunUTFBenchmark()
+{
+    WriteBenchmarkReport(L"UTFConvertReport.txt", FormatUTFConvertBenchmark(RunUTFConvertBenchmark()));
+}
+
+// ʾ棬ԱȼС± UserSig д UserSigReport.txt
+static void RunUserSigBenchmark()
+{
+    WriteBenchmarkReport(L"UserSigReport.txt", TRTCGenerateTestUserSig::formatBenchmark(TRTCGenerateTestUserSig::runBenchmark()));
+}
+
 // CTRTCDemo ʼ
 
 BOOL CTRTCDemo::InitInstance()
@@ -50,6 +125,40 @@ BOOL CTRTCDemo::InitInstance()
 
     CWinApp::InitInstance();
 
+    // д /loadtest ʱֻѹ⣬ /fake ʹñģ TRTCCloud
+    if (wcsstr(m_lpCmdLine, L"/loadtest") != NULL)
+    {
+        RunLoadTest(wcsstr(m_lpCmdLine, L"/fake") != NULL);
+        return FALSE;
+    }
+
+    // д /convbench ʱֻƵʽתתܲ
+    if (wcsstr(m_lpCmdLine, L"/convbench") != NULL)
+    {
+        RunVideoConvertBenchmark();
+        return FALSE;
+    }
+
+    // д /inibench ʱֻINIܲ
+    if (wcsstr(m_lpCmdLine, L"/inibench") != NULL)
+    {
+        RunConfigParseBenchmark();
+        return FALSE;
+    }
+
+    // д /utfbench ʱֻ UTF-8/UTF-16 תܲ
+    if (wcsstr(m_lpCmdLine, L"/utfbench") != NULL)
+    {
+        RunUTFBenchmark();
+        return FALSE;
+    }
+
+    // д /sigbench ʱֻб UserSig ܲ
+    if (wcsstr(m_lpCmdLine, L"/sigbench") != NULL)
+    {
+        RunUserSigBenchmark();
+        return FALSE;
+    }
 
     AfxEnableControlContainer();
 
@@ -102,3 +211,11 @@ BOOL CTRTCDemo::InitInstance()
     // ӦóϢá
     return FALSE;
 }
+
+int CTRTCDemo::ExitInstance()
+{
+    // ھ̬֮ǰ UserSig ̨ˢ߳
+    TRTCUserSigCache::instance().stop();
+
+    return CWinApp::ExitInstance();
+}
@@ -23,6 +23,7 @@ public:
 // д
 public:
 	virtual BOOL InitInstance();
+	virtual int ExitInstance();
 
 // ʵ
 
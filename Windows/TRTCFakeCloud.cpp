@@ -0,0 +1,481 @@
+/*
+* Module:   TRTCFakeCloud
+*
+* Function: ѶƵı TRTCCloud ģʵ֣ӿ TRTCCloud нõĲһ£ѹ͵
+*/
+
+#include "TRTCFakeCloud.h"
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <functional>
+#include <chrono>
+#include <random>
+#include <algorithm>
+
+typedef std::chrono::steady_clock FakeClock;
+
+struct TRTCFakeCloud::Session
+{
+    enum State
+    {
+        StateIdle,
+        StateEntering,
+        StateInRoom,
+        StateExiting,
+    };
+
+    explicit Session(const TRTCFakeCloudParams& params)
+        : fakeParams(params)
+        , driver(params)
+    {
+    }
+
+    TRTCFakeCloudParams fakeParams;
+    TRTCFakeEventDriver driver;     //صбԶû¼Ⱦ𣬲ڳ mutex ʱûᷢصĽӿ
+
+    std::mutex mutex;
+    State state = StateIdle;
+    uint64_t generation = 0;        //ÿν˷һڵĶʱݴ
+    uint32_t sdkAppId = 0;
+    uint32_t roomId = 0;
+    std::string userId;
+    FakeClock::time_point enterTime;
+    std::minstd_rand random;
+
+    TRTCVideoEncParam encParam;
+    TRTCNetworkQosParam qosParam;
+    bool bSmallStream = false;
+    TRTCVideoEncParam smallEncParam;
+    bool bLocalPreview = false;
+    bool bLocalAudio = false;
+    bool bMuteVideo = false;
+    bool bMuteAudio = false;
+};
+
+typedef std::shared_ptr<TRTCFakeCloud::Session> SessionPtr;
+typedef std::weak_ptr<TRTCFakeCloud::Session> SessionWeakPtr;
+
+//ڵģⷿ䣬(sdkAppId, roomId) -> ڵʵֻڻص߳Ϸ
+typedef std::map<std::pair<uint32_t, uint32_t>, std::vector<SessionWeakPtr>> FakeRoomMap;
+
+static FakeRoomMap& fakeRooms()
+{
+    static FakeRoomMap rooms;
+    return rooms;
+}
+
+//˿״̬÷ session.mutex
+static TRTCFakeStreamInfo localStream(const TRTCFakeCloud::Session& session)
+{
+    TRTCFakeStreamInfo stream;
+    stream.encParam = session.encParam;
+    stream.bSmallStream = session.bSmallStream;
+    stream.smallEncParam = session.smallEncParam;
+    stream.bVideo = session.bLocalPreview && !session.bMuteVideo;
+    stream.bAudio = session.bLocalAudio && !session.bMuteAudio;
+    return stream;
+}
+
+//ȡڳ self ֮ȻѾʵ˳Ѿ
+static std::vector<SessionPtr> roomMembers(uint32_t sdkAppId, uint32_t roomId, const TRTCFakeCloud::Session* self)
+{
+    std::vector<SessionPtr> members;
+    FakeRoomMap::iterator room = fakeRooms().find(std::make_pair(sdkAppId, roomId));
+    if (room == fakeRooms().end())
+        return members;
+
+    std::vector<SessionWeakPtr>& list = room->second;
+    for (size_t i = 0; i < list.size();)
+    {
+        SessionPtr member = list[i].lock();
+        if (!member)
+        {
+            list[i] = list.back();
+            list.pop_back();
+            continue;
+        }
+        if (member.get() != self)
+            members.push_back(member);
+        ++i;
+    }
+    if (list.empty())
+        fakeRooms().erase(room);
+    return members;
+}
+
+//뿪䲢֪ͨˣڻصִ߳
+static void leaveRoom(const SessionPtr& session, uint32_t sdkAppId, uint32_t roomId, const std::string& userId)
+{
+    FakeRoomMap::iterator room = fakeRooms().find(std::make_pair(sdkAppId, roomId));
+    if (room == fakeRooms().end())
+        return;
+
+    std::vector<SessionWeakPtr>& list = room->second;
+    bool bFound = false;
+    for (size_t i = 0; i < list.size(); ++i)
+    {
+        if (list[i].lock() == session)
+        {
+            list[i] = list.back();
+            list.pop_back();
+            bFound = true;
+            break;
+        }
+    }
+    if (!bFound)
+        return;
+
+    std::vector<SessionPtr> members = roomMembers(sdkAppId, roomId, session.get());
+    for (size_t i = 0; i < members.size(); ++i)
+        members[i]->driver.remoteUserExit(userId, 0);
+}
+
+static void completeEnter(const SessionWeakPtr& weakSession, uint64_t generation)
+{
+    SessionPtr session = weakSession.lock();
+    if (!session)
+        return;
+
+    uint64_t elapsed = 0;
+    uint32_t sdkAppId = 0;
+    uint32_t roomId = 0;
+    std::string userId;
+    TRTCFakeStreamInfo stream;
+    uint32_t seed = 0;
+    {
+        std::lock_guard<std::mutex> lock(session->mutex);
+        if (session->generation != generation || session->state != TRTCFakeCloud::Session::StateEntering)
+            return;
+        session->state = TRTCFakeCloud::Session::StateInRoom;
+        elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(FakeClock::now() - session->enterTime).count();
+        sdkAppId = session->sdkAppId;
+        roomId = session->roomId;
+        userId = session->userId;
+        stream = localStream(*session);
+        seed = session->random();
+    }
+
+    std::vector<SessionPtr> members = roomMembers(sdkAppId, roomId, session.get());
+    fakeRooms()[std::make_pair(sdkAppId, roomId)].push_back(session);
+
+    session->driver.start(userId, seed);
+    session->driver.dispatch([elapsed](ITRTCCloudCallback* callback) {
+        callback->onEnterRoom(elapsed);
+    });
+
+    // SDK һ£½յгԱ onUserEnterгԱյ³Ա
+    for (size_t i = 0; i < members.size(); ++i)
+    {
+        std::string memberId;
+        TRTCFakeStreamInfo memberStream;
+        {
+            std::lock_guard<std::mutex> lock(members[i]->mutex);
+            memberId = members[i]->userId;
+            memberStream = localStream(*members[i]);
+        }
+        session->driver.remoteUserEnter(memberId, memberStream);
+        members[i]->driver.remoteUserEnter(userId, stream);
+    }
+}
+
+static void completeExit(const SessionWeakPtr& weakSession, uint64_t generation)
+{
+    SessionPtr session = weakSession.lock();
+    if (!session)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(session->mutex);
+        if (session->generation != generation || session->state != TRTCFakeCloud::Session::StateExiting)
+            return;
+        session->state = TRTCFakeCloud::Session::StateIdle;
+    }
+    session->driver.dispatch([](ITRTCCloudCallback* callback) {
+        callback->onExitRoom(0);
+    });
+}
+
+//״̬仯ʱ֪ͨˣڻصִ߳
+static void postAvailableChange(const SessionPtr& session, bool bVideo, bool available)
+{
+    uint32_t sdkAppId = 0;
+    uint32_t roomId = 0;
+    std::string userId;
+    {
+        std::lock_guard<std::mutex> lock(session->mutex);
+        if (session->state != TRTCFakeCloud::Session::StateInRoom)
+            return;
+        sdkAppId = session->sdkAppId;
+        roomId = session->roomId;
+        userId = session->userId;
+    }
+
+    SessionWeakPtr weakSession = session;
+    TRTCFakeCallbackThread::instance().post(0, [weakSession, sdkAppId, roomId, userId, bVideo, available]() {
+        SessionPtr self = weakSession.lock();
+        if (!self)
+            return;
+        std::vector<SessionPtr> members = roomMembers(sdkAppId, roomId, self.get());
+        for (size_t i = 0; i < members.size(); ++i)
+            members[i]->driver.remoteUserAvailable(userId, bVideo, available);
+    });
+}
+
+//޸ı״̬ĿԱʱ֪ͨ
+static void updateLocalStream(const SessionPtr& session, const std::function<void(TRTCFakeCloud::Session&)>& fn)
+{
+    TRTCFakeStreamInfo oldStream;
+    TRTCFakeStreamInfo newStream;
+    {
+        std::lock_guard<std::mutex> lock(session->mutex);
+        oldStream = localStream(*session);
+        fn(*session);
+        newStream = localStream(*session);
+        session->driver.setLocalStream(newStream);
+    }
+    if (oldStream.bVideo != newStream.bVideo)
+        postAvailableChange(session, true, newStream.bVideo);
+    if (oldStream.bAudio != newStream.bAudio)
+        postAvailableChange(session, false, newStream.bAudio);
+}
+
+TRTCFakeCloud::TRTCFakeCloud(const TRTCFakeCloudParams& fakeParams)
+    : m_session(std::make_shared<Session>(fakeParams))
+{
+}
+
+TRTCFakeCloud::~TRTCFakeCloud()
+{
+    // SDK һ£ڷʱֱ뿪䣬ٸԼص
+    uint32_t sdkAppId = 0;
+    uint32_t roomId = 0;
+    std::string userId;
+    bool bInRoom = false;
+    {
+        std::lock_guard<std::mutex> lock(m_session->mutex);
+        ++m_session->generation;
+        bInRoom = m_session->state != Session::StateIdle;
+        m_session->state = Session::StateIdle;
+        sdkAppId = m_session->sdkAppId;
+        roomId = m_session->roomId;
+        userId = m_session->userId;
+    }
+    m_session->driver.stop();
+    m_session->driver.setLocalVideoRenderCallback(TRTCVideoPixelFormat_Unknown, TRTCVideoBufferType_Unknown, NULL);
+    m_session->driver.setRemoteVideoRenderCallback(NULL, TRTCVideoPixelFormat_Unknown, TRTCVideoBufferType_Unknown, NULL);
+
+    if (bInRoom)
+    {
+        SessionPtr session = m_session;
+        TRTCFakeCallbackThread::instance().post(0, [session, sdkAppId, roomId, userId]() {
+            leaveRoom(session, sdkAppId, roomId, userId);
+        });
+    }
+}
+
+void TRTCFakeCloud::addCallback(ITRTCCloudCallback* callback)
+{
+    m_session->driver.addCallback(callback);
+}
+
+void TRTCFakeCloud::removeCallback(ITRTCCloudCallback* callback)
+{
+    m_session->driver.removeCallback(callback);
+}
+
+void TRTCFakeCloud::enterRoom(const TRTCParams& params, TRTCAppScene scene)
+{
+    SessionWeakPtr weakSession = m_session;
+    if (params.sdkAppId == 0 || params.roomId == 0 || params.userId.empty() || params.userSig.empty())
+    {
+        TXLiteAVError errCode = params.userSig.empty() ? ERR_USER_SIG_INVALID : ERR_ENTER_ROOM_PARAM_NULL;
+        TRTCFakeCallbackThread::instance().post(0, [weakSession, errCode]() {
+            SessionPtr session = weakSession.lock();
+            if (!session)
+                return;
+            session->driver.dispatch([errCode](ITRTCCloudCallback* callback) {
+                callback->onError(errCode, "enter room param invalid", NULL);
+            });
+        });
+        return;
+    }
+
+    uint32_t oldAppId = 0;
+    uint32_t oldRoomId = 0;
+    std::string oldUserId;
+    bool bSwitchRoom = false;
+    uint64_t generation = 0;
+    uint32_t latencyMs = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_session->mutex);
+        //ѾڷʱȾĬ뿪ɷ䣬 SDK лΪһ
+        bSwitchRoom = m_session->state != Session::StateIdle;
+        oldAppId = m_session->sdkAppId;
+        oldRoomId = m_session->roomId;
+        oldUserId = m_session->userId;
+
+        generation = ++m_session->generation;
+        m_session->state = Session::StateEntering;
+        m_session->sdkAppId = params.sdkAppId;
+        m_session->roomId = params.roomId;
+        m_session->userId = params.userId.c_str();
+        m_session->enterTime = FakeClock::now();
+        //ûͷȡӣͬѹÿεõͬʱ
+        m_session->random.seed((unsigned long)(std::hash<std::string>()(m_session->userId) ^ params.roomId));
+
+        const TRTCFakeCloudParams& fakeParams = m_session->fakeParams;
+        latencyMs = fakeParams.enterLatencyMs;
+        if (fakeParams.enterJitterMs > 0)
+            latencyMs += m_session->random() % (fakeParams.enterJitterMs + 1);
+    }
+
+    if (bSwitchRoom)
+    {
+        m_session->driver.stop();
+        SessionPtr session = m_session;
+        TRTCFakeCallbackThread::instance().post(0, [session, oldAppId, oldRoomId, oldUserId]() {
+            leaveRoom(session, oldAppId, oldRoomId, oldUserId);
+        });
+    }
+    TRTCFakeCallbackThread::instance().post(latencyMs, [weakSession, generation]() {
+        completeEnter(weakSession, generation);
+    });
+}
+
+void TRTCFakeCloud::exitRoom()
+{
+    uint32_t sdkAppId = 0;
+    uint32_t roomId = 0;
+    std::string userId;
+    uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_session->mutex);
+        if (m_session->state == Session::StateIdle || m_session->state == Session::StateExiting)
+            return;
+        generation = ++m_session->generation;
+        m_session->state = Session::StateExiting;
+        sdkAppId = m_session->sdkAppId;
+        roomId = m_session->roomId;
+        userId = m_session->userId;
+    }
+    m_session->driver.stop();
+
+    SessionPtr session = m_session;
+    TRTCFakeCallbackThread::instance().post(0, [session, sdkAppId, roomId, userId]() {
+        leaveRoom(session, sdkAppId, roomId, userId);
+    });
+    SessionWeakPtr weakSession = m_session;
+    TRTCFakeCallbackThread::instance().post(m_session->fakeParams.exitLatencyMs, [weakSession, generation]() {
+        completeExit(weakSession, generation);
+    });
+}
+
+void TRTCFakeCloud::setVideoEncoderParam(const TRTCVideoEncParam& params)
+{
+    updateLocalStream(m_session, [&params](Session& session) {
+        session.encParam = params;
+    });
+}
+
+void TRTCFakeCloud::setNetworkQosParam(const TRTCNetworkQosParam& params)
+{
+    std::lock_guard<std::mutex> lock(m_session->mutex);
+    m_session->qosParam = params;
+}
+
+void TRTCFakeCloud::enableSmallVideoStream(bool enable, const TRTCVideoEncParam& smallVideoParam)
+{
+    updateLocalStream(m_session, [&](Session& session) {
+        session.bSmallStream = enable;
+        session.smallEncParam = smallVideoParam;
+    });
+}
+
+void TRTCFakeCloud::setPriorRemoteVideoStreamType(TRTCVideoStreamType type)
+{
+    m_session->driver.setPriorRemoteVideoStreamType(type);
+}
+
+void TRTCFakeCloud::setLocalViewFillMode(TRTCVideoFillMode mode)
+{
+
+}
+
+void TRTCFakeCloud::startLocalPreview(HWND rendHwnd)
+{
+    updateLocalStream(m_session, [](Session& session) {
+        session.bLocalPreview = true;
+    });
+}
+
+void TRTCFakeCloud::stopLocalPreview()
+{
+    updateLocalStream(m_session, [](Session& session) {
+        session.bLocalPreview = false;
+    });
+}
+
+void TRTCFakeCloud::startLocalAudio()
+{
+    updateLocalStream(m_session, [](Session& session) {
+        session.bLocalAudio = true;
+    });
+}
+
+void TRTCFakeCloud::stopLocalAudio()
+{
+    updateLocalStream(m_session, [](Session& session) {
+        session.bLocalAudio = false;
+    });
+}
+
+void TRTCFakeCloud::setRemoteViewFillMode(const char* userId, TRTCVideoFillMode mode)
+{
+
+}
+
+void TRTCFakeCloud::startRemoteView(const char* userId, HWND rendHwnd)
+{
+    m_session->driver.startRemoteView(userId);
+}
+
+void TRTCFakeCloud::stopRemoteView(const char* userId)
+{
+    m_session->driver.stopRemoteView(userId);
+}
+
+void TRTCFakeCloud::stopAllRemoteView()
+{
+    m_session->driver.stopAllRemoteView();
+}
+
+void TRTCFakeCloud::muteLocalVideo(bool mute)
+{
+    updateLocalStream(m_session, [mute](Session& session) {
+        session.bMuteVideo = mute;
+    });
+}
+
+void TRTCFakeCloud::muteLocalAudio(bool mute)
+{
+    updateLocalStream(m_session, [mute](Session& session) {
+        session.bMuteAudio = mute;
+    });
+}
+
+void TRTCFakeCloud::enableAudioVolumeEvaluation(uint32_t interval)
+{
+    m_session->driver.enableAudioVolumeEvaluation(interval);
+}
+
+int TRTCFakeCloud::setLocalVideoRenderCallback(TRTCVideoPixelFormat pixelFormat, TRTCVideoBufferType bufferType, ITRTCVideoRenderCallback* callback)
+{
+    return m_session->driver.setLocalVideoRenderCallback(pixelFormat, bufferType, callback);
+}
+
+int TRTCFakeCloud::setRemoteVideoRenderCallback(const char* userId, TRTCVideoPixelFormat pixelFormat, TRTCVideoBufferType bufferType, ITRTCVideoRenderCallback* callback)
+{
+    return m_session->driver.setRemoteVideoRenderCallback(userId, pixelFormat, bufferType, callback);
+}
@@ -0,0 +1,65 @@
+#pragma once
+/*
+* Module:   TRTCFakeCloud
+*
+* Function: ѶƵı TRTCCloud ģʵ֣ӿ TRTCCloud нõĲһ£ѹ͵
+*
+*    1. лصһģ SDK ص߳ϰʱ˳򷢳˷õʱ첽ɣ
+*       onEnterRoom  elapsed Ǵӵ enterRoom صʵʺʱ
+*
+*    2. ͬһ sdkAppId  roomId ͬʵɼյû onUserEnter
+*       ûҲյԼ onUserEnter˷ʱԷյ onUserExit
+*
+*    3. ڵԶûͳơʾȾص TRTCFakeEventDriver ϳɣ
+*       TRTCFakeCloudParams ټģûģķ䡣
+*/
+
+#include "TRTCFakeEventDriver.h"
+
+#include <memory>
+#include <stdint.h>
+
+class TRTCFakeCloud
+{
+public:
+    explicit TRTCFakeCloud(const TRTCFakeCloudParams& fakeParams = TRTCFakeCloudParams());
+    ~TRTCFakeCloud();
+
+    void addCallback(ITRTCCloudCallback* callback);
+    //غ󲻻лص callbackԷ
+    void removeCallback(ITRTCCloudCallback* callback);
+
+    //ʱͨ onError  ERR_ENTER_ROOM_PARAM_NULL  ERR_USER_SIG_INVALID
+    void enterRoom(const TRTCParams& params, TRTCAppScene scene);
+    void exitRoom();
+
+    void setVideoEncoderParam(const TRTCVideoEncParam& params);
+    void setNetworkQosParam(const TRTCNetworkQosParam& params);
+    void enableSmallVideoStream(bool enable, const TRTCVideoEncParam& smallVideoParam);
+    void setPriorRemoteVideoStreamType(TRTCVideoStreamType type);
+
+    void setLocalViewFillMode(TRTCVideoFillMode mode);
+    void startLocalPreview(HWND rendHwnd);
+    void stopLocalPreview();
+    void startLocalAudio();
+    void stopLocalAudio();
+
+    void setRemoteViewFillMode(const char* userId, TRTCVideoFillMode mode);
+    void startRemoteView(const char* userId, HWND rendHwnd);
+    void stopRemoteView(const char* userId);
+    void stopAllRemoteView();
+
+    void muteLocalVideo(bool mute);
+    void muteLocalAudio(bool mute);
+    void enableAudioVolumeEvaluation(uint32_t interval);
+    int setLocalVideoRenderCallback(TRTCVideoPixelFormat pixelFormat, TRTCVideoBufferType bufferType, ITRTCVideoRenderCallback* callback);
+    int setRemoteVideoRenderCallback(const char* userId, TRTCVideoPixelFormat pixelFormat, TRTCVideoBufferType bufferType, ITRTCVideoRenderCallback* callback);
+
+    struct Session;
+private:
+    TRTCFakeCloud(const TRTCFakeCloud&);
+    TRTCFakeCloud& operator =(const TRTCFakeCloud&);
+
+    //ʱֻ Session ãʵδڵĻصԶ
+    std::shared_ptr<Session> m_session;
+};
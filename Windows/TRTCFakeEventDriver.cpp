@@ -0,0 +1,1000 @@
+/*
+* Module:   TRTCFakeEventDriver
+*
+* Function: õķģƵʺϳ TRTC ص¼Ƶ֡û SDK Ļѹصͻ洦
+*/
+
+#include "TRTCFakeEventDriver.h"
+#include "TRTCVideoScaler.h"
+
+#include <vector>
+#include <map>
+#include <queue>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+
+typedef std::chrono::steady_clock FakeClock;
+
+//////////////////////////////////////////////////////////////////////////
+// TRTCFakeCallbackThread
+
+struct TRTCFakeCallbackThread::Impl
+{
+    struct Task
+    {
+        FakeClock::time_point dueTime;
+        uint64_t seq = 0;   //ʱͬͶ˳ִ
+        std::function<void()> task;
+
+        bool operator<(const Task& other) const
+        {
+            //priority_queue Ǵ󶥶ѣȽ絽ڵڶѶ
+            if (dueTime != other.dueTime)
+                return dueTime > other.dueTime;
+            return seq > other.seq;
+        }
+    };
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::priority_queue<Task> tasks;
+    uint64_t nextSeq = 0;
+    bool bExit = false;
+    std::thread thread;
+
+    void threadProc()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!bExit)
+        {
+            if (tasks.empty())
+            {
+                cond.wait(lock);
+                continue;
+            }
+
+            FakeClock::time_point dueTime = tasks.top().dueTime;
+            if (dueTime > FakeClock::now())
+            {
+                cond.wait_until(lock, dueTime);
+                continue;
+            }
+
+            std::function<void()> task = std::move(const_cast<Task&>(tasks.top()).task);
+            tasks.pop();
+            lock.unlock();
+            task();
+            lock.lock();
+        }
+    }
+};
+
+TRTCFakeCallbackThread::TRTCFakeCallbackThread()
+    : m_impl(new Impl())
+{
+
+}
+
+TRTCFakeCallbackThread::~TRTCFakeCallbackThread()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_impl->mutex);
+        m_impl->bExit = true;
+    }
+    m_impl->cond.notify_all();
+    if (m_impl->thread.joinable())
+        m_impl->thread.join();
+}
+
+TRTCFakeCallbackThread& TRTCFakeCallbackThread::instance()
+{
+    static TRTCFakeCallbackThread uniqueInstance;
+    return uniqueInstance;
+}
+
+void TRTCFakeCallbackThread::post(uint32_t delayMs, std::function<void()> task)
+{
+    Impl::Task item;
+    item.dueTime = FakeClock::now() + std::chrono::milliseconds(delayMs);
+    item.task = std::move(task);
+
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    item.seq = m_impl->nextSeq++;
+    m_impl->tasks.push(std::move(item));
+    if (!m_impl->thread.joinable())
+        m_impl->thread = std::thread(&Impl::threadProc, m_impl.get());
+    m_impl->cond.notify_all();
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 
+
+//һ·ȾĻ棬ÿֻ֡ػƶ
+struct FakeCanvas
+{
+    TRTCVideoPixelFormat format = TRTCVideoPixelFormat_Unknown;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<char> data;
+    uint32_t barX = 0;
+    bool bPainted = false;
+    uint8_t tint[3] = { 0 };        //I420 ʱΪ Y ƫơUVBGRA ʱΪ BGR
+    FakeClock::time_point nextFrameTime;
+};
+
+static uint32_t barWidth(const FakeCanvas& canvas)
+{
+    return std::min(canvas.width, std::max(4u, canvas.width / 40) & ~1u);
+}
+
+static void resetCanvas(FakeCanvas& canvas, TRTCVideoPixelFormat format, uint32_t width, uint32_t height, const std::string& userId)
+{
+    canvas.format = format;
+    canvas.width = width;
+    canvas.height = height;
+    canvas.barX = 0;
+    canvas.bPainted = false;
+    if (format == TRTCVideoPixelFormat_I420)
+        canvas.data.assign((size_t)width * height + 2 * (size_t)((width + 1) / 2) * ((height + 1) / 2), 0);
+    else
+        canvas.data.assign((size_t)width * height * 4, 0);
+
+    //ͬûĵɫͬ
+    uint32_t hash = (uint32_t)std::hash<std::string>()(userId);
+    if (format == TRTCVideoPixelFormat_I420)
+    {
+        canvas.tint[0] = (uint8_t)(hash % 32);
+        canvas.tint[1] = (uint8_t)(64 + (hash >> 8) % 128);
+        canvas.tint[2] = (uint8_t)(64 + (hash >> 16) % 128);
+    }
+    else
+    {
+        canvas.tint[0] = (uint8_t)(96 + hash % 160);
+        canvas.tint[1] = (uint8_t)(96 + (hash >> 8) % 160);
+        canvas.tint[2] = (uint8_t)(96 + (hash >> 16) % 160);
+    }
+}
+
+//ػ [x0, x1) УbBar Ϊ true ʱɰɫָ
+static void paintColumns(FakeCanvas& canvas, uint32_t x0, uint32_t x1, bool bBar)
+{
+    uint32_t width = canvas.width;
+    uint32_t height = canvas.height;
+    x1 = std::min(x1, width);
+    if (x0 >= x1)
+        return;
+
+    if (canvas.format == TRTCVideoPixelFormat_I420)
+    {
+        uint8_t* yPlane = (uint8_t*)&canvas.data[0];
+        for (uint32_t y = 0; y < height; ++y)
+        {
+            uint8_t* row = yPlane + (size_t)y * width;
+            uint32_t rowLevel = 32 + canvas.tint[0] + y * 64 / height;
+            for (uint32_t x = x0; x < x1; ++x)
+                row[x] = bBar ? 235 : (uint8_t)(rowLevel + x * 128 / width);
+        }
+
+        uint32_t chromaWidth = (width + 1) / 2;
+        uint32_t chromaHeight = (height + 1) / 2;
+        uint8_t* uPlane = yPlane + (size_t)width * height;
+        uint8_t* vPlane = uPlane + (size_t)chromaWidth * chromaHeight;
+        uint32_t cx0 = x0 / 2;
+        uint32_t cx1 = (x1 + 1) / 2;
+        for (uint32_t y = 0; y < chromaHeight; ++y)
+        {
+            memset(uPlane + (size_t)y * chromaWidth + cx0, bBar ? 128 : canvas.tint[1], cx1 - cx0);
+            memset(vPlane + (size_t)y * chromaWidth + cx0, bBar ? 128 : canvas.tint[2], cx1 - cx0);
+        }
+    }
+    else
+    {
+        uint8_t* pixels = (uint8_t*)&canvas.data[0];
+        for (uint32_t y = 0; y < height; ++y)
+        {
+            uint8_t* row = pixels + (size_t)y * width * 4;
+            uint32_t rowLevel = 64 + y * 63 / height;
+            for (uint32_t x = x0; x < x1; ++x)
+            {
+                uint32_t level = rowLevel + x * 128 / width;
+                uint8_t* pixel = row + x * 4;
+                pixel[0] = bBar ? 255 : (uint8_t)(canvas.tint[0] * level / 255);
+                pixel[1] = bBar ? 255 : (uint8_t)(canvas.tint[1] * level / 255);
+                pixel[2] = bBar ? 255 : (uint8_t)(canvas.tint[2] * level / 255);
+                pixel[3] = 255;
+            }
+        }
+    }
+}
+
+static void advanceCanvas(FakeCanvas& canvas)
+{
+    uint32_t bar = barWidth(canvas);
+    if (!canvas.bPainted)
+    {
+        paintColumns(canvas, 0, canvas.width, false);
+        canvas.bPainted = true;
+    }
+    else
+    {
+        paintColumns(canvas, canvas.barX, canvas.barX + bar, false);
+        uint32_t range = canvas.width > bar ? canvas.width - bar : 1;
+        canvas.barX = (canvas.barX + std::max(2u, canvas.width / 80)) % range;
+    }
+    paintColumns(canvas, canvas.barX, canvas.barX + bar, true);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// TRTCFakeEventDriver
+
+struct FakeRemoteUser
+{
+    TRTCFakeStreamInfo stream;
+    bool bVirtual = false;
+    bool bViewing = false;
+    bool bFirstFrameSent = false;
+    uint32_t volume = 0;
+};
+
+struct FakeRenderTarget
+{
+    ITRTCVideoRenderCallback* callback = NULL;
+    TRTCVideoPixelFormat format = TRTCVideoPixelFormat_Unknown;
+};
+
+struct TRTCFakeEventDriver::State
+{
+    TRTCFakeCloudParams params;
+
+    std::recursive_mutex dispatchMutex;     //صڼ
+    std::vector<ITRTCCloudCallback*> callbacks;
+
+    mutable std::mutex mutex;               //ͷ״̬
+    bool bRunning = false;
+    uint64_t generation = 0;                //ÿ startstop һڵĶʱݴ
+    uint64_t volumeGeneration = 0;          //ʾڱ仯ʱһ
+    std::string localUserId;
+    std::minstd_rand random;
+    TRTCFakeStreamInfo localStream;
+    TRTCVideoStreamType priorRemoteType = TRTCVideoStreamTypeBig;
+    uint32_t voiceVolumeIntervalMs = 0;
+    uint32_t localVolume = 0;
+    std::map<std::string, FakeRemoteUser> remoteUsers;
+    uint32_t nextVirtualIndex = 0;
+    uint64_t sentBytes = 0;
+    uint64_t receivedBytes = 0;
+    FakeClock::time_point startTime;
+
+    std::recursive_mutex renderMutex;       //ȾڼУȾ״̬
+    std::condition_variable_any renderCond;
+    FakeRenderTarget localRender;
+    FakeRenderTarget allRemoteRender;
+    std::map<std::string, FakeRenderTarget> remoteRenders;
+    std::map<std::string, FakeCanvas> canvases;
+    std::thread renderThread;
+    bool bExitRender = false;
+    std::atomic<uint64_t> renderedFrames;
+
+    State() : renderedFrames(0) {}
+};
+
+typedef std::shared_ptr<TRTCFakeEventDriver::State> StatePtr;
+typedef std::weak_ptr<TRTCFakeEventDriver::State> StateWeakPtr;
+
+static void dispatchState(const StatePtr& state, const std::function<void(ITRTCCloudCallback*)>& fn)
+{
+    std::lock_guard<std::recursive_mutex> dispatchLock(state->dispatchMutex);
+    std::vector<ITRTCCloudCallback*> callbacks = state->callbacks;
+    for (size_t i = 0; i < callbacks.size(); ++i)
+        fn(callbacks[i]);
+}
+
+//ûĽ״̬߻ص
+static void dispatchUserEnter(const StatePtr& state, const std::string& userId, const TRTCFakeStreamInfo& stream)
+{
+    dispatchState(state, [&](ITRTCCloudCallback* callback) {
+        callback->onUserEnter(userId.c_str());
+        if (stream.bVideo)
+            callback->onUserVideoAvailable(userId.c_str(), true);
+        if (stream.bAudio)
+            callback->onUserAudioAvailable(userId.c_str(), true);
+    });
+}
+
+static void addVirtualUser(const StatePtr& state, uint64_t generation)
+{
+    std::string userId;
+    TRTCFakeStreamInfo stream;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (!state->bRunning || state->generation != generation)
+            return;
+
+        char name[32] = { 0 };
+        snprintf(name, sizeof(name), "virtual_%u", state->nextVirtualIndex++);
+        userId = name;
+        stream.encParam = state->params.virtualUserEncParam;
+        stream.bSmallStream = true;
+        stream.smallEncParam.videoResolution = TRTCVideoResolution_320_240;
+        stream.smallEncParam.videoFps = 15;
+        stream.smallEncParam.videoBitrate = 100;
+        stream.bVideo = true;
+        stream.bAudio = true;
+
+        FakeRemoteUser& user = state->remoteUsers[userId];
+        user.stream = stream;
+        user.bVirtual = true;
+    }
+    dispatchUserEnter(state, userId, stream);
+    state->renderCond.notify_all();
+}
+
+static void sendStatistics(const StatePtr& state)
+{
+    std::vector<TRTCLocalStatistics> localStats;
+    std::vector<TRTCRemoteStatistics> remoteStats;
+    std::vector<std::string> remoteIds;     //TRTCRemoteStatistics  userId ַָ
+    TRTCStatistics statis;
+    memset(&statis, 0, sizeof(statis));
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        uint32_t intervalMs = state->params.statisticsIntervalMs;
+        uint32_t sentKbps = 0;
+        const TRTCFakeStreamInfo& local = state->localStream;
+        if (local.bVideo)
+        {
+            TRTCLocalStatistics item;
+            memset(&item, 0, sizeof(item));
+            TRTCVideoScaler::resolutionSize(local.encParam.videoResolution, local.encParam.resMode, item.width, item.height);
+            item.frameRate = local.encParam.videoFps;
+            item.videoBitrate = local.encParam.videoBitrate;
+            item.streamType = TRTCVideoStreamTypeBig;
+            localStats.push_back(item);
+            sentKbps += item.videoBitrate;
+
+            if (local.bSmallStream)
+            {
+                TRTCVideoScaler::resolutionSize(local.smallEncParam.videoResolution, local.smallEncParam.resMode, item.width, item.height);
+                item.frameRate = local.smallEncParam.videoFps;
+                item.videoBitrate = local.smallEncParam.videoBitrate;
+                item.streamType = TRTCVideoStreamTypeSmall;
+                localStats.push_back(item);
+                sentKbps += item.videoBitrate;
+            }
+        }
+        if (local.bAudio)
+        {
+            if (localStats.empty())
+            {
+                TRTCLocalStatistics item;
+                memset(&item, 0, sizeof(item));
+                item.streamType = TRTCVideoStreamTypeBig;
+                localStats.push_back(item);
+            }
+            localStats[0].audioSampleRate = 48000;
+            localStats[0].audioBitrate = 50;
+            sentKbps += 50;
+        }
+
+        statis.upLoss = state->random() % 3;
+        statis.downLoss = state->random() % 3;
+        statis.rtt = 30 + state->random() % 30;
+
+        //ֻͳеԶ˻Զû
+        uint32_t receivedKbps = 0;
+        std::map<std::string, FakeRemoteUser>::const_iterator it = state->remoteUsers.begin();
+        for (; it != state->remoteUsers.end(); ++it)
+        {
+            const TRTCFakeStreamInfo& stream = it->second.stream;
+            bool bVideo = stream.bVideo && it->second.bViewing;
+            if (!bVideo && !stream.bAudio)
+                continue;
+
+            bool bSmall = state->priorRemoteType == TRTCVideoStreamTypeSmall && stream.bSmallStream;
+            const TRTCVideoEncParam& param = bSmall ? stream.smallEncParam : stream.encParam;
+            TRTCRemoteStatistics item;
+            item.finalLoss = statis.downLoss;
+            item.width = 0;
+            item.height = 0;
+            item.frameRate = 0;
+            item.videoBitrate = 0;
+            if (bVideo)
+            {
+                TRTCVideoScaler::resolutionSize(param.videoResolution, param.resMode, item.width, item.height);
+                item.frameRate = param.videoFps;
+                item.videoBitrate = param.videoBitrate;
+            }
+            item.audioSampleRate = stream.bAudio ? 48000 : 0;
+            item.audioBitrate = stream.bAudio ? 50 : 0;
+            item.streamType = bSmall ? TRTCVideoStreamTypeSmall : TRTCVideoStreamTypeBig;
+            remoteStats.push_back(item);
+            remoteIds.push_back(it->first);
+            receivedKbps += item.videoBitrate + item.audioBitrate;
+        }
+
+        state->sentBytes += (uint64_t)sentKbps * intervalMs / 8;
+        state->receivedBytes += (uint64_t)receivedKbps * intervalMs / 8;
+        statis.sentBytes = (uint32_t)state->sentBytes;
+        statis.receivedBytes = (uint32_t)state->receivedBytes;
+    }
+
+    for (size_t i = 0; i < remoteStats.size(); ++i)
+        remoteStats[i].userId = remoteIds[i].c_str();
+    statis.localStatisticsArray = localStats.empty() ? NULL : &localStats[0];
+    statis.localStatisticsArraySize = (uint32_t)localStats.size();
+    statis.remoteStatisticsArray = remoteStats.empty() ? NULL : &remoteStats[0];
+    statis.remoteStatisticsArraySize = (uint32_t)remoteStats.size();
+
+    dispatchState(state, [&statis](ITRTCCloudCallback* callback) {
+        callback->onStatistics(statis);
+    });
+}
+
+static void sendNetworkQuality(const StatePtr& state)
+{
+    TRTCQualityInfo localQuality;
+    std::vector<TRTCQualityInfo> remoteQuality;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        localQuality.userId = state->localUserId.c_str();
+        localQuality.quality = (state->random() % 4 == 0) ? TRTCQuality_Good : TRTCQuality_Excellent;
+
+        remoteQuality.resize(state->remoteUsers.size());
+        size_t i = 0;
+        std::map<std::string, FakeRemoteUser>::const_iterator it = state->remoteUsers.begin();
+        for (; it != state->remoteUsers.end(); ++it, ++i)
+        {
+            remoteQuality[i].userId = it->first.c_str();
+            remoteQuality[i].quality = (state->random() % 4 == 0) ? TRTCQuality_Good : TRTCQuality_Excellent;
+        }
+    }
+
+    TRTCQualityInfo* remoteArray = remoteQuality.empty() ? NULL : &remoteQuality[0];
+    uint32_t remoteCount = (uint32_t)remoteQuality.size();
+    dispatchState(state, [&](ITRTCCloudCallback* callback) {
+        callback->onNetworkQuality(localQuality, remoteArray, remoteCount);
+    });
+}
+
+//֮ƽ仯ģ˵˰
+static uint32_t nextVolume(std::minstd_rand& random, uint32_t volume)
+{
+    uint32_t target = (random() % 3 == 0) ? 0 : (uint32_t)(random() % 101);
+    return (volume * 3 + target) / 4;
+}
+
+static void sendVoiceVolume(const StatePtr& state)
+{
+    std::vector<TRTCVolumeInfo> volumes;
+    uint32_t totalVolume = 0;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->localStream.bAudio)
+        {
+            state->localVolume = nextVolume(state->random, state->localVolume);
+            TRTCVolumeInfo info;
+            info.userId = state->localUserId.c_str();
+            info.volume = state->localVolume;
+            volumes.push_back(info);
+        }
+
+        std::map<std::string, FakeRemoteUser>::iterator it = state->remoteUsers.begin();
+        for (; it != state->remoteUsers.end(); ++it)
+        {
+            if (!it->second.stream.bAudio)
+                continue;
+            it->second.volume = nextVolume(state->random, it->second.volume);
+            TRTCVolumeInfo info;
+            info.userId = it->first.c_str();
+            info.volume = it->second.volume;
+            volumes.push_back(info);
+        }
+    }
+
+    for (size_t i = 0; i < volumes.size(); ++i)
+        totalVolume = std::max(totalVolume, volumes[i].volume);
+
+    TRTCVolumeInfo* volumeArray = volumes.empty() ? NULL : &volumes[0];
+    uint32_t volumeCount = (uint32_t)volumes.size();
+    dispatchState(state, [&](ITRTCCloudCallback* callback) {
+        callback->onUserVoiceVolume(volumeArray, volumeCount, totalVolume);
+    });
+}
+
+//һģû˷һµģû
+static void churnVirtualUser(const StatePtr& state, uint64_t generation)
+{
+    std::string userId;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        std::vector<std::string> virtualIds;
+        std::map<std::string, FakeRemoteUser>::const_iterator it = state->remoteUsers.begin();
+        for (; it != state->remoteUsers.end(); ++it)
+        {
+            if (it->second.bVirtual)
+                virtualIds.push_back(it->first);
+        }
+        if (virtualIds.empty())
+            return;
+        userId = virtualIds[state->random() % virtualIds.size()];
+        state->remoteUsers.erase(userId);
+    }
+    dispatchState(state, [&userId](ITRTCCloudCallback* callback) {
+        callback->onUserExit(userId.c_str(), 0);
+    });
+    addVirtualUser(state, generation);
+}
+
+enum FakeTimerType
+{
+    FakeTimerStatistics,
+    FakeTimerNetworkQuality,
+    FakeTimerVoiceVolume,
+    FakeTimerChurn,
+};
+
+static void postTimer(const StateWeakPtr& weakState, uint64_t generation, FakeTimerType type)
+{
+    StatePtr state = weakState.lock();
+    if (!state)
+        return;
+
+    uint32_t intervalMs = 0;
+    uint64_t volumeGeneration = 0;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        switch (type)
+        {
+        case FakeTimerStatistics: intervalMs = state->params.statisticsIntervalMs; break;
+        case FakeTimerNetworkQuality: intervalMs = state->params.networkQualityIntervalMs; break;
+        case FakeTimerVoiceVolume: intervalMs = state->voiceVolumeIntervalMs; break;
+        case FakeTimerChurn: intervalMs = state->params.userChurnIntervalMs; break;
+        }
+        volumeGeneration = state->volumeGeneration;
+    }
+    if (intervalMs == 0)
+        return;
+
+    TRTCFakeCallbackThread::instance().post(intervalMs, [weakState, generation, volumeGeneration, type]() {
+        StatePtr state = weakState.lock();
+        if (!state)
+            return;
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (!state->bRunning || state->generation != generation)
+                return;
+            if (type == FakeTimerVoiceVolume && state->volumeGeneration != volumeGeneration)
+                return;
+        }
+
+        switch (type)
+        {
+        case FakeTimerStatistics: sendStatistics(state); break;
+        case FakeTimerNetworkQuality: sendNetworkQuality(state); break;
+        case FakeTimerVoiceVolume: sendVoiceVolume(state); break;
+        case FakeTimerChurn: churnVirtualUser(state, generation); break;
+        }
+        postTimer(weakState, generation, type);
+    });
+}
+
+//һ·ȾĻ
+struct FakeRenderJob
+{
+    std::string canvasKey;
+    std::string userId;
+    TRTCVideoStreamType streamType;
+    FakeRenderTarget target;
+    uint32_t width;
+    uint32_t height;
+    uint32_t fps;
+    bool bRemote;
+};
+
+static void renderThreadProc(TRTCFakeEventDriver::State* state, StateWeakPtr weakState)
+{
+    std::unique_lock<std::recursive_mutex> renderLock(state->renderMutex);
+    while (!state->bExitRender)
+    {
+        std::vector<FakeRenderJob> jobs;
+        uint64_t generation = 0;
+        FakeClock::time_point startTime;
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            generation = state->generation;
+            startTime = state->startTime;
+            uint32_t renderFps = state->params.renderFps;
+            if (state->bRunning)
+            {
+                const TRTCFakeStreamInfo& local = state->localStream;
+                if (local.bVideo && state->localRender.callback)
+                {
+                    FakeRenderJob job;
+                    job.userId = state->localUserId;
+                    job.streamType = TRTCVideoStreamTypeBig;
+                    job.target = state->localRender;
+                    TRTCVideoScaler::resolutionSize(local.encParam.videoResolution, local.encParam.resMode, job.width, job.height);
+                    job.fps = renderFps ? renderFps : local.encParam.videoFps;
+                    job.bRemote = false;
+                    jobs.push_back(job);
+                }
+
+                std::map<std::string, FakeRemoteUser>::const_iterator it = state->remoteUsers.begin();
+                for (; it != state->remoteUsers.end(); ++it)
+                {
+                    if (!it->second.bViewing || !it->second.stream.bVideo)
+                        continue;
+                    std::map<std::string, FakeRenderTarget>::const_iterator render = state->remoteRenders.find(it->first);
+                    FakeRenderTarget target = render != state->remoteRenders.end() ? render->second : state->allRemoteRender;
+                    if (!target.callback)
+                        continue;
+
+                    const TRTCFakeStreamInfo& stream = it->second.stream;
+                    bool bSmall = state->priorRemoteType == TRTCVideoStreamTypeSmall && stream.bSmallStream;
+                    const TRTCVideoEncParam& param = bSmall ? stream.smallEncParam : stream.encParam;
+                    FakeRenderJob job;
+                    job.userId = it->first;
+                    job.streamType = bSmall ? TRTCVideoStreamTypeSmall : TRTCVideoStreamTypeBig;
+                    job.target = target;
+                    TRTCVideoScaler::resolutionSize(param.videoResolution, param.resMode, job.width, job.height);
+                    job.fps = renderFps ? renderFps : param.videoFps;
+                    job.bRemote = true;
+                    jobs.push_back(job);
+                }
+            }
+        }
+
+        //ػ key ǰһԶ userId ﲻֵַ
+        for (size_t i = 0; i < jobs.size(); ++i)
+            jobs[i].canvasKey = jobs[i].bRemote ? jobs[i].userId : std::string("\x01") + jobs[i].userId;
+
+        //ȾĻͷŻ
+        std::map<std::string, FakeCanvas>::iterator canvasIt = state->canvases.begin();
+        while (canvasIt != state->canvases.end())
+        {
+            bool bUsed = false;
+            for (size_t i = 0; i < jobs.size() && !bUsed; ++i)
+                bUsed = jobs[i].canvasKey == canvasIt->first;
+            if (bUsed)
+                ++canvasIt;
+            else
+                state->canvases.erase(canvasIt++);
+        }
+
+        FakeClock::time_point now = FakeClock::now();
+        FakeClock::time_point nextDue = now + std::chrono::seconds(1);
+        for (size_t i = 0; i < jobs.size(); ++i)
+        {
+            const FakeRenderJob& job = jobs[i];
+            if (job.fps == 0 || job.width == 0 || job.height == 0)
+                continue;
+
+            FakeCanvas& canvas = state->canvases[job.canvasKey];
+            if (canvas.format != job.target.format || canvas.width != job.width || canvas.height != job.height)
+            {
+                resetCanvas(canvas, job.target.format, job.width, job.height, job.userId);
+                canvas.nextFrameTime = now;
+            }
+            if (canvas.nextFrameTime > now)
+            {
+                nextDue = std::min(nextDue, canvas.nextFrameTime);
+                continue;
+            }
+
+            advanceCanvas(canvas);
+            TRTCVideoFrame frame;
+            frame.videoFormat = canvas.format;
+            frame.bufferType = TRTCVideoBufferType_Buffer;
+            frame.data = &canvas.data[0];
+            frame.length = (uint32_t)canvas.data.size();
+            frame.width = canvas.width;
+            frame.height = canvas.height;
+            frame.timestamp = (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime).count();
+            job.target.callback->onRenderVideoFrame(job.userId.c_str(), job.streamType, &frame);
+            ++state->renderedFrames;
+
+            //̫ʱ׷֡ʵȾһֱӶ
+            std::chrono::microseconds interval(1000000 / job.fps);
+            canvas.nextFrameTime += interval;
+            if (canvas.nextFrameTime < now)
+                canvas.nextFrameTime = now + interval;
+            nextDue = std::min(nextDue, canvas.nextFrameTime);
+
+            if (job.bRemote)
+            {
+                bool bFirstFrame = false;
+                {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    std::map<std::string, FakeRemoteUser>::iterator user = state->remoteUsers.find(job.userId);
+                    if (user != state->remoteUsers.end() && !user->second.bFirstFrameSent && state->generation == generation)
+                    {
+                        user->second.bFirstFrameSent = true;
+                        bFirstFrame = true;
+                    }
+                }
+                if (bFirstFrame)
+                {
+                    std::string userId = job.userId;
+                    uint32_t width = canvas.width;
+                    uint32_t height = canvas.height;
+                    TRTCFakeCallbackThread::instance().post(0, [weakState, generation, userId, width, height]() {
+                        StatePtr state = weakState.lock();
+                        if (!state)
+                            return;
+                        {
+                            std::lock_guard<std::mutex> lock(state->mutex);
+                            if (!state->bRunning || state->generation != generation)
+                                return;
+                        }
+                        dispatchState(state, [&](ITRTCCloudCallback* callback) {
+                            callback->onFirstVideoFrame(userId.c_str(), width, height);
+                        });
+                    });
+                }
+            }
+        }
+
+        state->renderCond.wait_until(renderLock, nextDue);
+    }
+}
+
+TRTCFakeEventDriver::TRTCFakeEventDriver(const TRTCFakeCloudParams& params)
+    : m_state(std::make_shared<State>())
+{
+    m_state->params = params;
+    m_state->voiceVolumeIntervalMs = params.voiceVolumeIntervalMs;
+}
+
+TRTCFakeEventDriver::~TRTCFakeEventDriver()
+{
+    stop();
+    {
+        std::lock_guard<std::recursive_mutex> dispatchLock(m_state->dispatchMutex);
+        m_state->callbacks.clear();
+    }
+    {
+        std::lock_guard<std::recursive_mutex> renderLock(m_state->renderMutex);
+        m_state->bExitRender = true;
+    }
+    m_state->renderCond.notify_all();
+    if (m_state->renderThread.joinable())
+        m_state->renderThread.join();
+}
+
+void TRTCFakeEventDriver::addCallback(ITRTCCloudCallback* callback)
+{
+    std::lock_guard<std::recursive_mutex> dispatchLock(m_state->dispatchMutex);
+    std::vector<ITRTCCloudCallback*>& callbacks = m_state->callbacks;
+    if (callback && std::find(callbacks.begin(), callbacks.end(), callback) == callbacks.end())
+        callbacks.push_back(callback);
+}
+
+void TRTCFakeEventDriver::removeCallback(ITRTCCloudCallback* callback)
+{
+    std::lock_guard<std::recursive_mutex> dispatchLock(m_state->dispatchMutex);
+    std::vector<ITRTCCloudCallback*>& callbacks = m_state->callbacks;
+    callbacks.erase(std::remove(callbacks.begin(), callbacks.end(), callback), callbacks.end());
+}
+
+void TRTCFakeEventDriver::dispatch(const std::function<void(ITRTCCloudCallback*)>& fn)
+{
+    dispatchState(m_state, fn);
+}
+
+int TRTCFakeEventDriver::setLocalVideoRenderCallback(TRTCVideoPixelFormat pixelFormat, TRTCVideoBufferType bufferType, ITRTCVideoRenderCallback* callback)
+{
+    if (callback && ((pixelFormat != TRTCVideoPixelFormat_I420 && pixelFormat != TRTCVideoPixelFormat_BGRA32) || bufferType != TRTCVideoBufferType_Buffer))
+        return -1;
+
+    std::lock_guard<std::recursive_mutex> renderLock(m_state->renderMutex);
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    m_state->localRender.callback = callback;
+    m_state->localRender.format = callback ? pixelFormat : TRTCVideoPixelFormat_Unknown;
+    if (callback && !m_state->renderThread.joinable())
+        m_state->renderThread = std::thread(renderThreadProc, m_state.get(), StateWeakPtr(m_state));
+    m_state->renderCond.notify_all();
+    return 0;
+}
+
+int TRTCFakeEventDriver::setRemoteVideoRenderCallback(const char* userId, TRTCVideoPixelFormat pixelFormat, TRTCVideoBufferType bufferType, ITRTCVideoRenderCallback* callback)
+{
+    if (callback && ((pixelFormat != TRTCVideoPixelFormat_I420 && pixelFormat != TRTCVideoPixelFormat_BGRA32) || bufferType != TRTCVideoBufferType_Buffer))
+        return -1;
+
+    FakeRenderTarget target;
+    target.callback = callback;
+    target.format = callback ? pixelFormat : TRTCVideoPixelFormat_Unknown;
+
+    std::lock_guard<std::recursive_mutex> renderLock(m_state->renderMutex);
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    if (userId == NULL)
+        m_state->allRemoteRender = target;
+    else if (callback)
+        m_state->remoteRenders[userId] = target;
+    else
+        m_state->remoteRenders.erase(userId);
+    if (callback && !m_state->renderThread.joinable())
+        m_state->renderThread = std::thread(renderThreadProc, m_state.get(), StateWeakPtr(m_state));
+    m_state->renderCond.notify_all();
+    return 0;
+}
+
+void TRTCFakeEventDriver::enableAudioVolumeEvaluation(uint32_t intervalMs)
+{
+    uint64_t generation = 0;
+    bool bRunning = false;
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        m_state->voiceVolumeIntervalMs = intervalMs;
+        ++m_state->volumeGeneration;
+        generation = m_state->generation;
+        bRunning = m_state->bRunning;
+    }
+    if (bRunning)
+        postTimer(m_state, generation, FakeTimerVoiceVolume);
+}
+
+void TRTCFakeEventDriver::setLocalStream(const TRTCFakeStreamInfo& stream)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        m_state->localStream = stream;
+    }
+    m_state->renderCond.notify_all();
+}
+
+TRTCFakeStreamInfo TRTCFakeEventDriver::getLocalStream() const
+{
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    return m_state->localStream;
+}
+
+void TRTCFakeEventDriver::setPriorRemoteVideoStreamType(TRTCVideoStreamType type)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        m_state->priorRemoteType = type;
+    }
+    m_state->renderCond.notify_all();
+}
+
+void TRTCFakeEventDriver::startRemoteView(const char* userId)
+{
+    if (userId == NULL)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        std::map<std::string, FakeRemoteUser>::iterator it = m_state->remoteUsers.find(userId);
+        if (it == m_state->remoteUsers.end())
+            return;
+        it->second.bViewing = true;
+    }
+    m_state->renderCond.notify_all();
+}
+
+void TRTCFakeEventDriver::stopRemoteView(const char* userId)
+{
+    if (userId == NULL)
+        return;
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    std::map<std::string, FakeRemoteUser>::iterator it = m_state->remoteUsers.find(userId);
+    if (it != m_state->remoteUsers.end())
+        it->second.bViewing = false;
+}
+
+void TRTCFakeEventDriver::stopAllRemoteView()
+{
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    std::map<std::string, FakeRemoteUser>::iterator it = m_state->remoteUsers.begin();
+    for (; it != m_state->remoteUsers.end(); ++it)
+        it->second.bViewing = false;
+}
+
+void TRTCFakeEventDriver::start(const std::string& localUserId, uint32_t seed)
+{
+    uint64_t generation = 0;
+    uint32_t virtualUserCount = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        if (m_state->bRunning)
+            return;
+        m_state->bRunning = true;
+        generation = ++m_state->generation;
+        m_state->localUserId = localUserId;
+        m_state->random.seed(seed);
+        m_state->nextVirtualIndex = 0;
+        m_state->startTime = FakeClock::now();
+        virtualUserCount = m_state->params.virtualUserCount;
+    }
+
+    //ģûڻص߳Ͻ֮¼Ҳڻص߳
+    StateWeakPtr weakState = m_state;
+    TRTCFakeCallbackThread::instance().post(0, [weakState, generation, virtualUserCount]() {
+        StatePtr state = weakState.lock();
+        if (!state)
+            return;
+        for (uint32_t i = 0; i < virtualUserCount; ++i)
+            addVirtualUser(state, generation);
+    });
+    postTimer(m_state, generation, FakeTimerStatistics);
+    postTimer(m_state, generation, FakeTimerNetworkQuality);
+    postTimer(m_state, generation, FakeTimerVoiceVolume);
+    postTimer(m_state, generation, FakeTimerChurn);
+    m_state->renderCond.notify_all();
+}
+
+void TRTCFakeEventDriver::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        if (!m_state->bRunning)
+            return;
+        m_state->bRunning = false;
+        ++m_state->generation;
+        m_state->remoteUsers.clear();
+        m_state->localVolume = 0;
+    }
+
+    //ڽеȾغ󲻻лص
+    std::lock_guard<std::recursive_mutex> renderLock(m_state->renderMutex);
+    m_state->canvases.clear();
+    m_state->renderCond.notify_all();
+}
+
+void TRTCFakeEventDriver::remoteUserEnter(const std::string& userId, const TRTCFakeStreamInfo& stream)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        if (!m_state->bRunning)
+            return;
+        FakeRemoteUser& user = m_state->remoteUsers[userId];
+        user = FakeRemoteUser();
+        user.stream = stream;
+    }
+    dispatchUserEnter(m_state, userId, stream);
+}
+
+void TRTCFakeEventDriver::remoteUserExit(const std::string& userId, int reason)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        if (m_state->remoteUsers.erase(userId) == 0)
+            return;
+    }
+    dispatchState(m_state, [&](ITRTCCloudCallback* callback) {
+        callback->onUserExit(userId.c_str(), reason);
+    });
+}
+
+void TRTCFakeEventDriver::remoteUserAvailable(const std::string& userId, bool bVideo, bool available)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        std::map<std::string, FakeRemoteUser>::iterator it = m_state->remoteUsers.find(userId);
+        if (it == m_state->remoteUsers.end())
+            return;
+        bool& flag = bVideo ? it->second.stream.bVideo : it->second.stream.bAudio;
+        if (flag == available)
+            return;
+        flag = available;
+    }
+    dispatchState(m_state, [&](ITRTCCloudCallback* callback) {
+        if (bVideo)
+            callback->onUserVideoAvailable(userId.c_str(), available);
+        else
+            callback->onUserAudioAvailable(userId.c_str(), available);
+    });
+    m_state->renderCond.notify_all();
+}
+
+uint64_t TRTCFakeEventDriver::getRenderedFrameCount() const
+{
+    return m_state->renderedFrames;
+}
@@ -0,0 +1,117 @@
+#pragma once
+/*
+* Module:   TRTCFakeEventDriver
+*
+* Function: õķģƵʺϳ TRTC ص¼Ƶ֡û SDK Ļѹصͻ洦
+*
+*    1. ¼ TRTCFakeCallbackThread һģ SDK ص߳Ϸ SDK һͬһʵĻصᲢ
+*       Ƶ֡ԼȾ߳ͨ ITRTCVideoRenderCallback 
+*
+*    2. start ֮ģ virtualUserCount Զû԰ userChurnIntervalMs Եػˣ
+*       Եط onStatisticsonNetworkQualityonUserVoiceVolume
+*
+*    3. ԶûҲⲿͨ remoteUserEnter/remoteUserExit 루TRTCFakeCloud ͬڵʵ
+*       ģûһͳơȾС
+*
+*    4. ǴûɫĽ䱳һƶÿֻ֡ػļУȷÿֻ֡С仯
+*/
+
+#include "TRTCCloudCallback.h"
+#include "TRTCCloudDef.h"
+
+#include <string>
+#include <memory>
+#include <functional>
+#include <stdint.h>
+
+struct TRTCFakeCloudParams
+{
+    uint32_t enterLatencyMs = 120;              //ʱ
+    uint32_t enterJitterMs = 80;                //ʱӵ
+    uint32_t exitLatencyMs = 20;                //˷ʱ
+    uint32_t statisticsIntervalMs = 2000;       //onStatistics ڣ0 ʾ
+    uint32_t networkQualityIntervalMs = 2000;   //onNetworkQuality ڣ0 ʾ
+    uint32_t voiceVolumeIntervalMs = 0;         //onUserVoiceVolume ڣ0 ʾenableAudioVolumeEvaluation ޸
+
+    uint32_t virtualUserCount = 0;              //ģԶû
+    uint32_t userChurnIntervalMs = 0;           //ÿһģû˷һû0 ʾ
+    TRTCVideoEncParam virtualUserEncParam;      //ģûıԶͳƺȾĴС֡
+    uint32_t renderFps = 0;                     //Ⱦص֡ʣ0 ʾʹø·Լı֡
+};
+
+//ģ SDK ص̣߳жʱ񰴵ʱ˳ͬһִ߳
+class TRTCFakeCallbackThread
+{
+protected:
+    TRTCFakeCallbackThread();
+    TRTCFakeCallbackThread(const TRTCFakeCallbackThread&);
+    TRTCFakeCallbackThread operator =(const TRTCFakeCallbackThread&);
+public:
+    ~TRTCFakeCallbackThread();
+    static TRTCFakeCallbackThread& instance();
+
+    void post(uint32_t delayMs, std::function<void()> task);
+
+    struct Impl;
+private:
+    std::unique_ptr<Impl> m_impl;
+};
+
+//һ·״̬
+struct TRTCFakeStreamInfo
+{
+    TRTCVideoEncParam encParam;
+    bool bSmallStream = false;
+    TRTCVideoEncParam smallEncParam;
+    bool bVideo = false;
+    bool bAudio = false;
+};
+
+class TRTCFakeEventDriver
+{
+public:
+    explicit TRTCFakeEventDriver(const TRTCFakeCloudParams& params = TRTCFakeCloudParams());
+    ~TRTCFakeEventDriver();
+
+    void addCallback(ITRTCCloudCallback* callback);
+    //غ󲻻лص callbackڻصڲó⣩
+    void removeCallback(ITRTCCloudCallback* callback);
+
+    //ڵ߳ϰ fn ÿص󣬳лصremoveCallback 
+    void dispatch(const std::function<void(ITRTCCloudCallback*)>& fn);
+
+    // TRTCCloud ͬӿһ£callback Ϊ NULL ʱֹͣصԶ userId Ϊ NULL ʱԶûЧ
+    int setLocalVideoRenderCallback(TRTCVideoPixelFormat pixelFormat, TRTCVideoBufferType bufferType, ITRTCVideoRenderCallback* callback);
+    int setRemoteVideoRenderCallback(const char* userId, TRTCVideoPixelFormat pixelFormat, TRTCVideoBufferType bufferType, ITRTCVideoRenderCallback* callback);
+    void enableAudioVolumeEvaluation(uint32_t intervalMs);
+
+    //״̬ڱͳơȾԶ˿Ļ
+    void setLocalStream(const TRTCFakeStreamInfo& stream);
+    TRTCFakeStreamInfo getLocalStream() const;
+    void setPriorRemoteVideoStreamType(TRTCVideoStreamType type);
+
+    //ֻеԶûŻȾԶͳ
+    void startRemoteView(const char* userId);
+    void stopRemoteView(const char* userId);
+    void stopAllRemoteView();
+
+    //ʼģû¼seed ģݣͬһ seed ÿεõͬ
+    void start(const std::string& localUserId, uint32_t seed);
+    //ֹͣٷκ¼ͻ棬ģûĬ뿪
+    void stop();
+
+    //ⲿԶû״̬仯ڵ߳ϷӦص
+    void remoteUserEnter(const std::string& userId, const TRTCFakeStreamInfo& stream);
+    void remoteUserExit(const std::string& userId, int reason);
+    void remoteUserAvailable(const std::string& userId, bool bVideo, bool available);
+
+    uint64_t getRenderedFrameCount() const;
+
+    struct State;
+private:
+    TRTCFakeEventDriver(const TRTCFakeEventDriver&);
+    TRTCFakeEventDriver& operator =(const TRTCFakeEventDriver&);
+
+    //ʱֻ State ãδڵ¼Զ
+    std::shared_ptr<State> m_state;
+};
@@ -0,0 +1,743 @@
+/*
+* Module:   TRTCFakeSDK
+*
+* Function:  SDK ͷļʵֵ TRTCCloudTXString ȵ࣬ TRTCFakeCloud ΪˣԴ liteav.lib 
+*/
+
+//룬 liteav.dll һ
+#define LITEAV_EXPORTS
+
+#include "TRTCFakeSDK.h"
+#include "TRTCFakeCloud.h"
+#include "TRTCCloud.h"
+
+#include <string>
+#include <vector>
+#include <mutex>
+
+static const char* const kFakeCameraDevice = "Fake Camera";
+static const char* const kFakeMicDevice = "Fake Microphone";
+static const char* const kFakeSpeakerDevice = "Fake Speaker";
+
+struct FakeSDKGlobals
+{
+    std::mutex mutex;
+    TRTCFakeCloudParams cloudParams;
+    TRTCLogLevel logLevel = TRTCLogLevelInfo;
+    ITRTCLogCallback* logCallback = NULL;
+};
+
+static FakeSDKGlobals& fakeSDKGlobals()
+{
+    static FakeSDKGlobals globals;
+    return globals;
+}
+
+static void fakeLog(TRTCLogLevel level, const std::string& text)
+{
+    ITRTCLogCallback* callback = NULL;
+    {
+        FakeSDKGlobals& globals = fakeSDKGlobals();
+        std::lock_guard<std::mutex> lock(globals.mutex);
+        if (globals.logLevel == TRTCLogLevelNone || level < globals.logLevel)
+            return;
+        callback = globals.logCallback;
+    }
+    if (callback)
+        callback->onLog(text.c_str(), level, "TXLiteAVSDK");
+}
+
+void TRTCFakeSDKSetCloudParams(const TRTCFakeCloudParams& params)
+{
+    FakeSDKGlobals& globals = fakeSDKGlobals();
+    std::lock_guard<std::mutex> lock(globals.mutex);
+    globals.cloudParams = params;
+}
+
+TRTCFakeCloudParams TRTCFakeSDKGetCloudParams()
+{
+    FakeSDKGlobals& globals = fakeSDKGlobals();
+    std::lock_guard<std::mutex> lock(globals.mutex);
+    return globals.cloudParams;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// TXString
+
+class TXStringImpl
+{
+public:
+    std::string str;
+};
+
+//TXString û޸ݵĽӿڣʱͬһ
+TXString::TXString()
+    : m_impl(std::make_shared<TXStringImpl>())
+{
+
+}
+
+TXString::TXString(const char *s)
+    : m_impl(std::make_shared<TXStringImpl>())
+{
+    if (s)
+        m_impl->str = s;
+}
+
+TXString::TXString(const char *s, size_t size)
+    : m_impl(std::make_shared<TXStringImpl>())
+{
+    if (s)
+        m_impl->str.assign(s, size);
+}
+
+TXString::TXString(const TXString& str)
+    : m_impl(str.m_impl)
+{
+
+}
+
+TXString::~TXString()
+{
+
+}
+
+size_t TXString::size() const
+{
+    return m_impl->str.size();
+}
+
+bool TXString::empty() const
+{
+    return m_impl->str.empty();
+}
+
+const char* TXString::c_str() const
+{
+    return m_impl->str.c_str();
+}
+
+TXString& TXString::operator =(const TXString& str)
+{
+    m_impl = str.m_impl;
+    return *this;
+}
+
+bool TXString::operator ==(const TXString& other) const
+{
+    return m_impl->str == other.m_impl->str;
+}
+
+bool TXString::operator !=(const TXString& other) const
+{
+    return m_impl->str != other.m_impl->str;
+}
+
+bool TXString::operator <(const TXString& other) const
+{
+    return m_impl->str < other.m_impl->str;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// TXStringList
+
+class TXStringListImpl
+{
+public:
+    std::vector<TXString> list;
+};
+
+TXStringList::TXStringList()
+    : m_impl(std::make_shared<TXStringListImpl>())
+{
+
+}
+
+TXStringList::TXStringList(const TXStringList& list)
+    : m_impl(std::make_shared<TXStringListImpl>(*list.m_impl))
+{
+
+}
+
+TXStringList::~TXStringList()
+{
+
+}
+
+size_t TXStringList::size() const
+{
+    return m_impl->list.size();
+}
+
+bool TXStringList::empty() const
+{
+    return m_impl->list.empty();
+}
+
+void TXStringList::clear()
+{
+    m_impl->list.clear();
+}
+
+void TXStringList::push_back(const TXString& str)
+{
+    m_impl->list.push_back(str);
+}
+
+void TXStringList::pop_back()
+{
+    m_impl->list.pop_back();
+}
+
+TXString& TXStringList::operator [](size_t pos)
+{
+    return m_impl->list[pos];
+}
+
+TXStringList& TXStringList::operator =(const TXStringList& list)
+{
+    if (this != &list)
+        m_impl = std::make_shared<TXStringListImpl>(*list.m_impl);
+    return *this;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// TRTCScreenCaptureSourceInfoList
+
+class TRTCScreenCaptureSourceInfoListImpl
+{
+public:
+    std::vector<TRTCScreenCaptureSourceInfo> list;
+};
+
+TRTCScreenCaptureSourceInfoList::TRTCScreenCaptureSourceInfoList()
+    : m_impl(std::make_shared<TRTCScreenCaptureSourceInfoListImpl>())
+{
+
+}
+
+TRTCScreenCaptureSourceInfoList::TRTCScreenCaptureSourceInfoList(const TRTCScreenCaptureSourceInfoList& list)
+    : m_impl(std::make_shared<TRTCScreenCaptureSourceInfoListImpl>(*list.m_impl))
+{
+
+}
+
+TRTCScreenCaptureSourceInfoList::~TRTCScreenCaptureSourceInfoList()
+{
+
+}
+
+size_t TRTCScreenCaptureSourceInfoList::size() const
+{
+    return m_impl->list.size();
+}
+
+bool TRTCScreenCaptureSourceInfoList::empty() const
+{
+    return m_impl->list.empty();
+}
+
+void TRTCScreenCaptureSourceInfoList::clear()
+{
+    m_impl->list.clear();
+}
+
+void TRTCScreenCaptureSourceInfoList::push_back(const TRTCScreenCaptureSourceInfo& info)
+{
+    m_impl->list.push_back(info);
+}
+
+void TRTCScreenCaptureSourceInfoList::pop_back()
+{
+    m_impl->list.pop_back();
+}
+
+TRTCScreenCaptureSourceInfo& TRTCScreenCaptureSourceInfoList::operator [](size_t pos)
+{
+    return m_impl->list[pos];
+}
+
+TRTCScreenCaptureSourceInfoList& TRTCScreenCaptureSourceInfoList::operator =(const TRTCScreenCaptureSourceInfoList& list)
+{
+    if (this != &list)
+        m_impl = std::make_shared<TRTCScreenCaptureSourceInfoListImpl>(*list.m_impl);
+    return *this;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// TRTCCloud
+
+class TRTCCloudImpl
+{
+public:
+    explicit TRTCCloudImpl(const TRTCFakeCloudParams& params)
+        : cloud(params)
+    {
+    }
+
+    TRTCFakeCloud cloud;
+
+    std::mutex mutex;               //
+    std::string cameraDevice = kFakeCameraDevice;
+    std::string micDevice = kFakeMicDevice;
+    std::string speakerDevice = kFakeSpeakerDevice;
+    uint32_t micVolume = 100;
+    uint32_t speakerVolume = 100;
+};
+
+TRTCCloud::TRTCCloud()
+    : m_impl(std::make_shared<TRTCCloudImpl>(TRTCFakeSDKGetCloudParams()))
+{
+
+}
+
+TRTCCloud::~TRTCCloud()
+{
+
+}
+
+void TRTCCloud::addCallback(ITRTCCloudCallback* callback)
+{
+    m_impl->cloud.addCallback(callback);
+}
+
+void TRTCCloud::removeCallback(ITRTCCloudCallback* callback)
+{
+    m_impl->cloud.removeCallback(callback);
+}
+
+void TRTCCloud::enterRoom(const TRTCParams& params, TRTCAppScene scene)
+{
+    fakeLog(TRTCLogLevelInfo, std::string("enterRoom userId:") + params.userId.c_str() + " roomId:" + std::to_string(params.roomId));
+    m_impl->cloud.enterRoom(params, scene);
+}
+
+void TRTCCloud::exitRoom()
+{
+    fakeLog(TRTCLogLevelInfo, "exitRoom");
+    m_impl->cloud.exitRoom();
+}
+
+void TRTCCloud::startLocalPreview(HWND rendHwnd)
+{
+    m_impl->cloud.startLocalPreview(rendHwnd);
+}
+
+void TRTCCloud::stopLocalPreview()
+{
+    m_impl->cloud.stopLocalPreview();
+}
+
+void TRTCCloud::startRemoteView(const char* userId, HWND rendHwnd)
+{
+    m_impl->cloud.startRemoteView(userId, rendHwnd);
+}
+
+void TRTCCloud::stopRemoteView(const char* userId)
+{
+    m_impl->cloud.stopRemoteView(userId);
+}
+
+void TRTCCloud::stopAllRemoteView()
+{
+    m_impl->cloud.stopAllRemoteView();
+}
+
+void TRTCCloud::muteLocalVideo(bool mute)
+{
+    m_impl->cloud.muteLocalVideo(mute);
+}
+
+void TRTCCloud::setVideoEncoderParam(const TRTCVideoEncParam& params)
+{
+    m_impl->cloud.setVideoEncoderParam(params);
+}
+
+void TRTCCloud::setNetworkQosParam(const TRTCNetworkQosParam& params)
+{
+    m_impl->cloud.setNetworkQosParam(params);
+}
+
+void TRTCCloud::setLocalViewFillMode(TRTCVideoFillMode mode)
+{
+    m_impl->cloud.setLocalViewFillMode(mode);
+}
+
+void TRTCCloud::setRemoteViewFillMode(const char* userId, TRTCVideoFillMode mode)
+{
+    m_impl->cloud.setRemoteViewFillMode(userId, mode);
+}
+
+void TRTCCloud::setLocalViewRotation(TRTCVideoRotation rotation)
+{
+
+}
+
+void TRTCCloud::setRemoteViewRotation(const char* userId, TRTCVideoRotation rotation)
+{
+
+}
+
+void TRTCCloud::setVideoEncoderRotation(TRTCVideoRotation rotation)
+{
+
+}
+
+void TRTCCloud::enableSmallVideoStream(bool enable, const TRTCVideoEncParam& smallVideoParam)
+{
+    m_impl->cloud.enableSmallVideoStream(enable, smallVideoParam);
+}
+
+void TRTCCloud::setRemoteVideoStreamType(const char* userId, TRTCVideoStreamType type)
+{
+
+}
+
+void TRTCCloud::setPriorRemoteVideoStreamType(TRTCVideoStreamType type)
+{
+    m_impl->cloud.setPriorRemoteVideoStreamType(type);
+}
+
+void TRTCCloud::setLocalVideoMirror(bool mirror)
+{
+
+}
+
+void TRTCCloud::startLocalAudio()
+{
+    m_impl->cloud.startLocalAudio();
+}
+
+void TRTCCloud::stopLocalAudio()
+{
+    m_impl->cloud.stopLocalAudio();
+}
+
+void TRTCCloud::muteLocalAudio(bool mute)
+{
+    m_impl->cloud.muteLocalAudio(mute);
+}
+
+void TRTCCloud::muteRemoteAudio(const char* userId, bool mute)
+{
+
+}
+
+void TRTCCloud::muteAllRemoteAudio(bool mute)
+{
+
+}
+
+void TRTCCloud::enableAudioVolumeEvaluation(uint32_t interval, uint32_t smoothLevel)
+{
+    m_impl->cloud.enableAudioVolumeEvaluation(interval);
+}
+
+TXStringList TRTCCloud::getCameraDevicesList()
+{
+    TXStringList list;
+    list.push_back(kFakeCameraDevice);
+    return list;
+}
+
+void TRTCCloud::setCurrentCameraDevice(const char* deviceId)
+{
+    if (deviceId == NULL)
+        return;
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    m_impl->cameraDevice = deviceId;
+}
+
+TXString TRTCCloud::getCurrentCameraDevice()
+{
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    return m_impl->cameraDevice.c_str();
+}
+
+TXStringList TRTCCloud::getMicDevicesList() const
+{
+    TXStringList list;
+    list.push_back(kFakeMicDevice);
+    return list;
+}
+
+void TRTCCloud::setCurrentMicDevice(const char* micId)
+{
+    if (micId == NULL)
+        return;
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    m_impl->micDevice = micId;
+}
+
+TXString TRTCCloud::getCurrentMicDevice()
+{
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    return m_impl->micDevice.c_str();
+}
+
+uint32_t TRTCCloud::getCurrentMicDeviceVolume()
+{
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    return m_impl->micVolume;
+}
+
+void TRTCCloud::setCurrentMicDeviceVolume(uint32_t volume)
+{
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    m_impl->micVolume = volume;
+}
+
+TXStringList TRTCCloud::getSpeakerDevicesList() const
+{
+    TXStringList list;
+    list.push_back(kFakeSpeakerDevice);
+    return list;
+}
+
+void TRTCCloud::setCurrentSpeakerDevice(const char* speakerId)
+{
+    if (speakerId == NULL)
+        return;
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    m_impl->speakerDevice = speakerId;
+}
+
+TXString TRTCCloud::getCurrentSpeakerDevice()
+{
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    return m_impl->speakerDevice.c_str();
+}
+
+uint32_t TRTCCloud::getCurrentSpeakerVolume()
+{
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    return m_impl->speakerVolume;
+}
+
+void TRTCCloud::setCurrentSpeakerVolume(uint32_t volume)
+{
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    m_impl->speakerVolume = volume;
+}
+
+void TRTCCloud::setBeautyStyle(TRTCBeautyStyle style, uint32_t beauty, uint32_t white, uint32_t ruddiness)
+{
+
+}
+
+void TRTCCloud::setWaterMark(TRTCVideoStreamType streamType, const char* srcData, TRTCWaterMarkSrcType srcType, uint32_t nWidth, uint32_t nHeight, float xOffset, float yOffset, float fWidthRatio)
+{
+
+}
+
+void TRTCCloud::startRemoteSubStreamView(const char* userId, HWND rendHwnd)
+{
+
+}
+
+void TRTCCloud::stopRemoteSubStreamView(const char* userId)
+{
+
+}
+
+//һģɼԴͼΪɫ
+void TRTCCloud::getScreenCaptureSources(TRTCScreenCaptureSourceInfoList &sourceInfoList, const SIZE &thumbSize, const SIZE &iconSize)
+{
+    sourceInfoList.clear();
+
+    TRTCScreenCaptureSourceInfo info;
+    info.type = TRTCScreenCaptureSourceTypeScreen;
+    info.sourceId = NULL;
+    info.sourceName = "Fake Screen";
+    info.thumbWidth = thumbSize.cx > 0 ? (uint32_t)thumbSize.cx : 0;
+    info.thumbHeight = thumbSize.cy > 0 ? (uint32_t)thumbSize.cy : 0;
+    std::string thumb((size_t)info.thumbWidth * info.thumbHeight * 4, (char)0x80);
+    info.thumbBGRA = TXString(thumb.data(), thumb.size());
+    info.iconWidth = 0;
+    info.iconHeight = 0;
+    sourceInfoList.push_back(info);
+}
+
+void TRTCCloud::selectScreenCaptureTarget(const TRTCScreenCaptureSourceInfo &source, const RECT& captureRect, bool captureMouse, bool highlightWindow)
+{
+
+}
+
+void TRTCCloud::startScreenCapture(HWND rendHwnd)
+{
+
+}
+
+void TRTCCloud::pauseScreenCapture()
+{
+
+}
+
+void TRTCCloud::resumeScreenCapture()
+{
+
+}
+
+void TRTCCloud::stopScreenCapture()
+{
+
+}
+
+void TRTCCloud::setSubStreamEncoderParam(const TRTCVideoEncParam& params)
+{
+
+}
+
+void TRTCCloud::setSubStreamMixVolume(uint32_t volume)
+{
+
+}
+
+int TRTCCloud::setLocalVideoRenderCallback(TRTCVideoPixelFormat pixelFormat, TRTCVideoBufferType bufferType, ITRTCVideoRenderCallback* callback)
+{
+    return m_impl->cloud.setLocalVideoRenderCallback(pixelFormat, bufferType, callback);
+}
+
+int TRTCCloud::setRemoteVideoRenderCallback(const char* userId, TRTCVideoPixelFormat pixelFormat, TRTCVideoBufferType bufferType, ITRTCVideoRenderCallback* callback)
+{
+    return m_impl->cloud.setRemoteVideoRenderCallback(userId, pixelFormat, bufferType, callback);
+}
+
+bool TRTCCloud::sendCustomCmdMsg(uint32_t cmdId, const uint8_t* data, uint32_t dataSize, bool reliable, bool ordered)
+{
+    return true;
+}
+
+void TRTCCloud::playBGM(const char* path)
+{
+
+}
+
+void TRTCCloud::stopBGM()
+{
+
+}
+
+void TRTCCloud::pauseBGM()
+{
+
+}
+
+void TRTCCloud::resumeBGM()
+{
+
+}
+
+uint32_t TRTCCloud::getBGMDuration(const char* path)
+{
+    return 0;
+}
+
+void TRTCCloud::setBGMPosition(uint32_t pos)
+{
+
+}
+
+void TRTCCloud::setMicVolumeOnMixing(uint32_t volume)
+{
+
+}
+
+void TRTCCloud::setBGMVolume(uint32_t volume)
+{
+
+}
+
+void TRTCCloud::startSpeedTest(uint32_t sdkAppId, const char* userId, const char* userSig)
+{
+
+}
+
+void TRTCCloud::stopSpeedTest()
+{
+
+}
+
+void TRTCCloud::startCameraDeviceTest(HWND rendHwnd)
+{
+
+}
+
+void TRTCCloud::stopCameraDeviceTest()
+{
+
+}
+
+void TRTCCloud::startMicDeviceTest(uint32_t interval)
+{
+
+}
+
+void TRTCCloud::stopMicDeviceTest()
+{
+
+}
+
+void TRTCCloud::startSpeakerDeviceTest(const char* testAudioFilePath)
+{
+
+}
+
+void TRTCCloud::stopSpeakerDeviceTest()
+{
+
+}
+
+void TRTCCloud::startPublishCDNStream(const TRTCPublishCDNParam& param)
+{
+
+}
+
+void TRTCCloud::stopPublishCDNStream()
+{
+
+}
+
+void TRTCCloud::setMixTranscodingConfig(TRTCTranscodingConfig* config)
+{
+
+}
+
+TXString TRTCCloud::getSDKVersion()
+{
+    return "6.0.0-fake";
+}
+
+void TRTCCloud::setLogLevel(TRTCLogLevel level)
+{
+    FakeSDKGlobals& globals = fakeSDKGlobals();
+    std::lock_guard<std::mutex> lock(globals.mutex);
+    globals.logLevel = level;
+}
+
+void TRTCCloud::setConsoleEnabled(bool enabled)
+{
+
+}
+
+void TRTCCloud::setLogCompressEnabled(bool enabled)
+{
+
+}
+
+void TRTCCloud::setLogDirPath(const char* path)
+{
+
+}
+
+void TRTCCloud::setLogCallback(ITRTCLogCallback* callback)
+{
+    FakeSDKGlobals& globals = fakeSDKGlobals();
+    std::lock_guard<std::mutex> lock(globals.mutex);
+    globals.logCallback = callback;
+}
+
+void TRTCCloud::showDebugView(int showType)
+{
+
+}
@@ -0,0 +1,20 @@
+#pragma once
+/*
+* Module:   TRTCFakeSDK
+*
+* Function:  SDK ͷļʵֵ TRTCCloudTXString ȵ࣬ TRTCFakeCloud ΪˣԴ liteav.lib ӣ
+*           û SDK ƵĻ Linux ϵܷ TRTCCloud Ĵ
+*
+*    1. TRTCFakeSDK.cpp  Demo ı룬Ҫģʱ liteav.lib ӣ÷ͷļøġ
+*       Linux  linux/CMakeLists.txt 룬SDK ͷļʱת UTF-8Windows.h ʹ linux/compat µļݲ㡣
+*
+*    2. 䡢ԶûͳơȾصĽӿת TRTCFakeCloud豸ֻõֵ
+*       豸бع̶ģ豸ӿΪʵ֡
+*
+*    3. ½ TRTCCloud ʹ TRTCFakeSDKSetCloudParams õģģķģ¼ȾƵʡ
+*/
+
+#include "TRTCFakeEventDriver.h"
+
+void TRTCFakeSDKSetCloudParams(const TRTCFakeCloudParams& params);
+TRTCFakeCloudParams TRTCFakeSDKGetCloudParams();
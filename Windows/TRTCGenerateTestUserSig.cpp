@@ -0,0 +1,180 @@
+/*
+* Module:   TRTCGenerateTestUserSig
+*
+* Function: ڱذ TLS-Sig v2 㷨ֱӼ UserSigѹߵԻ
+*/
+
+#include "TRTCGenerateTestUserSig.h"
+#include "Base64.h"
+#include "ZlibCodec.h"
+#include "Base.h"
+#include "Benchmark.h"
+#include <time.h>
+
+//Json ַת壬userId һ㲻Ҫתַ
+static void appendJsonString(std::string& out, const std::string& str)
+{
+    static const char kHex[] = "0123456789abcdef";
+
+    out.push_back('"');
+    for (size_t i = 0; i < str.size(); ++i)
+    {
+        unsigned char c = (unsigned char)str[i];
+        if (c == '"' || c == '\\')
+        {
+            out.push_back('\\');
+            out.push_back((char)c);
+        }
+        else if (c < 0x20)
+        {
+            out.append("\\u00");
+            out.push_back(kHex[c >> 4]);
+            out.push_back(kHex[c & 0x0F]);
+        }
+        else
+        {
+            out.push_back((char)c);
+        }
+    }
+    out.push_back('"');
+}
+
+TRTCGenerateTestUserSig::TRTCGenerateTestUserSig(uint32_t sdkAppId, const std::string& secretKey)
+    : m_sdkAppId(sdkAppId)
+    , m_hmac(secretKey.data(), secretKey.size())
+{
+
+}
+
+TRTCGenerateTestUserSig::~TRTCGenerateTestUserSig()
+{
+
+}
+
+uint32_t TRTCGenerateTestUserSig::getSdkAppId() const
+{
+    return m_sdkAppId;
+}
+
+std::string TRTCGenerateTestUserSig::genUserSig(const std::string& userId, int64_t expireSeconds) const
+{
+    std::string scratch;
+    std::string userSig;
+    genUserSigAt(userId, (int64_t)::time(NULL), expireSeconds, scratch, userSig);
+    return userSig;
+}
+
+std::vector<std::string> TRTCGenerateTestUserSig::genUserSigBatch(const std::vector<std::string>& userIds, int64_t expireSeconds) const
+{
+    std::vector<std::string> userSigs(userIds.size());
+    if (!userIds.empty())
+        genUserSigBatch(&userIds[0], userIds.size(), expireSeconds, &userSigs[0]);
+    return userSigs;
+}
+
+void TRTCGenerateTestUserSig::genUserSigBatch(const std::string* userIds, size_t count, int64_t expireSeconds, std::string* userSigs) const
+{
+    int64_t issueTime = (int64_t)::time(NULL);
+    std::string scratch;
+    for (size_t i = 0; i < count; ++i)
+        genUserSigAt(userIds[i], issueTime, expireSeconds, scratch, userSigs[i]);
+}
+
+void TRTCGenerateTestUserSig::genUserSigAt(const std::string& userId, int64_t issueTime, int64_t expireSeconds, std::string& scratch, std::string& userSig) const
+{
+    std::string strAppId = std::to_string(m_sdkAppId);
+    std::string strTime = std::to_string(issueTime);
+    std::string strExpire = std::to_string(expireSeconds);
+
+    //ǩݣֶ˳͸ʽ TLS-Sig v2 涨
+    scratch.clear();
+    scratch.append("TLS.identifier:").append(userId).append("\n");
+    scratch.append("TLS.sdkappid:").append(strAppId).append("\n");
+    scratch.append("TLS.time:").append(strTime).append("\n");
+    scratch.append("TLS.expire:").append(strExpire).append("\n");
+
+    uint8_t mac[SHA256_DIGEST_SIZE];
+    m_hmac.Sign(scratch.data(), scratch.size(), mac);
+    std::string sig = Base64Encode(mac, sizeof(mac));
+
+    scratch.clear();
+    scratch.append("{\"TLS.ver\":\"2.0\",\"TLS.identifier\":");
+    appendJsonString(scratch, userId);
+    scratch.append(",\"TLS.sdkappid\":").append(strAppId);
+    scratch.append(",\"TLS.expire\":").append(strExpire);
+    scratch.append(",\"TLS.time\":").append(strTime);
+    scratch.append(",\"TLS.sig\":\"").append(sig).append("\"}");
+
+    std::string compressed;
+    ZlibCompress(scratch.data(), scratch.size(), compressed);
+
+    userSig = Base64Encode(compressed.data(), compressed.size());
+    for (size_t i = 0; i < userSig.size(); ++i)
+    {
+        if (userSig[i] == '+')
+            userSig[i] = '*';
+        else if (userSig[i] == '/')
+            userSig[i] = '-';
+        else if (userSig[i] == '=')
+            userSig[i] = '_';
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////Benchmark
+//ѹõĹ̶Կ sdkAppIdֻʱɵ UserSig ڽ
+static const uint32_t kBenchSdkAppId = 1400000000;
+static const char kBenchSecretKey[] = "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef";
+
+std::vector<TRTCUserSigBenchResult> TRTCGenerateTestUserSig::runBenchmark(uint32_t durationMs)
+{
+    static const uint32_t kBatchSizes[] = { 1, 16, 256, 4096 };
+    const std::string secretKey(kBenchSecretKey);
+
+    std::vector<TRTCUserSigBenchResult> results;
+    for (size_t i = 0; i < _countof(kBatchSizes); ++i)
+    {
+        uint32_t batchSize = kBatchSizes[i];
+        std::vector<std::string> userIds(batchSize);
+        for (uint32_t j = 0; j < batchSize; ++j)
+            userIds[j] = "loadtest_user_" + std::to_string(j);
+        std::vector<std::string> userSigs(batchSize);
+
+        TRTCUserSigBenchResult result;
+        result.batchSize = batchSize;
+        result.newSignerSigsPerSec = PerSecond(batchSize, MeasureAverageMs(durationMs, [&]() {
+            for (uint32_t j = 0; j < batchSize; ++j)
+                userSigs[j] = TRTCGenerateTestUserSig(kBenchSdkAppId, secretKey).genUserSig(userIds[j]);
+        }));
+
+        TRTCGenerateTestUserSig signer(kBenchSdkAppId, secretKey);
+        result.reuseSignerSigsPerSec = PerSecond(batchSize, MeasureAverageMs(durationMs, [&]() {
+            for (uint32_t j = 0; j < batchSize; ++j)
+                userSigs[j] = signer.genUserSig(userIds[j]);
+        }));
+        result.batchSigsPerSec = PerSecond(batchSize, MeasureAverageMs(durationMs, [&]() {
+            signer.genUserSigBatch(&userIds[0], batchSize, kDefaultExpireSeconds, &userSigs[0]);
+        }));
+
+        size_t totalBytes = 0;
+        for (uint32_t j = 0; j < batchSize; ++j)
+            totalBytes += userSigs[j].size();
+        result.avgSigBytes = (uint32_t)(totalBytes / batchSize);
+        results.push_back(result);
+    }
+    return results;
+}
+
+std::string TRTCGenerateTestUserSig::formatBenchmark(const std::vector<TRTCUserSigBenchResult>& results)
+{
+    std::string report;
+    format_to(report, "%6s %16s %18s %12s %8s %10s\r\n",
+        "batch", "new signer sig/s", "reuse signer sig/s", "batch sig/s", "speedup", "sig bytes");
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const TRTCUserSigBenchResult& r = results[i];
+        format_to(report, "%6u %16.0f %18.0f %12.0f %8.2f %10u\r\n",
+            r.batchSize, r.newSignerSigsPerSec, r.reuseSignerSigsPerSec, r.batchSigsPerSec,
+            r.newSignerSigsPerSec > 0 ? r.batchSigsPerSec / r.newSignerSigsPerSec : 0.0, r.avgSigBytes);
+    }
+    return report;
+}
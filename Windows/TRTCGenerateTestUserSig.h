@@ -0,0 +1,64 @@
+#pragma once
+/*
+* Module:   TRTCGenerateTestUserSig
+*
+* Function: ڱذ TLS-Sig v2 㷨ֱӼ UserSigѹߵԻ
+*
+* Notice:
+*
+*  1 UserSig Ҫ SDKAppID ӦԿSecretKeyԿһдͻ˾ͺױȡ
+*       õԿ˿ð TRTC ˱ģֻڱͨ demoѹ͹ܵԣ
+*       Ʒ߷ʱҪʹ÷ȡ TRTCGetUserIDAndUserSig::getUserSigFromServer
+*
+*  2ǩΪ HMAC-SHA256(SecretKey, identifier/sdkappid/time/expire)ͬЩֶ Json
+*       پ zlib ѹ base64'+''/''=' 滻Ϊ '*''-''_'õյ UserSig
+*
+*  3ӿڹǩʱ HMAC ԿԤѹʱһɳǧ UserSig
+*
+*  4runBenchmark Աÿ UserSig ¹ǩǩɺӿַʽ
+*
+*  οĵhttps://cloud.tencent.com/document/product/647/17275
+*/
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "Sha256.h"
+
+//һСɷʽ/룩
+struct TRTCUserSigBenchResult
+{
+    uint32_t batchSize = 0;
+    double newSignerSigsPerSec = 0;     //ÿ UserSig ¹ TRTCGenerateTestUserSigԤԿ
+    double reuseSignerSigsPerSec = 0;   //ͬһ genUserSig
+    double batchSigsPerSec = 0;         //genUserSigBatch
+    uint32_t avgSigBytes = 0;
+};
+
+class TRTCGenerateTestUserSig
+{
+public:
+    //ĬЧ 7 
+    static const int64_t kDefaultExpireSeconds = 7 * 24 * 3600;
+
+    TRTCGenerateTestUserSig(uint32_t sdkAppId, const std::string& secretKey);
+    ~TRTCGenerateTestUserSig();
+
+    uint32_t getSdkAppId() const;
+
+    std::string genUserSig(const std::string& userId, int64_t expireSeconds = kDefaultExpireSeconds) const;
+
+    //ɣ UserSig ʹͬһǩʱ
+    std::vector<std::string> genUserSigBatch(const std::vector<std::string>& userIds, int64_t expireSeconds = kDefaultExpireSeconds) const;
+    void genUserSigBatch(const std::string* userIds, size_t count, int64_t expireSeconds, std::string* userSigs) const;
+
+    //Сԣÿַʽ durationMs 
+    static std::vector<TRTCUserSigBenchResult> runBenchmark(uint32_t durationMs = 100);
+    static std::string formatBenchmark(const std::vector<TRTCUserSigBenchResult>& results);
+private:
+    //scratch Ϊ÷õʱʱⷴڴ
+    void genUserSigAt(const std::string& userId, int64_t issueTime, int64_t expireSeconds, std::string& scratch, std::string& userSig) const;
+private:
+    uint32_t m_sdkAppId;
+    CHmacSha256 m_hmac;
+};
@@ -5,13 +5,17 @@
 */
 
 #include "TRTCGetUserIDAndUserSig.h"
+#include "TRTCUserSigCache.h"
+#include "TRTCGenerateTestUserSig.h"
+#include "TRTCCredentialStore.h"
+#include <memory>
+#include <atomic>
 #include "json.h"
 #include <stdio.h>
 
 
 TRTCGetUserIDAndUserSig::TRTCGetUserIDAndUserSig()
-    : m_sdkAppId(0)
-    , m_userInfos()
+    : m_userTable(std::make_shared<UserInfoTable>())
     , m_http_client(L"User-Agent")
 {
 
@@ -30,54 +34,37 @@ TRTCGetUserIDAndUserSig& TRTCGetUserIDAndUserSig::instance()
 
 bool TRTCGetUserIDAndUserSig::loadFromConfig()
 {
-    FILE* file = NULL;
-    fopen_s(&file, "Config.json", "rb");
-    if (!file)
+    //ļûб仯ʱֱõϴεĽظ
+    std::shared_ptr<const UserInfoTable> table = TRTCConfigLoader::instance().load(L"Config.json");
+    if (!table)
     {
         return false;
     }
-
-    std::string data;
-    while (true)
+    if (table == getConfigUserTable())
     {
-        char buffer[512] = { 0 };
-        size_t count = ::fread(buffer, 1, 512, file);
-        if (count == 0)
-        {
-            break;
-        }
-
-        data.append(buffer, count);
+        return true;
     }
 
-    Json::Reader reader;
-    Json::Value root;
-    if (!reader.parse(data, root))
-    {
-        return false;
-    }
+    std::atomic_store(&m_userTable, table);
+    //ϲ˺ſ⣬ԴѾͬһ sdkAppId ˺
+    TRTCCredentialStore::instance().mergeTable(*table);
 
-    if (!root.isMember("sdkappid") || !root.isMember("users"))
+    //ļе UserSig 󶨷䣬水ʱ
+    for (size_t i = 0; i < table->userInfos.size(); ++i)
     {
-        return false;
+        const UserInfo& info = table->userInfos[i];
+        TRTCUserSigCache::instance().putUserSig(table->sdkAppId, info.userId, 0, info.userSig);
     }
 
-    m_sdkAppId = root["sdkappid"].asUInt();
-
-    Json::Value users = root["users"];
-    for (size_t i = 0; i < users.size(); ++i)
+    //ļд secretkey ʱ޵Ժѹ⻷UserSig ǰ˺ſжӦӦõԿڱ¼
+    if (!table->secretKey.empty())
     {
-        Json::Value item = users[i];
-        if (!item.isMember("userId") || !item.isMember("userToken"))
-        {
-            return false;
-        }
-
-        UserInfo info;
-        info.userId = item["userId"].asString();
-        info.userSig = item["userToken"].asString();
-
-        m_userInfos.push_back(info);
+        TRTCUserSigCache::instance().setFetcher([](uint32_t sdkAppId, const std::string& userId, uint32_t roomId) {
+            std::shared_ptr<const TRTCCredentialStore::AppCredentials> app = TRTCCredentialStore::instance().getApp(sdkAppId);
+            if (!app || app->secretKey.empty())
+                return std::string();
+            return TRTCGenerateTestUserSig(sdkAppId, app->secretKey).genUserSig(userId);
+        });
     }
 
     return true;
@@ -86,12 +73,12 @@ bool TRTCGetUserIDAndUserSig::loadFromConfig()
 
 uint32_t TRTCGetUserIDAndUserSig::getConfigSdkAppId() const
 {
-    return m_sdkAppId;
+    return getConfigUserTable()->sdkAppId;
 }
 
-std::vector<UserInfo> TRTCGetUserIDAndUserSig::getConfigUserIdArray() const
+std::shared_ptr<const UserInfoTable> TRTCGetUserIDAndUserSig::getConfigUserTable() const
 {
-    return m_userInfos;
+    return std::atomic_load(&m_userTable);
 }
 
 std::string TRTCGetUserIDAndUserSig::getUserSigFromServer(std::string userId, std::string pwd, int roomId, int sdkAppId)
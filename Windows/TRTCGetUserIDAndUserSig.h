@@ -7,13 +7,10 @@
 
 #include <string>
 #include <vector>
+#include <memory>
 #include <stdint.h>
 #include "HttpClient.h"
-struct UserInfo
-{
-    std::string userId;
-    std::string userSig;
-};
+#include "TRTCConfigLoader.h"
 
 class TRTCGetUserIDAndUserSig
 {
@@ -29,6 +26,7 @@ public:
     * ӱصĲļжȡһuserid  usersig
     * ļͨѶTRTC̨https://console.cloud.tencent.com/ravеġ֡ҳȡ
     * ļе userid  usersig ѶԤȼɵģÿһ usersig ЧΪ 180
+    * ļлд secretkeyusersig ǰͨ TRTCGenerateTestUserSig ڱ¼
     *
     * ÷ʺϱͨdemo͹ܵԣƷ߷Ҫʹ÷ȡ getUserSigFromServer
     *
@@ -37,7 +35,9 @@ public:
     */
     bool loadFromConfig();
     uint32_t getConfigSdkAppId() const;
-    std::vector<UserInfo> getConfigUserIdArray() const;
+
+    //ȡǰûĿգûݣ¼ʱ滻űȡõĿղӰ
+    std::shared_ptr<const UserInfoTable> getConfigUserTable() const;
 
     /**
     * ͨ http 󵽿ͻҵϻȡ userid  usersig
@@ -48,8 +48,7 @@ public:
     //ʾο
     std::string getUserSigFromServer(std::string userId, std::string pwd, int roomId, int sdkAppId);
 private:
-    uint32_t m_sdkAppId;
-    std::vector<UserInfo> m_userInfos;
+    std::shared_ptr<const UserInfoTable> m_userTable;
 private:
     HttpClient m_http_client;
 };
@@ -0,0 +1,430 @@
+/*
+* Module:   TRTCLoadGenerator
+*
+* Function: ѹ⣬ͬʱ· TRTCParams Ựͳƽʱӡصºÿ·ڴ
+*/
+
+#include "TRTCLoadGenerator.h"
+#include "TRTCUserSigCache.h"
+#include "StorageConfigMgr.h"
+#include "Base.h"
+
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <psapi.h>
+#else
+#include <stdio.h>
+#include <unistd.h>
+#endif
+
+typedef std::chrono::steady_clock LoadClock;
+
+// TRTCMainViewController Զ˻洰һ
+static const int kMaxRemoteViews = 3;
+
+//һѹлỰļ
+struct LoadRunState
+{
+    std::mutex mutex;
+    std::condition_variable cond;
+    uint32_t enteredCount = 0;
+    uint32_t failedCount = 0;
+    uint32_t exitedCount = 0;
+    std::vector<uint64_t> enterElapsed;
+    std::atomic<uint64_t> callbackCount;
+
+    LoadRunState() : callbackCount(0) {}
+};
+
+//һ·ѹỰص TRTCMainViewController ֻͬǲ
+class LoadSession : public ITRTCCloudCallback
+{
+public:
+    enum Status
+    {
+        StatusIdle,
+        StatusEntering,
+        StatusInRoom,
+        StatusFailed,
+        StatusTimeout,      //ʱδѼʧܣ˷ȡ
+        StatusExiting,
+        StatusExited,
+    };
+
+    LoadSession(std::unique_ptr<ITRTCCloudBackend> cloud, LoadRunState& state)
+        : m_cloud(std::move(cloud))
+        , m_state(state)
+    {
+        m_cloud->addCallback(this);
+    }
+
+    virtual ~LoadSession()
+    {
+        m_cloud->removeCallback(this);
+        m_cloud.reset();
+    }
+
+    void enterRoom(const TRTCParams& params, const TRTCStorageConfig& config)
+    {
+        m_cloud->setVideoEncoderParam(config.videoEncParams);
+        m_cloud->setNetworkQosParam(config.qosParams);
+        if (config.bPushSmallVideo)
+        {
+            TRTCVideoEncParam param;
+            param.videoFps = 15;
+            param.videoBitrate = 100;
+            param.videoResolution = TRTCVideoResolution_320_240;
+            m_cloud->enableSmallVideoStream(true, param);
+        }
+        if (config.bPlaySmallVideo)
+        {
+            m_cloud->setPriorRemoteVideoStreamType(TRTCVideoStreamTypeSmall);
+        }
+
+        setStatus(StatusEntering);
+        m_cloud->enterRoom(params, TRTCAppSceneVideoCall);
+    }
+
+    //ûõ UserSig ԭ޷
+    void markFailed()
+    {
+        std::lock_guard<std::mutex> lock(m_state.mutex);
+        m_status = StatusFailed;
+        ++m_state.failedCount;
+        m_state.cond.notify_all();
+    }
+
+    //ʱδĻỰΪʧ
+    void markTimeout()
+    {
+        std::lock_guard<std::mutex> lock(m_state.mutex);
+        if (m_status == StatusEntering)
+        {
+            m_status = StatusTimeout;
+            ++m_state.failedCount;
+        }
+    }
+
+    //˷ǷҪȴ onExitRoom
+    bool exitRoom()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_state.mutex);
+            if (m_status != StatusEntering && m_status != StatusInRoom && m_status != StatusTimeout)
+                return false;
+            m_status = StatusExiting;
+        }
+        m_cloud->exitRoom();
+        return true;
+    }
+protected:
+    virtual void onError(TXLiteAVError errCode, const char* errMsg, void* arg)
+    {
+        ++m_state.callbackCount;
+        std::lock_guard<std::mutex> lock(m_state.mutex);
+        if (m_status == StatusEntering)
+        {
+            m_status = StatusFailed;
+            ++m_state.failedCount;
+            m_state.cond.notify_all();
+        }
+    }
+
+    virtual void onWarning(TXLiteAVWarning warningCode, const char* warningMsg, void* arg)
+    {
+        ++m_state.callbackCount;
+    }
+
+    virtual void onEnterRoom(uint64_t elapsed)
+    {
+        ++m_state.callbackCount;
+        {
+            std::lock_guard<std::mutex> lock(m_state.mutex);
+            if (m_status != StatusEntering)
+                return;
+            m_status = StatusInRoom;
+            ++m_state.enteredCount;
+            m_state.enterElapsed.push_back(elapsed);
+            m_state.cond.notify_all();
+        }
+
+        m_cloud->setLocalViewFillMode(TRTCVideoFillMode_Fit);
+        m_cloud->startLocalPreview(NULL);
+        m_cloud->startLocalAudio();
+    }
+
+    virtual void onExitRoom(int reason)
+    {
+        ++m_state.callbackCount;
+        m_cloud->removeCallback(this);
+        m_cloud->stopLocalPreview();
+        m_cloud->stopAllRemoteView();
+        for (int i = 0; i < kMaxRemoteViews; ++i)
+            m_remoteViews[i].clear();
+
+        std::lock_guard<std::mutex> lock(m_state.mutex);
+        if (m_status == StatusExiting)
+        {
+            m_status = StatusExited;
+            ++m_state.exitedCount;
+            m_state.cond.notify_all();
+        }
+    }
+
+    virtual void onUserEnter(const char* userId)
+    {
+        ++m_state.callbackCount;
+        for (int i = 0; i < kMaxRemoteViews; ++i)
+        {
+            if (m_remoteViews[i].empty())
+            {
+                m_remoteViews[i] = userId;
+                m_cloud->setRemoteViewFillMode(userId, TRTCVideoFillMode_Fit);
+                m_cloud->startRemoteView(userId, NULL);
+                break;
+            }
+        }
+    }
+
+    virtual void onUserExit(const char* userId, int reason)
+    {
+        ++m_state.callbackCount;
+        for (int i = 0; i < kMaxRemoteViews; ++i)
+        {
+            if (m_remoteViews[i] == userId)
+            {
+                m_cloud->stopRemoteView(userId);
+                m_remoteViews[i].clear();
+                break;
+            }
+        }
+    }
+
+    virtual void onUserVideoAvailable(const char* userId, bool available) { ++m_state.callbackCount; }
+    virtual void onUserSubStreamAvailable(const char* userId, bool available) { ++m_state.callbackCount; }
+    virtual void onUserAudioAvailable(const char* userId, bool available) { ++m_state.callbackCount; }
+    virtual void onUserVoiceVolume(TRTCVolumeInfo* userVolumes, uint32_t userVolumesCount, uint32_t totalVolume) { ++m_state.callbackCount; }
+    virtual void onNetworkQuality(TRTCQualityInfo localQuality, TRTCQualityInfo* remoteQuality, uint32_t remoteQualityCount) { ++m_state.callbackCount; }
+    virtual void onStatistics(const TRTCStatistics& statis) { ++m_state.callbackCount; }
+    virtual void onFirstVideoFrame(const char* userId, uint32_t width, uint32_t height) { ++m_state.callbackCount; }
+    virtual void onFirstAudioFrame(const char* userId) { ++m_state.callbackCount; }
+    virtual void onConnectionLost() { ++m_state.callbackCount; }
+    virtual void onTryToReconnect() { ++m_state.callbackCount; }
+    virtual void onConnectionRecovery() { ++m_state.callbackCount; }
+private:
+    void setStatus(Status status)
+    {
+        std::lock_guard<std::mutex> lock(m_state.mutex);
+        m_status = status;
+    }
+private:
+    std::unique_ptr<ITRTCCloudBackend> m_cloud;
+    LoadRunState& m_state;
+    Status m_status = StatusIdle;                   // m_state.mutex 
+    std::string m_remoteViews[kMaxRemoteViews];     //ֻڻص̷߳
+};
+
+//˽ڴ棨ֽڣ
+static int64_t processMemoryBytes()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS_EX counters = {};
+    counters.cb = sizeof(counters);
+    if (!::GetProcessMemoryInfo(::GetCurrentProcess(), (PROCESS_MEMORY_COUNTERS*)&counters, sizeof(counters)))
+        return 0;
+    return (int64_t)counters.PrivateUsage;
+#else
+    //ģʵ Linux ʱȡפڴ
+    long pages = 0;
+    long residentPages = 0;
+    FILE* file = fopen("/proc/self/statm", "r");
+    if (file == NULL)
+        return 0;
+    if (fscanf(file, "%ld %ld", &pages, &residentPages) != 2)
+        residentPages = 0;
+    fclose(file);
+    return (int64_t)residentPages * sysconf(_SC_PAGESIZE);
+#endif
+}
+
+static uint64_t percentile(const std::vector<uint64_t>& sorted, uint32_t percent)
+{
+    if (sorted.empty())
+        return 0;
+    return sorted[(sorted.size() - 1) * percent / 100];
+}
+
+static uint64_t elapsedMs(LoadClock::time_point begin, LoadClock::time_point end)
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count();
+}
+
+TRTCLoadGenerator::TRTCLoadGenerator(TRTCCloudBackendFactory factory, const TRTCLoadTestOptions& options)
+    : m_factory(factory)
+    , m_options(options)
+{
+    if (m_options.usersPerRoom == 0)
+        m_options.usersPerRoom = 1;
+}
+
+TRTCLoadGenerator::~TRTCLoadGenerator()
+{
+
+}
+
+std::vector<uint32_t> TRTCLoadGenerator::defaultLevels()
+{
+    std::vector<uint32_t> levels;
+    levels.push_back(1);
+    levels.push_back(10);
+    levels.push_back(100);
+    levels.push_back(1000);
+    return levels;
+}
+
+TRTCLoadTestResult TRTCLoadGenerator::run(uint32_t sessionCount)
+{
+    TRTCLoadTestResult result;
+    result.sessionCount = sessionCount;
+    if (sessionCount == 0 || !m_factory)
+        return result;
+
+    //һȡһÿգѹʹͬһݲ
+    std::shared_ptr<const TRTCStorageConfig> config = m_options.config;
+    if (!config)
+        config = TRTCStorageConfigMgr::GetInstance()->GetConfig();
+    if (!config)
+        config = std::make_shared<TRTCStorageConfig>();
+
+    auto userSigFetcher = m_options.userSigFetcher;
+    if (!userSigFetcher)
+    {
+        userSigFetcher = [](uint32_t sdkAppId, const std::string& userId, uint32_t roomId) {
+            std::string userSig;
+            TRTCUserSigCache::instance().getUserSig(sdkAppId, userId, roomId, userSig);
+            return userSig;
+        };
+    }
+
+    uint32_t runIndex = ++m_runIndex;
+    LoadRunState state;
+    state.enterElapsed.reserve(sessionCount);
+
+    int64_t memoryBefore = processMemoryBytes();
+    std::vector<std::unique_ptr<LoadSession>> sessions(sessionCount);
+    for (uint32_t i = 0; i < sessionCount; ++i)
+        sessions[i].reset(new LoadSession(m_factory(), state));
+
+    //̲߳ÿ̸߳һĻỰ
+    uint32_t threadCount = m_options.enterThreads;
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    threadCount = std::min(threadCount, sessionCount);
+
+    LoadClock::time_point beginTime = LoadClock::now();
+    std::vector<std::thread> enterThreads;
+    for (uint32_t t = 0; t < threadCount; ++t)
+    {
+        uint32_t first = (uint32_t)((uint64_t)sessionCount * t / threadCount);
+        uint32_t last = (uint32_t)((uint64_t)sessionCount * (t + 1) / threadCount);
+        enterThreads.push_back(std::thread([&, first, last]() {
+            for (uint32_t i = first; i < last; ++i)
+            {
+                std::string userId = format("%s%u_%u", m_options.userIdPrefix.c_str(), runIndex, i);
+                uint32_t roomId = m_options.firstRoomId + i / m_options.usersPerRoom;
+                std::string userSig = userSigFetcher(m_options.sdkAppId, userId, roomId);
+                if (userSig.empty())
+                {
+                    sessions[i]->markFailed();
+                    continue;
+                }
+
+                TRTCParams params;
+                params.sdkAppId = m_options.sdkAppId;
+                params.roomId = roomId;
+                params.userId = userId.c_str();
+                params.userSig = userSig.c_str();
+                sessions[i]->enterRoom(params, *config);
+            }
+        }));
+    }
+    for (size_t t = 0; t < enterThreads.size(); ++t)
+        enterThreads[t].join();
+
+    std::chrono::milliseconds timeout(m_options.enterTimeoutMs);
+    {
+        std::unique_lock<std::mutex> lock(state.mutex);
+        state.cond.wait_for(lock, timeout, [&]() {
+            return state.enteredCount + state.failedCount >= sessionCount;
+        });
+    }
+    LoadClock::time_point enteredTime = LoadClock::now();
+    int64_t memoryInRoom = processMemoryBytes();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(m_options.holdMs));
+
+    uint32_t exitingCount = 0;
+    for (uint32_t i = 0; i < sessionCount; ++i)
+    {
+        sessions[i]->markTimeout();
+        if (sessions[i]->exitRoom())
+            ++exitingCount;
+    }
+    {
+        std::unique_lock<std::mutex> lock(state.mutex);
+        state.cond.wait_for(lock, timeout, [&]() {
+            return state.exitedCount >= exitingCount;
+        });
+    }
+    LoadClock::time_point endTime = LoadClock::now();
+    sessions.clear();
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+    std::vector<uint64_t>& elapsed = state.enterElapsed;
+    std::sort(elapsed.begin(), elapsed.end());
+    result.enteredCount = state.enteredCount;
+    result.failedCount = state.failedCount;
+    result.enterElapsedP50 = percentile(elapsed, 50);
+    result.enterElapsedP90 = percentile(elapsed, 90);
+    result.enterElapsedP99 = percentile(elapsed, 99);
+    result.enterElapsedMax = elapsed.empty() ? 0 : elapsed.back();
+    result.enterAllWallMs = elapsedMs(beginTime, enteredTime);
+    result.callbackCount = state.callbackCount;
+    result.durationMs = elapsedMs(beginTime, endTime);
+    result.callbacksPerSecond = result.durationMs > 0 ? result.callbackCount * 1000.0 / result.durationMs : 0;
+    result.memoryPerSession = (memoryInRoom - memoryBefore) / (int64_t)sessionCount;
+    return result;
+}
+
+std::vector<TRTCLoadTestResult> TRTCLoadGenerator::runLevels(const std::vector<uint32_t>& sessionCounts)
+{
+    std::vector<TRTCLoadTestResult> results;
+    for (size_t i = 0; i < sessionCounts.size(); ++i)
+        results.push_back(run(sessionCounts[i]));
+    return results;
+}
+
+std::string TRTCLoadGenerator::formatReport(const std::vector<TRTCLoadTestResult>& results)
+{
+    std::string report;
+    format_to(report, "%8s %8s %8s %8s %8s %8s %8s %10s %10s %12s %12s\r\n",
+        "sessions", "entered", "failed", "p50(ms)", "p90(ms)", "p99(ms)", "max(ms)",
+        "all(ms)", "callbacks", "callbacks/s", "KB/session");
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const TRTCLoadTestResult& r = results[i];
+        format_to(report, "%8u %8u %8u %8llu %8llu %8llu %8llu %10llu %10llu %12.1f %12.1f\r\n",
+            r.sessionCount, r.enteredCount, r.failedCount,
+            (unsigned long long)r.enterElapsedP50, (unsigned long long)r.enterElapsedP90,
+            (unsigned long long)r.enterElapsedP99, (unsigned long long)r.enterElapsedMax,
+            (unsigned long long)r.enterAllWallMs, (unsigned long long)r.callbackCount,
+            r.callbacksPerSecond, r.memoryPerSession / 1024.0);
+    }
+    return report;
+}
@@ -0,0 +1,85 @@
+#pragma once
+/*
+* Module:   TRTCLoadGenerator
+*
+* Function: ѹ⣬ͬʱ· TRTCParams Ựͳƽʱӡصºÿ·ڴ
+*
+*    1. ÿһ·Ự TRTCMainViewController ̵ýӿڣǰñزonEnterRoom 򿪱ԤƵ
+*       onUserEnter ʱԶ˻棨 3 ·Զ˴һ£onUserExit ʱֹͣonExitRoom Ƴص
+*
+*    2. ͨ TRTCCloudBackendFactory ÿ·Ựʹõʵʵ SDKҲ TRTCFakeCloud ģ⡣
+*
+*    3. ɶ̲߳ڴ水ȫỰ˽ڴѹ⿪ʼǰƽÿһ·
+*/
+
+#include "TRTCCloudBackend.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <stdint.h>
+
+struct TRTCStorageConfig;
+
+struct TRTCLoadTestOptions
+{
+    uint32_t sdkAppId = 0;
+    uint32_t firstRoomId = 10000;           //Ựη䵽 firstRoomId ʼķ
+    uint32_t usersPerRoom = 4;              //ÿĻỰ
+    std::string userIdPrefix = "load_";     //userId Ϊǰ׺ִκͻỰ
+    uint32_t enterThreads = 0;              //߳0 ʾ CPU 
+    uint32_t enterTimeoutMs = 30000;        //ȴȫ˷ĳʱ
+    uint32_t holdMs = 5000;                 //ȫڷͣʱڼͳƻص
+
+    //ʹõıزΪʱȡ TRTCStorageConfigMgr ĵǰ
+    std::shared_ptr<const TRTCStorageConfig> config;
+
+    //ȡ UserSigؿմʾûỰ޷Ϊʱ TRTCUserSigCache ȡ
+    std::function<std::string(uint32_t sdkAppId, const std::string& userId, uint32_t roomId)> userSigFetcher;
+};
+
+struct TRTCLoadTestResult
+{
+    uint32_t sessionCount = 0;
+    uint32_t enteredCount = 0;              //յ onEnterRoom ĻỰ
+    uint32_t failedCount = 0;               //û UserSigյ onError ʱĻỰ
+
+    //onEnterRoom ص elapsed룩
+    uint64_t enterElapsedP50 = 0;
+    uint64_t enterElapsedP90 = 0;
+    uint64_t enterElapsedP99 = 0;
+    uint64_t enterElapsedMax = 0;
+    //ӷ enterRoom ȫỰɵǽʱ䣨룩
+    uint64_t enterAllWallMs = 0;
+
+    uint64_t callbackCount = 0;             //ӷȫ˷ڼյĻص
+    double callbacksPerSecond = 0;
+    uint64_t durationMs = 0;
+
+    int64_t memoryPerSession = 0;           //ֽڣΪϵͳڴΪ
+};
+
+class TRTCLoadGenerator
+{
+public:
+    TRTCLoadGenerator(TRTCCloudBackendFactory factory, const TRTCLoadTestOptions& options);
+    ~TRTCLoadGenerator();
+
+    //ͬʱ sessionCount ·Ựȫͣ holdMsȫ˷
+    TRTCLoadTestResult run(uint32_t sessionCount);
+
+    // 1101001000 ·
+    std::vector<TRTCLoadTestResult> runLevels(const std::vector<uint32_t>& sessionCounts = defaultLevels());
+    static std::vector<uint32_t> defaultLevels();
+
+    //ı棬ÿѹ⼶һ
+    static std::string formatReport(const std::vector<TRTCLoadTestResult>& results);
+private:
+    TRTCLoadGenerator(const TRTCLoadGenerator&);
+    TRTCLoadGenerator& operator =(const TRTCLoadGenerator&);
+private:
+    TRTCCloudBackendFactory m_factory;
+    TRTCLoadTestOptions m_options;
+    uint32_t m_runIndex = 0;                //ÿʹòͬ userIdһδȫ˳ĻỰ
+};
@@ -17,6 +17,7 @@
 #include "StorageConfigMgr.h"
 #include "TRTCLoginViewController.h"
 #include "TRTCGetUserIDAndUserSig.h"
+#include "TRTCUserSigCache.h"
 #include "TRTCMainViewController.h"
 #include "Base.h"
 // TRTCLoginViewController Ի
@@ -38,6 +39,7 @@ BOOL TRTCLoginViewController::OnInitDialog()
 {
     CDialogEx::OnInitDialog();
     TRTCStorageConfigMgr::GetInstance()->ReadStorageConfig();
+    TRTCStorageConfigMgr::GetInstance()->StartWatchConfigFile();
     newFont.CreatePointFont(120, L"΢ź");
     m_userIdCombo.SetFont(&newFont);
     // ô˶Իͼꡣ  ӦóڲǶԻʱܽԶ
@@ -70,15 +72,15 @@ BOOL TRTCLoginViewController::OnInitDialog()
     pStaticUser->SetWindowTextW(L"û");
     pStaticUser->SetFont(&newFont);
 
-    std::vector<UserInfo> userInfos = TRTCGetUserIDAndUserSig::instance().getConfigUserIdArray();
+    std::shared_ptr<const UserInfoTable> userTable = TRTCGetUserIDAndUserSig::instance().getConfigUserTable();
+    const std::vector<UserInfo>& userInfos = userTable->userInfos;
     if (userInfos.empty())
         return FALSE;
 
     int userCnt = userInfos.size();
     for (int i = 0; i < userCnt; i++)
     {
-        UserInfo info = userInfos[i];
-        m_userIdCombo.AddString(UTF82Wide(info.userId).c_str());
+        m_userIdCombo.AddString(UTF82Wide(userInfos[i].userId).c_str());
     }
     m_userIdCombo.SetCurSel(0);
 
@@ -141,23 +143,41 @@ void TRTCLoginViewController::joinRoom(int roomId)
     }
 
     // ӿ̨ȡ json ļУ򵥻ȡѾǰõ userid  usersig
-    std::vector<UserInfo> userInfos = TRTCGetUserIDAndUserSig::instance().getConfigUserIdArray();
-    if (userInfos.empty())
+    std::shared_ptr<const UserInfoTable> userTable = TRTCGetUserIDAndUserSig::instance().getConfigUserTable();
+    if (userTable->userInfos.empty())
     {   
         //Ҳͨ http Эһ̨ȡ userid Ӧ usersig
         //ʾTRTCGetUserIDAndUserSig::instance().getUserSigFromServer();
         return;
     }
+    // ѡе userId ң¼غ˳仯Ҳѡû
+    CString selUserId;
     int selIndex = m_userIdCombo.GetCurSel();
-    if (selIndex >= 0 && selIndex < userInfos.size())
+    if (selIndex >= 0)
+        m_userIdCombo.GetLBText(selIndex, selUserId);
+    const UserInfo* pInfo = userTable->findUser(Wide2UTF8(selUserId.GetString()));
+    if (pInfo != nullptr)
     {
-        UserInfo info = userInfos[selIndex];   // ¼һû
+        const UserInfo& info = *pInfo;
+        uint32_t sdkAppId = userTable->sdkAppId;
+
+        // usersig ӻлȡڹǰͨ fetcher ں̨߳ǰˢ£磺
+        // TRTCUserSigCache::instance().setFetcher([](uint32_t sdkAppId, const std::string& userId, uint32_t roomId) {
+        //     return TRTCGetUserIDAndUserSig::instance().getUserSigFromServer(userId, pwd, roomId, sdkAppId);
+        // });
+        // ǽֻ̣߳治ȴ fetcherûʱ̨̻߳ȥȡԺٵ
+        std::string userSig;
+        if (!TRTCUserSigCache::instance().getCachedUserSig(sdkAppId, info.userId, roomId, userSig))
+        {
+            MessageBoxW(L"UserSig ѹڻڻȡԺԻ»ȡConfig.json", L"", MB_OK);
+            return;
+        }
 
         TRTCParams params;
-        params.sdkAppId = TRTCGetUserIDAndUserSig::instance().getConfigSdkAppId();
+        params.sdkAppId = sdkAppId;
         params.roomId = roomId;//std::to_string(roomId).c_str();
         params.userId = info.userId.c_str();
-        params.userSig = info.userSig.c_str();
+        params.userSig = userSig.c_str();
         params.privateMapKey = "";
 
         m_pTRTCMainViewController->enterRoom(params);
@@ -27,6 +27,13 @@
 #define new DEBUG_NEW
 #endif
 
+// WM_CUSTOM_STORAGE_CONFIG_CHANGED  lParamϢͷ
+struct StorageConfigChange
+{
+    TRTCStorageConfig oldConfig;
+    TRTCStorageConfig newConfig;
+};
+
 TRTCCloud* getTRTCCloud()
 {
     if (TRTCMainViewController::g_cloud == nullptr)
@@ -61,6 +68,7 @@ void TRTCMainViewController::DoDataExchange(CDataExchange* pDX)
 BEGIN_MESSAGE_MAP(TRTCMainViewController, CDialogEx)
     ON_WM_CLOSE(OnClose)
     ON_MESSAGE(WM_CUSTOM_CLOSE_SETTINGVIEW, OnMsgSettingViewClose)
+    ON_MESSAGE(WM_CUSTOM_STORAGE_CONFIG_CHANGED, OnMsgStorageConfigChanged)
     ON_BN_CLICKED(IDC_EXIT_ROOM, &TRTCMainViewController::OnBnClickedExitRoom)
     ON_BN_CLICKED(IDC_BTN_SETTING, &TRTCMainViewController::OnBnClickedSetting)
     ON_BN_CLICKED(IDC_BTN_LOG, &TRTCMainViewController::OnBnClickedLog)
@@ -122,17 +130,15 @@ void TRTCMainViewController::onEnterRoom(uint64_t elapsed)
     getTRTCCloud()->startLocalAudio();
 
 
-    std::vector<UserInfo> userInfos = TRTCGetUserIDAndUserSig::instance().getConfigUserIdArray();
-    if (userInfos.empty())
-        return;
-    UserInfo info = userInfos[0];   // ¼һû
     CWnd *pStatic = GetDlgItem(IDC_STATIC_LOCAL_USERID);
-    pStatic->SetWindowTextW(UTF82Wide(info.userId).c_str());
+    pStatic->SetWindowTextW(UTF82Wide(m_localUserId).c_str());
     pStatic->SetFont(&newFont);
 }
 
 void TRTCMainViewController::onExitRoom(int reason)
 {
+    TRTCStorageConfigMgr::GetInstance()->RemoveConfigListener(m_configListenerId);
+    m_configListenerId = 0;
     getTRTCCloud()->removeCallback(this);
     getTRTCCloud()->stopLocalPreview();
     getTRTCCloud()->stopAllRemoteView();
@@ -316,13 +322,15 @@ void TRTCMainViewController::enterRoom(TRTCParams& params)
     // Ƶֱʡ֡ʡʵȵȣЩ TRTCSettingViewController 
     // ע⣨1Ҫʺܵ͵úܸߵķֱʣֽϴ
     // ע⣨2Ҫó25FPSϵ֡ʣΪӰʹ24FPSһƼ15FPSܽʷ
-    TRTCVideoEncParam& encParams = TRTCStorageConfigMgr::GetInstance()->videoEncParams;
-    TRTCNetworkQosParam qosParams = TRTCStorageConfigMgr::GetInstance()->qosParams;
+    // ȡһÿգýͬʱ޸ҲһµĲ
+    std::shared_ptr<const TRTCStorageConfig> config = TRTCStorageConfigMgr::GetInstance()->GetConfig();
+    const TRTCVideoEncParam& encParams = config->videoEncParams;
+    const TRTCNetworkQosParam& qosParams = config->qosParams;
     getTRTCCloud()->setVideoEncoderParam(encParams);
     getTRTCCloud()->setNetworkQosParam(qosParams);
     
-    bool m_bPushSmallVideo = TRTCStorageConfigMgr::GetInstance()->bPushSmallVideo;
-    bool m_bPlaySmallVideo = TRTCStorageConfigMgr::GetInstance()->bPlaySmallVideo;
+    bool m_bPushSmallVideo = config->bPushSmallVideo;
+    bool m_bPlaySmallVideo = config->bPlaySmallVideo;
 
 
     if (m_bPushSmallVideo)
@@ -341,14 +349,65 @@ void TRTCMainViewController::enterRoom(TRTCParams& params)
         getTRTCCloud()->setPriorRemoteVideoStreamType(TRTCVideoStreamTypeSmall);
     }
 
+    m_localUserId = params.userId.c_str();
     getTRTCCloud()->enterRoom(params, TRTCAppSceneVideoCall);
 
+    // ļⲿ޸ĺڽ̰߳ѱ仯ıزøSDK½
+    // ¾ϢһͶݣý汣ҲΪòȽ
+    HWND hWnd = GetSafeHwnd();
+    m_configListenerId = TRTCStorageConfigMgr::GetInstance()->AddConfigListener(
+        [hWnd](const TRTCStorageConfig& oldConfig, const TRTCStorageConfig& newConfig) {
+        StorageConfigChange* change = new StorageConfigChange;
+        change->oldConfig = oldConfig;
+        change->newConfig = newConfig;
+        if (!::PostMessage(hWnd, WM_CUSTOM_STORAGE_CONFIG_CHANGED, 0, (LPARAM)change))
+            delete change;
+    });
+
     std::wstring title = format(L"TRTCDemoID: %d, ûID: %s", params.roomId, Ansi2Wide(params.userId.c_str()).c_str());
 
     SetWindowText(title.c_str());
 
 }
 
+LRESULT TRTCMainViewController::OnMsgStorageConfigChanged(WPARAM wParam, LPARAM lParam)
+{
+    std::unique_ptr<StorageConfigChange> change((StorageConfigChange*)lParam);
+    if (m_configListenerId == 0 || !change)
+        return LRESULT();
+
+    const TRTCStorageConfig& config = change->newConfig;
+    const TRTCStorageConfig& oldConfig = change->oldConfig;
+    const TRTCVideoEncParam& encParams = config.videoEncParams;
+    const TRTCVideoEncParam& oldEncParams = oldConfig.videoEncParams;
+    if (encParams.videoResolution != oldEncParams.videoResolution || encParams.resMode != oldEncParams.resMode ||
+        encParams.videoFps != oldEncParams.videoFps || encParams.videoBitrate != oldEncParams.videoBitrate)
+    {
+        getTRTCCloud()->setVideoEncoderParam(encParams);
+    }
+
+    if (config.qosParams.preference != oldConfig.qosParams.preference ||
+        config.qosParams.controlMode != oldConfig.qosParams.controlMode)
+    {
+        getTRTCCloud()->setNetworkQosParam(config.qosParams);
+    }
+
+    if (config.bPushSmallVideo != oldConfig.bPushSmallVideo)
+    {
+        TRTCVideoEncParam param;
+        param.videoFps = 15;
+        param.videoBitrate = 100;
+        param.videoResolution = TRTCVideoResolution_320_240;
+        getTRTCCloud()->enableSmallVideoStream(config.bPushSmallVideo, param);
+    }
+
+    if (config.bPlaySmallVideo != oldConfig.bPlaySmallVideo)
+    {
+        getTRTCCloud()->setPriorRemoteVideoStreamType(config.bPlaySmallVideo ? TRTCVideoStreamTypeSmall : TRTCVideoStreamTypeBig);
+    }
+    return LRESULT();
+}
+
 void TRTCMainViewController::OnBnClickedExitRoom()
 {
     getTRTCCloud()->exitRoom();
@@ -17,6 +17,9 @@
 #include <string>
 #include <functional>
 #include <map>
+#include <memory>
+
+struct TRTCStorageConfig;
 
 
 TRTCCloud* getTRTCCloud();
@@ -47,8 +50,10 @@ protected:
     CFont newFont;
     HICON m_hIcon;
     int m_roomId = 0;
+    std::string m_localUserId;
     std::map<int, std::string> m_remoteUserInfo;
     TRTCSettingViewController *m_pTRTCSettingViewController = nullptr;
+    int m_configListenerId = 0;
     // ɵϢӳ亯
     int m_showDebugView = 0;
     DECLARE_MESSAGE_MAP()
@@ -68,6 +73,7 @@ public:
     afx_msg void OnClose();
     afx_msg HBRUSH OnCtlColor(CDC* pDC, CWnd* pWnd, UINT nCtlColor);
     afx_msg LRESULT OnMsgSettingViewClose(WPARAM wParam, LPARAM lParam);
+    afx_msg LRESULT OnMsgStorageConfigChanged(WPARAM wParam, LPARAM lParam);
     afx_msg void OnBnClickedExitRoom();
     afx_msg void OnBnClickedSetting();
     afx_msg void OnBnClickedLog();
@@ -0,0 +1,208 @@
+/*
+* Module:   TRTCScreenChangeDetector
+*
+* Function:  16x16 Ƚ֡ BGRA32 棬仯ľκ͡û䡱ı־
+*/
+
+#include "TRTCScreenChangeDetector.h"
+#include "TRTCVideoConvert.h"
+
+#include <algorithm>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define SCREEN_CHANGE_SSE2
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#include <arm_neon.h>
+#define SCREEN_CHANGE_NEON
+#endif
+
+static const int kTileBytes = TRTCScreenChangeDetector::kTileSize * 4;
+
+const int TRTCScreenChangeDetector::kTileSize;
+
+//һ count ֽڵľԲ֮ͣcount  kTileBytes
+static uint32_t rowSad(const uint8_t* a, const uint8_t* b, int count)
+{
+    int x = 0;
+    uint32_t sad = 0;
+#if defined(SCREEN_CHANGE_SSE2)
+    __m128i sum = _mm_setzero_si128();
+    for (; x + 16 <= count; x += 16)
+    {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + x));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + x));
+        sum = _mm_add_epi64(sum, _mm_sad_epu8(va, vb));
+    }
+    sad = (uint32_t)(_mm_cvtsi128_si32(sum) + _mm_cvtsi128_si32(_mm_srli_si128(sum, 8)));
+#elif defined(SCREEN_CHANGE_NEON)
+    //ÿ 16 λۼ kTileBytes / 16 βֵ
+    uint16x8_t sum = vdupq_n_u16(0);
+    for (; x + 16 <= count; x += 16)
+        sum = vpadalq_u8(sum, vabdq_u8(vld1q_u8(a + x), vld1q_u8(b + x)));
+    sad = vaddvq_u32(vpaddlq_u16(sum));
+#endif
+    for (; x < count; ++x)
+        sad += (uint32_t)std::abs((int)a[x] - (int)b[x]);
+    return sad;
+}
+
+TRTCScreenChangeDetector::TRTCScreenChangeDetector(uint32_t sadThreshold, uint32_t maxRectCount)
+    : m_sadThreshold(sadThreshold)
+    , m_maxRectCount(maxRectCount)
+{
+}
+
+TRTCScreenChangeDetector::~TRTCScreenChangeDetector()
+{
+}
+
+void TRTCScreenChangeDetector::reset()
+{
+    m_width = 0;
+    m_height = 0;
+    m_reference.clear();
+}
+
+void TRTCScreenChangeDetector::setSadThreshold(uint32_t sadThreshold)
+{
+    m_sadThreshold = sadThreshold;
+}
+
+uint32_t TRTCScreenChangeDetector::sadThreshold() const
+{
+    return m_sadThreshold;
+}
+
+bool TRTCScreenChangeDetector::detect(const TRTCVideoFrame& frame, TRTCScreenChangeResult& result)
+{
+    if (frame.videoFormat != TRTCVideoPixelFormat_BGRA32 || frame.bufferType != TRTCVideoBufferType_Buffer || frame.data == NULL
+        || frame.length < TRTCVideoConvert::frameLength(frame.videoFormat, frame.width, frame.height))
+        return false;
+    return detect(reinterpret_cast<const uint8_t*>(frame.data), frame.width * 4, frame.width, frame.height, result);
+}
+
+bool TRTCScreenChangeDetector::detect(const uint8_t* bgra, int stride, int width, int height, TRTCScreenChangeResult& result)
+{
+    result.bChanged = false;
+    result.dirtyRects.clear();
+    result.dirtyTileCount = 0;
+    result.tileCount = 0;
+    if (bgra == NULL || width <= 0 || height <= 0 || stride < width * 4)
+        return false;
+
+    int tileColumns = (width + kTileSize - 1) / kTileSize;
+    int tileRows = (height + kTileSize - 1) / kTileSize;
+    int refStride = width * 4;
+    result.tileCount = (uint32_t)(tileColumns * tileRows);
+
+    //һֱ֡ʱ仯֡
+    if (width != m_width || height != m_height || m_reference.empty())
+    {
+        m_width = width;
+        m_height = height;
+        m_reference.resize((size_t)refStride * height);
+        for (int y = 0; y < height; ++y)
+            memcpy(&m_reference[(size_t)y * refStride], bgra + (size_t)y * stride, refStride);
+        m_dirty.assign(result.tileCount, 1);
+        result.bChanged = true;
+        result.dirtyTileCount = result.tileCount;
+        buildRects(result);
+        return true;
+    }
+
+    m_dirty.assign(result.tileCount, 0);
+    for (int ty = 0; ty < tileRows; ++ty)
+    {
+        int y0 = ty * kTileSize;
+        int rows = std::min(kTileSize, height - y0);
+        for (int tx = 0; tx < tileColumns; ++tx)
+        {
+            int x0 = tx * kTileSize;
+            int bytes = std::min(kTileSize, width - x0) * 4;
+            const uint8_t* cur = bgra + (size_t)y0 * stride + x0 * 4;
+            uint8_t* ref = &m_reference[(size_t)y0 * refStride + x0 * 4];
+
+            uint32_t sad = 0;
+            for (int y = 0; y < rows && sad <= m_sadThreshold; ++y)
+                sad += rowSad(cur + (size_t)y * stride, ref + (size_t)y * refStride, bytes);
+            if (sad <= m_sadThreshold)
+                continue;
+
+            //鿽ο֡ûĿ鱣ݣֵı仯ۻһαȽ
+            for (int y = 0; y < rows; ++y)
+                memcpy(ref + (size_t)y * refStride, cur + (size_t)y * stride, bytes);
+            m_dirty[ty * tileColumns + tx] = 1;
+            ++result.dirtyTileCount;
+        }
+    }
+
+    result.bChanged = result.dirtyTileCount > 0;
+    if (result.bChanged)
+        buildRects(result);
+    return true;
+}
+
+void TRTCScreenChangeDetector::buildRects(TRTCScreenChangeResult& result) const
+{
+    int tileColumns = (m_width + kTileSize - 1) / kTileSize;
+    int tileRows = (m_height + kTileSize - 1) / kTileSize;
+
+    //open ¼һнʱľΣ left 
+    std::vector<size_t> open;
+    std::vector<size_t> nextOpen;
+    for (int ty = 0; ty < tileRows; ++ty)
+    {
+        const uint8_t* dirty = &m_dirty[ty * tileColumns];
+        LONG top = ty * kTileSize;
+        LONG bottom = std::min(top + kTileSize, (LONG)m_height);
+        nextOpen.clear();
+        size_t candidate = 0;
+        for (int tx = 0; tx < tileColumns;)
+        {
+            if (!dirty[tx])
+            {
+                ++tx;
+                continue;
+            }
+            int end = tx;
+            while (end < tileColumns && dirty[end])
+                ++end;
+
+            LONG left = tx * kTileSize;
+            LONG right = std::min(end * kTileSize, m_width);
+            while (candidate < open.size() && result.dirtyRects[open[candidate]].left < left)
+                ++candidate;
+            if (candidate < open.size() && result.dirtyRects[open[candidate]].left == left
+                && result.dirtyRects[open[candidate]].right == right)
+            {
+                result.dirtyRects[open[candidate]].bottom = bottom;
+                nextOpen.push_back(open[candidate]);
+            }
+            else
+            {
+                RECT rect = { left, top, right, bottom };
+                result.dirtyRects.push_back(rect);
+                nextOpen.push_back(result.dirtyRects.size() - 1);
+            }
+            tx = end;
+        }
+        open.swap(nextOpen);
+    }
+
+    if (m_maxRectCount > 0 && result.dirtyRects.size() > m_maxRectCount)
+    {
+        RECT bounds = result.dirtyRects[0];
+        for (size_t i = 1; i < result.dirtyRects.size(); ++i)
+        {
+            const RECT& rect = result.dirtyRects[i];
+            bounds.left = std::min(bounds.left, rect.left);
+            bounds.top = std::min(bounds.top, rect.top);
+            bounds.right = std::max(bounds.right, rect.right);
+            bounds.bottom = std::max(bounds.bottom, rect.bottom);
+        }
+        result.dirtyRects.assign(1, bounds);
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+/*
+* Module:   TRTCScreenChangeDetector
+*
+* Function: ĻԶɼ·ϱȽ֡ BGRA32 棬ҳ仯򣬻ûʱ
+*
+*    1. 水 16x16 طֿ飬ÿһ֡ӦֽԲ֮ͣSADֵĿΪ飻
+*       ֵΪ 0 ʱκһֽڲͬ仯ʱһͬоͿԽÿıȽϡSSE2/NEON һαȽһ 64 ֽڡ
+*
+*    2. ͬһڵϲһΣкΧͬĶٺϲһΣʱ˻ΪΧС
+*
+*    3. һݲο֡ÿֻ鿽ο֡˵ֵĻ仯֡ۻһֱ©
+*       һֱ֡ʱ仯 reset ֮֡ġ
+*/
+
+#include "TRTCCloudDef.h"
+
+#include <vector>
+#include <stdint.h>
+
+struct TRTCScreenChangeResult
+{
+    bool bChanged = false;              //false ʾһ֡ͬԲ
+    std::vector<RECT> dirtyRects;       //Ѳüڣص
+    uint32_t dirtyTileCount = 0;
+    uint32_t tileCount = 0;
+};
+
+class TRTCScreenChangeDetector
+{
+public:
+    //sadThreshold һ 16x16 ֽڵľԲ֮͵ֵmaxRectCount Ϊ 0 ʱƾθ
+    explicit TRTCScreenChangeDetector(uint32_t sadThreshold = 0, uint32_t maxRectCount = 32);
+    ~TRTCScreenChangeDetector();
+
+    //frame  BGRA32 ڴ֡
+    bool detect(const TRTCVideoFrame& frame, TRTCScreenChangeResult& result);
+    //stride λΪֽ
+    bool detect(const uint8_t* bgra, int stride, int width, int height, TRTCScreenChangeResult& result);
+
+    //һ֡Ϊ֡仯
+    void reset();
+
+    void setSadThreshold(uint32_t sadThreshold);
+    uint32_t sadThreshold() const;
+
+    static const int kTileSize = 16;
+private:
+    TRTCScreenChangeDetector(const TRTCScreenChangeDetector&);
+    TRTCScreenChangeDetector& operator =(const TRTCScreenChangeDetector&);
+
+    void buildRects(TRTCScreenChangeResult& result) const;
+private:
+    uint32_t m_sadThreshold;
+    uint32_t m_maxRectCount;
+    int m_width = 0;
+    int m_height = 0;
+    std::vector<uint8_t> m_reference;   //һ֡п width * 4
+    std::vector<uint8_t> m_dirty;       //֡ÿǷ仯
+};
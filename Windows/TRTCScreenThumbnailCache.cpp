@@ -0,0 +1,192 @@
+/*
+* Module:   TRTCScreenThumbnailCache
+*
+* Function:  sourceId ĻɼԴͼͼ꣬ݹϣûʱŽ
+*/
+
+#include "TRTCScreenThumbnailCache.h"
+
+#include <algorithm>
+#include <string.h>
+
+static const uint64_t kHashPrime1 = 0x9E3779B185EBCA87ull;
+static const uint64_t kHashPrime2 = 0xC2B2AE3D27D4EB4Full;
+
+static inline uint64_t hashRound(uint64_t acc, uint64_t input)
+{
+    acc += input * kHashPrime2;
+    acc = (acc << 31) | (acc >> 33);
+    return acc * kHashPrime1;
+}
+
+static inline uint64_t loadWord(const char* p)
+{
+    uint64_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+//ԭͼ displaySize ڵȱźĴС 1x1Ŵ
+static void fitSize(uint32_t width, uint32_t height, const SIZE& displaySize, uint32_t& outWidth, uint32_t& outHeight)
+{
+    uint32_t maxWidth = displaySize.cx > 0 ? (uint32_t)displaySize.cx : width;
+    uint32_t maxHeight = displaySize.cy > 0 ? (uint32_t)displaySize.cy : height;
+    if (width <= maxWidth && height <= maxHeight)
+    {
+        outWidth = width;
+        outHeight = height;
+        return;
+    }
+
+    if ((uint64_t)width * maxHeight >= (uint64_t)height * maxWidth)
+    {
+        outWidth = maxWidth;
+        outHeight = (uint32_t)(((uint64_t)height * maxWidth + width / 2) / width);
+    }
+    else
+    {
+        outHeight = maxHeight;
+        outWidth = (uint32_t)(((uint64_t)width * maxHeight + height / 2) / height);
+    }
+    outWidth = std::max<uint32_t>(outWidth, 1);
+    outHeight = std::max<uint32_t>(outHeight, 1);
+}
+
+struct TRTCScreenThumbnailCache::Source
+{
+    TRTCScreenThumbnailRef thumb;
+    TRTCScreenThumbnailRef icon;
+    uint32_t generation = 0;        //һγб update 
+};
+
+TRTCScreenThumbnailCache::TRTCScreenThumbnailCache(const SIZE& thumbSize, const SIZE& iconSize)
+    : m_thumbSize(thumbSize)
+    , m_iconSize(iconSize)
+    , m_scaler(TRTCScaleFilterArea)
+    , m_generation(0)
+{
+}
+
+TRTCScreenThumbnailCache::~TRTCScreenThumbnailCache()
+{
+}
+
+void TRTCScreenThumbnailCache::setDisplaySize(const SIZE& thumbSize, const SIZE& iconSize)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_thumbSize = thumbSize;
+    m_iconSize = iconSize;
+}
+
+uint64_t TRTCScreenThumbnailCache::contentHash(const char* data, size_t size, uint32_t width, uint32_t height)
+{
+    //·ۼӣÿδ 32 ֽڣ̣˷ˮִ
+    uint64_t acc[4] = { kHashPrime1 + kHashPrime2, kHashPrime2, 0, (uint64_t)0 - kHashPrime1 };
+    size_t offset = 0;
+    for (; offset + 32 <= size; offset += 32)
+    {
+        acc[0] = hashRound(acc[0], loadWord(data + offset));
+        acc[1] = hashRound(acc[1], loadWord(data + offset + 8));
+        acc[2] = hashRound(acc[2], loadWord(data + offset + 16));
+        acc[3] = hashRound(acc[3], loadWord(data + offset + 24));
+    }
+
+    uint64_t hash = ((uint64_t)width << 32 | height) * kHashPrime1 ^ (uint64_t)size;
+    for (int i = 0; i < 4; ++i)
+        hash = hashRound(hash, acc[i]);
+    for (; offset < size; ++offset)
+        hash = hashRound(hash, (uint8_t)data[offset]);
+
+    hash ^= hash >> 33;
+    hash *= kHashPrime2;
+    hash ^= hash >> 29;
+    return hash;
+}
+
+TRTCScreenThumbnailRef TRTCScreenThumbnailCache::refresh(const TRTCScreenThumbnailRef& cached, const TXString& data,
+    uint32_t width, uint32_t height, const SIZE& displaySize, bool& bChanged)
+{
+    size_t length = (size_t)width * height * 4;
+    if (width == 0 || height == 0 || data.size() < length)
+    {
+        bChanged = bChanged || cached;
+        return TRTCScreenThumbnailRef();
+    }
+
+    uint64_t hash = contentHash(data.c_str(), length, width, height);
+    uint32_t outWidth = 0;
+    uint32_t outHeight = 0;
+    fitSize(width, height, displaySize, outWidth, outHeight);
+    if (cached && cached->contentHash == hash && cached->width == outWidth && cached->height == outHeight)
+    {
+        ++m_stats.hitCount;
+        return cached;
+    }
+
+    std::shared_ptr<TRTCScreenThumbnail> thumbnail = std::make_shared<TRTCScreenThumbnail>();
+    thumbnail->width = outWidth;
+    thumbnail->height = outHeight;
+    thumbnail->contentHash = hash;
+    thumbnail->bgra.resize((size_t)outWidth * outHeight * 4);
+    const uint8_t* src = reinterpret_cast<const uint8_t*>(data.c_str());
+    if (outWidth == width && outHeight == height)
+        memcpy(&thumbnail->bgra[0], src, length);
+    else
+        m_scaler.scalePlane(src, width * 4, width, height, &thumbnail->bgra[0], outWidth * 4, outWidth, outHeight, 4);
+
+    ++m_stats.rescaleCount;
+    bChanged = true;
+    return thumbnail;
+}
+
+void TRTCScreenThumbnailCache::update(TRTCScreenCaptureSourceInfoList& sourceList, std::vector<TRTCScreenThumbnailEntry>& entries)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint32_t generation = ++m_generation;
+
+    entries.resize(sourceList.size());
+    for (size_t i = 0; i < sourceList.size(); ++i)
+    {
+        const TRTCScreenCaptureSourceInfo& info = sourceList[i];
+        std::unique_ptr<Source>& source = m_sources[info.sourceId];
+        bool bNew = !source;
+        if (bNew)
+            source.reset(new Source());
+        source->generation = generation;
+
+        TRTCScreenThumbnailEntry& entry = entries[i];
+        entry.type = info.type;
+        entry.sourceId = info.sourceId;
+        entry.sourceName = info.sourceName.c_str();
+        entry.bChanged = bNew;
+        source->thumb = refresh(source->thumb, info.thumbBGRA, info.thumbWidth, info.thumbHeight, m_thumbSize, entry.bChanged);
+        source->icon = refresh(source->icon, info.iconBGRA, info.iconWidth, info.iconHeight, m_iconSize, entry.bChanged);
+        entry.thumb = source->thumb;
+        entry.icon = source->icon;
+    }
+
+    for (auto it = m_sources.begin(); it != m_sources.end();)
+    {
+        if (it->second->generation != generation)
+        {
+            it = m_sources.erase(it);
+            ++m_stats.evictCount;
+        }
+        else
+            ++it;
+    }
+}
+
+void TRTCScreenThumbnailCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_sources.clear();
+}
+
+TRTCScreenThumbnailCacheStats TRTCScreenThumbnailCache::getStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    TRTCScreenThumbnailCacheStats stats = m_stats;
+    stats.cachedSourceCount = (uint32_t)m_sources.size();
+    return stats;
+}
@@ -0,0 +1,87 @@
+#pragma once
+/*
+* Module:   TRTCScreenThumbnailCache
+*
+* Function: Ļѡ񴰿ʱ getScreenCaptureSources صͼͼ꣬ÿˢֻݱ˵ĲɼԴ
+*
+*    1.  sourceId Ϊ thumbBGRAiconBGRA ԭʼֽںͿ߼ 64 λϣһͬʱֱӸѾźõͼ
+*
+*    2. ݱ仯ʾСıʱ TRTCVideoScaler ȱŵʾڣСƽǽе BGRA
+*       ͨ shared_ptr<const TRTCScreenThumbnail> ̺߳ͻ߳̿Թͬһڴٿ
+*
+*    3. бûеĲɼԴѹرգӻɾ
+*/
+
+#include "TRTCCloudDef.h"
+#include "TRTCVideoScaler.h"
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+
+struct TRTCScreenThumbnail
+{
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint8_t> bgra;          //width * height * 4֮û
+    uint64_t contentHash = 0;           //ǰԭͼĹϣ
+};
+
+typedef std::shared_ptr<const TRTCScreenThumbnail> TRTCScreenThumbnailRef;
+
+struct TRTCScreenThumbnailEntry
+{
+    TRTCScreenCaptureSourceType type = TRTCScreenCaptureSourceTypeUnknown;
+    HWND sourceId = NULL;
+    std::string sourceName;
+    TRTCScreenThumbnailRef thumb;       //ԭͼΪʱΪ NULL
+    TRTCScreenThumbnailRef icon;
+    bool bChanged = false;              //ͼͼһ update ĽֻͬҪػЩ
+};
+
+struct TRTCScreenThumbnailCacheStats
+{
+    uint32_t cachedSourceCount = 0;
+    uint64_t hitCount = 0;              //û䣬ֱӸ
+    uint64_t rescaleCount = 0;          //
+    uint64_t evictCount = 0;
+};
+
+class TRTCScreenThumbnailCache
+{
+public:
+    //thumbSizeiconSize ǽʾĴСźͼΧڱԭͼ߱
+    TRTCScreenThumbnailCache(const SIZE& thumbSize, const SIZE& iconSize);
+    ~TRTCScreenThumbnailCache();
+
+    //ʾСıһ update вɼԴ
+    void setDisplaySize(const SIZE& thumbSize, const SIZE& iconSize);
+
+    //sourceList Ǹոյ getScreenCaptureSources õбentries ͬ˳
+    void update(TRTCScreenCaptureSourceInfoList& sourceList, std::vector<TRTCScreenThumbnailEntry>& entries);
+
+    void clear();
+    TRTCScreenThumbnailCacheStats getStats() const;
+
+    //ԭͼֽڼϣҲ
+    static uint64_t contentHash(const char* data, size_t size, uint32_t width, uint32_t height);
+
+    struct Source;
+private:
+    TRTCScreenThumbnailCache(const TRTCScreenThumbnailCache&);
+    TRTCScreenThumbnailCache& operator =(const TRTCScreenThumbnailCache&);
+
+    TRTCScreenThumbnailRef refresh(const TRTCScreenThumbnailRef& cached, const TXString& data, uint32_t width, uint32_t height,
+        const SIZE& displaySize, bool& bChanged);
+private:
+    mutable std::mutex m_mutex;
+    SIZE m_thumbSize;
+    SIZE m_iconSize;
+    TRTCVideoScaler m_scaler;
+    std::map<HWND, std::unique_ptr<Source>> m_sources;
+    uint32_t m_generation;
+    TRTCScreenThumbnailCacheStats m_stats;
+};
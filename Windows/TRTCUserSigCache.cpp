@@ -0,0 +1,323 @@
+/*
+* Module:   TRTCUserSigCache
+*
+* Function:  (sdkAppId, userId, roomId)  UserSigڹǰɺ̨߳ǰˢ
+*/
+
+#include "TRTCUserSigCache.h"
+#include "Base64.h"
+#include "ZlibCodec.h"
+#include "json.h"
+#include <stdlib.h>
+#include <time.h>
+#include <tuple>
+#include <chrono>
+#include <algorithm>
+
+//ʣЧڲֵ UserSig ٷظʹ
+static const int64_t kMinRemainSeconds = 60;
+//ǰˢµСǰ
+static const int64_t kMinRefreshAheadSeconds = 5 * 60;
+//ˢʧܺԼ
+static const int64_t kRetryIntervalSeconds = 30;
+
+static int64_t currentTime()
+{
+    return (int64_t)::time(NULL);
+}
+
+//Json еʱֶڲͬ汾ǩ֣Ҳַ
+static bool readTimeField(const Json::Value& root, const char* name, int64_t& value)
+{
+    if (!root.isMember(name))
+        return false;
+
+    const Json::Value& field = root[name];
+    if (field.isIntegral())
+    {
+        value = field.asInt64();
+        return true;
+    }
+    if (field.isString())
+    {
+        std::string str = field.asString();
+        char* end = NULL;
+        value = ::strtoll(str.c_str(), &end, 10);
+        return !str.empty() && end != NULL && *end == '\0';
+    }
+    return false;
+}
+
+bool TRTCUserSigCache::CacheKey::operator<(const CacheKey& other) const
+{
+    return std::tie(sdkAppId, userId, roomId) < std::tie(other.sdkAppId, other.userId, other.roomId);
+}
+
+TRTCUserSigCache::TRTCUserSigCache()
+{
+
+}
+
+TRTCUserSigCache::~TRTCUserSigCache()
+{
+    stop();
+}
+
+void TRTCUserSigCache::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_bExit = true;
+        m_fetchKeys.clear();
+    }
+    m_refreshCond.notify_all();
+    if (m_refreshThread.joinable())
+        m_refreshThread.join();
+}
+
+TRTCUserSigCache& TRTCUserSigCache::instance()
+{
+    static TRTCUserSigCache uniqueInstance;
+    return uniqueInstance;
+}
+
+bool TRTCUserSigCache::decodeUserSigTime(const std::string& userSig, int64_t& issueTime, int64_t& expireTime)
+{
+    //UserSig ǰ '+''/''=' 滻 '*''-''_'  base64Ϊ zlib ѹ Json
+    std::string base64 = userSig;
+    for (size_t i = 0; i < base64.size(); ++i)
+    {
+        if (base64[i] == '*')
+            base64[i] = '+';
+        else if (base64[i] == '-')
+            base64[i] = '/';
+        else if (base64[i] == '_')
+            base64[i] = '=';
+    }
+
+    std::string compressed;
+    if (!Base64Decode(base64.data(), base64.size(), compressed))
+        return false;
+
+    std::string jsonStr;
+    if (!ZlibUncompress(compressed.data(), compressed.size(), jsonStr))
+        return false;
+
+    Json::Reader reader;
+    Json::Value root;
+    if (!reader.parse(jsonStr, root) || !root.isObject())
+        return false;
+
+    //TLS v1 ľǩ TLS.expire_after ¼Чʱ
+    int64_t duration = 0;
+    if (!readTimeField(root, "TLS.time", issueTime)
+        || (!readTimeField(root, "TLS.expire", duration) && !readTimeField(root, "TLS.expire_after", duration)))
+        return false;
+
+    expireTime = issueTime + duration;
+    return true;
+}
+
+void TRTCUserSigCache::setFetcher(UserSigFetcher fetcher)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_fetcher = fetcher;
+    if (m_fetcher && !m_bExit && !m_refreshThread.joinable())
+        m_refreshThread = std::thread(&TRTCUserSigCache::refreshThreadProc, this);
+    m_refreshCond.notify_all();
+}
+
+static bool isExpired(bool bExpireKnown, int64_t expireTime, int64_t now)
+{
+    return bExpireKnown && expireTime <= now;
+}
+
+bool TRTCUserSigCache::updateEntry(const CacheKey& key, const std::string& userSig, int64_t now)
+{
+    if (userSig.empty())
+        return false;
+
+    //ʧܵǩǾɸʽ̨У飬ﲻܾ
+    int64_t issueTime = 0;
+    int64_t expireTime = 0;
+    bool bExpireKnown = decodeUserSigTime(userSig, issueTime, expireTime);
+    if (isExpired(bExpireKnown, expireTime, now))
+        return false;
+
+    CacheEntry& entry = m_cache[key];
+    entry.userSig = userSig;
+    entry.bExpireKnown = bExpireKnown;
+    entry.expireTime = bExpireKnown ? expireTime : 0;
+    entry.refreshTime = 0;
+    if (bExpireKnown)
+    {
+        int64_t ahead = std::max((expireTime - issueTime) / 10, kMinRefreshAheadSeconds);
+        entry.refreshTime = std::max(expireTime - ahead, now);
+    }
+    return true;
+}
+
+const TRTCUserSigCache::CacheEntry* TRTCUserSigCache::findEntry(const CacheKey& key, int64_t now, bool bFresh) const
+{
+    CacheKey anyRoomKey = { key.sdkAppId, key.userId, 0 };
+    const CacheKey* keys[] = { &key, &anyRoomKey };
+    for (size_t i = 0; i < (key.roomId != 0 ? 2u : 1u); ++i)
+    {
+        CacheMap::const_iterator it = m_cache.find(*keys[i]);
+        if (it == m_cache.end())
+            continue;
+
+        const CacheEntry& entry = it->second;
+        int64_t remain = bFresh ? kMinRemainSeconds : 0;
+        if (!isExpired(entry.bExpireKnown, entry.expireTime - remain, now))
+            return &entry;
+    }
+    return NULL;
+}
+
+bool TRTCUserSigCache::putUserSig(uint32_t sdkAppId, const std::string& userId, uint32_t roomId, const std::string& userSig)
+{
+    CacheKey key = { sdkAppId, userId, roomId };
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!updateEntry(key, userSig, currentTime()))
+        return false;
+    m_refreshCond.notify_all();
+    return true;
+}
+
+bool TRTCUserSigCache::getUserSig(uint32_t sdkAppId, const std::string& userId, uint32_t roomId, std::string& userSig)
+{
+    CacheKey key = { sdkAppId, userId, roomId };
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const CacheEntry* entry = findEntry(key, currentTime(), true);
+    if (entry != NULL)
+    {
+        userSig = entry->userSig;
+        return true;
+    }
+
+    UserSigFetcher fetcher = m_fetcher;
+    if (fetcher)
+    {
+        lock.unlock();
+        std::string newUserSig = fetcher(sdkAppId, userId, roomId);
+        lock.lock();
+        if (updateEntry(key, newUserSig, currentTime()))
+        {
+            m_refreshCond.notify_all();
+            userSig = newUserSig;
+            return true;
+        }
+    }
+
+    //òµ UserSig ʱڵûйڵȻ
+    entry = findEntry(key, currentTime(), false);
+    if (entry == NULL)
+        return false;
+    userSig = entry->userSig;
+    return true;
+}
+
+bool TRTCUserSigCache::getCachedUserSig(uint32_t sdkAppId, const std::string& userId, uint32_t roomId, std::string& userSig)
+{
+    CacheKey key = { sdkAppId, userId, roomId };
+    int64_t now = currentTime();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const CacheEntry* entry = findEntry(key, now, true);
+    if (entry == NULL)
+    {
+        requestFetch(key);
+        entry = findEntry(key, now, false);
+    }
+    if (entry == NULL)
+        return false;
+    userSig = entry->userSig;
+    return true;
+}
+
+void TRTCUserSigCache::requestFetch(const CacheKey& key)
+{
+    if (!m_fetcher || m_bExit)
+        return;
+    if (m_fetchKeys.insert(key).second)
+        m_refreshCond.notify_all();
+}
+
+void TRTCUserSigCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cache.clear();
+}
+
+void TRTCUserSigCache::refreshThreadProc()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_bExit)
+    {
+        //ȴ̲߳鲻ʱͬһ key ڻȡǰظ
+        if (!m_fetchKeys.empty() && m_fetcher)
+        {
+            CacheKey key = *m_fetchKeys.begin();
+            UserSigFetcher fetcher = m_fetcher;
+            lock.unlock();
+            std::string userSig = fetcher(key.sdkAppId, key.userId, key.roomId);
+            lock.lock();
+
+            m_fetchKeys.erase(key);
+            updateEntry(key, userSig, currentTime());
+            continue;
+        }
+
+        //ҵҪˢµһ
+        CacheMap::iterator next = m_cache.end();
+        for (CacheMap::iterator it = m_cache.begin(); it != m_cache.end(); ++it)
+        {
+            //Чδ֪ǩǰˢ
+            if (!it->second.refreshing && it->second.bExpireKnown
+                && (next == m_cache.end() || it->second.refreshTime < next->second.refreshTime))
+                next = it;
+        }
+
+        if (next == m_cache.end() || !m_fetcher)
+        {
+            m_refreshCond.wait(lock);
+            continue;
+        }
+
+        int64_t now = currentTime();
+        if (next->second.refreshTime > now)
+        {
+            m_refreshCond.wait_for(lock, std::chrono::seconds(next->second.refreshTime - now));
+            continue;
+        }
+
+        //ڼ䲻߳ȻԶȡɵ UserSig
+        CacheKey key = next->first;
+        UserSigFetcher fetcher = m_fetcher;
+        next->second.refreshing = true;
+        lock.unlock();
+        std::string userSig = fetcher(key.sdkAppId, key.userId, key.roomId);
+        lock.lock();
+
+        CacheMap::iterator it = m_cache.find(key);
+        if (it == m_cache.end())
+            continue;   //ˢڼ䱻 clear
+
+        it->second.refreshing = false;
+        now = currentTime();
+        if (!updateEntry(key, userSig, now))
+        {
+            if (isExpired(it->second.bExpireKnown, it->second.expireTime, now))
+                m_cache.erase(it);
+            else
+                it->second.refreshTime = now + kRetryIntervalSeconds;
+        }
+        else if (it->second.bExpireKnown && it->second.refreshTime <= now)
+        {
+            //õ UserSig Ҳˣһˢ£
+            it->second.refreshTime = now + kRetryIntervalSeconds;
+        }
+    }
+}
@@ -0,0 +1,95 @@
+#pragma once
+/*
+* Module:   TRTCUserSigCache
+*
+* Function:  (sdkAppId, userId, roomId)  UserSigڹǰɺ̨߳ǰˢ
+*
+*    1. UserSig ںǩʱ䣨TLS.timeЧʱTLS.expireTLS v1 ľǩΪ TLS.expire_afterֱӴǩнʱ䡣
+*       ʱǩЧδ֪棬ԭظʹãҲǰˢ¡
+*
+*    2. ʣЧЧڵ 1/10 5 ӣʱ̵̨߳ fetcher »ȡ
+*       ʱֱȡ棬ͨҪȴҵ
+*
+*    3. ߳ͨ getCachedUserSig ֻ棬ûпõ UserSig ʱ̨̻߳ȡ棻
+*       ˳ʱҪ ExitInstance е stop ̨̣߳Ҫȵ̬
+*
+*    4. 󶨷 UserSig Config.json еĲǩ roomId = 0 洢ָ鲻ʱ˵
+*/
+
+#include <string>
+#include <map>
+#include <set>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <functional>
+#include <stdint.h>
+
+class TRTCUserSigCache
+{
+protected:
+    TRTCUserSigCache();
+    TRTCUserSigCache(const TRTCUserSigCache&);
+    TRTCUserSigCache operator =(const TRTCUserSigCache&);
+public:
+    ~TRTCUserSigCache();
+    static TRTCUserSigCache& instance();
+
+    //ȡ UserSig ķҵʧܷؿַں̨ˢ̻߳ getUserSig ִ߳
+    typedef std::function<std::string(uint32_t sdkAppId, const std::string& userId, uint32_t roomId)> UserSigFetcher;
+
+    // fetcher Ż̨ˢ
+    void setFetcher(UserSigFetcher fetcher);
+
+    //дһе UserSigΪջĹʱѹʱ false
+    bool putUserSig(uint32_t sdkAppId, const std::string& userId, uint32_t roomId, const std::string& userSig);
+
+    //ȡһЧڵ UserSigûл򼴽ʱͬ fetcheṛ߳Ҫڽ̵߳ã
+    //û fetcher ȡʧʱֻҪ UserSig ûڣЧδ֪Ȼ
+    bool getUserSig(uint32_t sdkAppId, const std::string& userId, uint32_t roomId, std::string& userSig);
+
+    //ֻ黺棬 fetcherڽ̵߳ãûʣЧ㹻 UserSig ʱ̨̻߳ȡ
+    //Էػûйڵľ UserSigһûʱ falseԺԼ
+    bool getCachedUserSig(uint32_t sdkAppId, const std::string& userId, uint32_t roomId, std::string& userSig);
+
+    void clear();
+
+    //̨ˢ̣֮߳ٵ fetcherڳ˳ExitInstanceʱ
+    void stop();
+
+    // UserSig нǩʱ͹ʱ䣨UTC 룩
+    static bool decodeUserSigTime(const std::string& userSig, int64_t& issueTime, int64_t& expireTime);
+private:
+    struct CacheKey
+    {
+        uint32_t sdkAppId;
+        std::string userId;
+        uint32_t roomId;
+
+        bool operator<(const CacheKey& other) const;
+    };
+    struct CacheEntry
+    {
+        std::string userSig;
+        int64_t expireTime = 0;
+        int64_t refreshTime = 0;
+        bool bExpireKnown = true;       //false ʾǩнʱ
+        bool refreshing = false;
+    };
+    typedef std::map<CacheKey, CacheEntry> CacheMap;
+
+    bool updateEntry(const CacheKey& key, const std::string& userSig, int64_t now);
+    //Ȳָٻ˵ roomId = 0bFresh Ϊ true ʱֻʣЧ㹻ģ򷵻ûйڵ
+    const CacheEntry* findEntry(const CacheKey& key, int64_t now, bool bFresh) const;
+    //ʱ m_mutex
+    void requestFetch(const CacheKey& key);
+    void refreshThreadProc();
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_refreshCond;
+    std::thread m_refreshThread;
+    bool m_bExit = false;
+    CacheMap m_cache;
+    std::set<CacheKey> m_fetchKeys;     //ȴ̨̻߳ȡ UserSig
+    UserSigFetcher m_fetcher;
+};
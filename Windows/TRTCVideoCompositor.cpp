@@ -0,0 +1,439 @@
+/*
+* Module:   TRTCVideoCompositor
+*
+* Function: ڱذ TRTCTranscodingConfig ĻְѶ· I420 ϳɵһŻϣڱ¼ƺͻԤ
+*/
+
+#include "TRTCVideoCompositor.h"
+#include "TRTCVideoMailbox.h"
+#include "TRTCVideoConvert.h"
+
+#include <chrono>
+#include <algorithm>
+#include <string.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define VIDEO_COMPOSITOR_SSE2
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#include <arm_neon.h>
+#define VIDEO_COMPOSITOR_NEON
+#endif
+
+typedef std::chrono::steady_clock CompositorClock;
+
+static const int kTileRows = 16;            //ÿż
+static const uint32_t kMaxThreadCount = 4;
+static const int kFracBits = 8;
+static const int kFracOne = 1 << kFracBits;
+
+//һƽ rect ÿһСÿһжӦԴأrect Ĳֲ
+struct PlaneMap
+{
+    int width = 0;                  //rect ڸƽϵĴС
+    int height = 0;
+    int cropX = 0;                  //ȱȲüԴϽǣģʽʹ
+    int cropY = 0;
+    int srcWidth = 0;               //Դƽ
+    bool bCopy = false;             //Դ rect һֱӰп
+    std::vector<int32_t> xIndex;    //ԴкţԴƽȴ 1 ʱ xIndex + 1 һԴ
+    std::vector<uint16_t> xFrac;    //xIndex + 1 Ȩأ0~255
+    std::vector<int32_t> yIndex;
+    std::vector<uint16_t> yFrac;
+};
+
+struct TRTCVideoCompositor::Layer
+{
+    std::string userId;
+    TRTCVideoStreamType streamType = TRTCVideoStreamTypeBig;
+    int zOrder = 0;
+    int left = 0;                   //rect 뵽żλúʹСܳ
+    int top = 0;
+    int width = 0;
+    int height = 0;
+    TRTCVideoFrameRef frame;
+
+    //maps ӦԴߴ磬ߴ仯ʱ
+    uint32_t mapWidth = 0;
+    uint32_t mapHeight = 0;
+    PlaneMap maps[2];               //0 Ϊȣ1 Ϊɫƽ湲
+};
+
+// dstSize ذĶӳ䵽 cropStart ʼ cropSize ԴϣԴƽ湲 srcSize 
+static void buildAxisMap(int dstSize, int cropStart, int cropSize, int srcSize, std::vector<int32_t>& index, std::vector<uint16_t>& frac)
+{
+    index.resize(dstSize);
+    frac.resize(dstSize);
+    //16 λ㣺Դ = cropStart + (i + 0.5) * cropSize / dstSize - 0.5
+    int64_t step = ((int64_t)cropSize << 16) / dstSize;
+    int64_t pos = ((int64_t)cropStart << 16) + step / 2 - (1 << 15);
+    int64_t maxPos = (int64_t)(srcSize - 1) << 16;
+    for (int i = 0; i < dstSize; ++i, pos += step)
+    {
+        int64_t p = std::max<int64_t>(0, std::min(pos, maxPos));
+        int32_t i0 = (int32_t)(p >> 16);
+        uint16_t f = (uint16_t)((p & 0xffff) >> (16 - kFracBits));
+        //һûڣһ񲢰Ȩط֤ i0 + 1 Խ
+        if (i0 >= srcSize - 1)
+        {
+            i0 = std::max(0, srcSize - 2);
+            f = srcSize > 1 ? (uint16_t)(kFracOne - 1) : 0;
+        }
+        index[i] = i0;
+        frac[i] = f;
+    }
+}
+
+static void buildPlaneMap(PlaneMap& map, int dstWidth, int dstHeight, int srcWidth, int srcHeight)
+{
+    map.width = dstWidth;
+    map.height = dstHeight;
+    map.srcWidth = srcWidth;
+
+    //FillȱȷŴ󵽸 rectಿ־вõ
+    int cropWidth = srcWidth;
+    int cropHeight = srcHeight;
+    if ((int64_t)srcWidth * dstHeight > (int64_t)srcHeight * dstWidth)
+        cropWidth = std::max(1, (int)((int64_t)srcHeight * dstWidth / dstHeight));
+    else
+        cropHeight = std::max(1, (int)((int64_t)srcWidth * dstHeight / dstWidth));
+    map.cropX = (srcWidth - cropWidth) / 2;
+    map.cropY = (srcHeight - cropHeight) / 2;
+    map.bCopy = cropWidth == dstWidth && cropHeight == dstHeight;
+    if (map.bCopy)
+    {
+        map.xIndex.clear();
+        map.xFrac.clear();
+        map.yIndex.clear();
+        map.yFrac.clear();
+        return;
+    }
+
+    buildAxisMap(dstWidth, map.cropX, cropWidth, srcWidth, map.xIndex, map.xFrac);
+    buildAxisMap(dstHeight, map.cropY, cropHeight, srcHeight, map.yIndex, map.yFrac);
+}
+
+static void updateLayerMaps(TRTCVideoCompositor::Layer& layer)
+{
+    const TRTCVideoFrame& frame = layer.frame.frame();
+    if (layer.mapWidth == frame.width && layer.mapHeight == frame.height)
+        return;
+
+    layer.mapWidth = frame.width;
+    layer.mapHeight = frame.height;
+    buildPlaneMap(layer.maps[0], layer.width, layer.height, frame.width, frame.height);
+    buildPlaneMap(layer.maps[1], layer.width / 2, layer.height / 2, (frame.width + 1) / 2, (frame.height + 1) / 2);
+}
+
+//dst = (row0 * (256 - f) + row1 * f + 128) >> 8f Ϊ 1~255
+static void blendRows(const uint8_t* row0, const uint8_t* row1, uint8_t* dst, int count, int f)
+{
+    int x = 0;
+#if defined(VIDEO_COMPOSITOR_SSE2)
+    const __m128i w0 = _mm_set1_epi16((short)(kFracOne - f));
+    const __m128i w1 = _mm_set1_epi16((short)f);
+    const __m128i round = _mm_set1_epi16(kFracOne / 2);
+    const __m128i zero = _mm_setzero_si128();
+    for (; x + 16 <= count; x += 16)
+    {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x));
+        //ֵ 255 * 256 + 128  16 λ޷ŷΧڣ߼
+        __m128i lo = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), w0),
+            _mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), w1)), round);
+        __m128i hi = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), w0),
+            _mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), w1)), round);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x),
+            _mm_packus_epi16(_mm_srli_epi16(lo, kFracBits), _mm_srli_epi16(hi, kFracBits)));
+    }
+#elif defined(VIDEO_COMPOSITOR_NEON)
+    const uint8x8_t w0 = vdup_n_u8((uint8_t)(kFracOne - f));
+    const uint8x8_t w1 = vdup_n_u8((uint8_t)f);
+    for (; x + 16 <= count; x += 16)
+    {
+        uint8x16_t a = vld1q_u8(row0 + x);
+        uint8x16_t b = vld1q_u8(row1 + x);
+        uint16x8_t lo = vmlal_u8(vmull_u8(vget_low_u8(a), w0), vget_low_u8(b), w1);
+        uint16x8_t hi = vmlal_u8(vmull_u8(vget_high_u8(a), w0), vget_high_u8(b), w1);
+        vst1q_u8(dst + x, vcombine_u8(vrshrn_n_u16(lo, kFracBits), vrshrn_n_u16(hi, kFracBits)));
+    }
+#endif
+    for (; x < count; ++x)
+        dst[x] = (uint8_t)((row0[x] * (kFracOne - f) + row1[x] * f + kFracOne / 2) >> kFracBits);
+}
+
+// rect ڵ row е [col0, col1) Уdst ָ򻭲ϸ col0 Ӧλ
+static void drawLayerRow(const PlaneMap& map, const uint8_t* src, int srcStride, int row, int col0, int col1, uint8_t* dst, uint8_t* scratch)
+{
+    if (map.bCopy)
+    {
+        memcpy(dst, src + (map.cropY + row) * srcStride + map.cropX + col0, col1 - col0);
+        return;
+    }
+
+    //ֱҪõԴضλϵ scratchˮƽвֵ
+    //Դƽֻ 1 ʱ 2 ػɫƽ棩ûڣֻܶһ
+    int first = map.xIndex[col0];
+    int count = map.srcWidth > 1 ? map.xIndex[col1 - 1] + 2 - first : 1;
+    const uint8_t* row0 = src + map.yIndex[row] * srcStride + first;
+    int f = map.yFrac[row];
+    const uint8_t* line = row0;
+    if (f != 0)
+    {
+        blendRows(row0, row0 + srcStride, scratch, count, f);
+        line = scratch;
+    }
+
+    if (map.srcWidth == 1)
+    {
+        memset(dst, line[0], col1 - col0);
+        return;
+    }
+
+    const int32_t* xIndex = &map.xIndex[0];
+    const uint16_t* xFrac = &map.xFrac[0];
+    for (int x = col0; x < col1; ++x)
+    {
+        const uint8_t* p = line + (xIndex[x] - first);
+        int fx = xFrac[x];
+        *dst++ = (uint8_t)((p[0] * (kFracOne - fx) + p[1] * fx + kFracOne / 2) >> kFracBits);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////TRTCVideoCompositor
+
+TRTCVideoCompositor::TRTCVideoCompositor(TRTCVideoFramePool* pool, uint32_t threadCount)
+    : m_pool(pool)
+    , m_nextTile(0)
+{
+    m_planes[0] = m_planes[1] = m_planes[2] = NULL;
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::min(kMaxThreadCount, std::thread::hardware_concurrency()));
+
+    m_scratch.resize(threadCount);
+    for (uint32_t i = 1; i < threadCount; ++i)
+        m_threads.push_back(std::thread(&TRTCVideoCompositor::workerThread, this, (size_t)i));
+}
+
+TRTCVideoCompositor::~TRTCVideoCompositor()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_jobMutex);
+        m_bQuit = true;
+    }
+    m_jobCond.notify_all();
+    for (size_t i = 0; i < m_threads.size(); ++i)
+        m_threads[i].join();
+}
+
+void TRTCVideoCompositor::setLayout(const TRTCTranscodingConfig& config)
+{
+    m_canvasWidth = config.videoWidth & ~1u;
+    m_canvasHeight = config.videoHeight & ~1u;
+
+    std::vector<std::unique_ptr<Layer>> layers;
+    for (uint32_t i = 0; config.mixUsersArray != NULL && i < config.mixUsersArraySize; ++i)
+    {
+        const TRTCMixUser& user = config.mixUsersArray[i];
+        std::unique_ptr<Layer> layer(new Layer);
+        layer->userId = user.userId.c_str();
+        layer->streamType = user.streamType;
+        layer->zOrder = user.zOrder;
+        layer->left = user.rect.left & ~1;
+        layer->top = user.rect.top & ~1;
+        layer->width = ((user.rect.right + 1) & ~1) - layer->left;
+        layer->height = ((user.rect.bottom + 1) & ~1) - layer->top;
+        if (layer->width <= 0 || layer->height <= 0)
+            continue;
+
+        //ͬһ·еĻ棬ֱ仯ŲҪ
+        for (size_t j = 0; j < m_layers.size(); ++j)
+        {
+            if (m_layers[j] && m_layers[j]->userId == layer->userId && m_layers[j]->streamType == layer->streamType)
+            {
+                layer->frame = m_layers[j]->frame;
+                break;
+            }
+        }
+        layers.push_back(std::move(layer));
+    }
+
+    std::stable_sort(layers.begin(), layers.end(), [](const std::unique_ptr<Layer>& a, const std::unique_ptr<Layer>& b) {
+        return a->zOrder < b->zOrder;
+    });
+    m_layers.swap(layers);
+}
+
+void TRTCVideoCompositor::setInputFrame(const std::string& userId, TRTCVideoStreamType streamType, const TRTCVideoFrameRef& frame)
+{
+    if (frame.empty() || frame.frame().videoFormat != TRTCVideoPixelFormat_I420 || frame.frame().bufferType != TRTCVideoBufferType_Buffer
+        || frame.frame().width < 2 || frame.frame().height < 2
+        || frame.frame().length < TRTCVideoConvert::frameLength(TRTCVideoPixelFormat_I420, frame.frame().width, frame.frame().height))
+        return;
+
+    for (size_t i = 0; i < m_layers.size(); ++i)
+    {
+        Layer& layer = *m_layers[i];
+        if (layer.streamType == streamType && layer.userId == userId)
+            layer.frame = frame;
+    }
+}
+
+void TRTCVideoCompositor::pullFrom(TRTCVideoMailboxCallback& mailboxes)
+{
+    for (size_t i = 0; i < m_layers.size(); ++i)
+    {
+        const Layer& layer = *m_layers[i];
+        TRTCVideoFrameRef frame;
+        if (mailboxes.takeLatest(layer.userId, layer.streamType, frame))
+            setInputFrame(layer.userId, layer.streamType, frame);
+    }
+}
+
+TRTCVideoFrameRef TRTCVideoCompositor::compose(uint64_t timestamp)
+{
+    if (m_canvasWidth == 0 || m_canvasHeight == 0)
+        return TRTCVideoFrameRef();
+
+    CompositorClock::time_point start = CompositorClock::now();
+    TRTCVideoFrameRef output = m_pool->acquire(TRTCVideoConvert::frameLength(TRTCVideoPixelFormat_I420, m_canvasWidth, m_canvasHeight));
+    if (output.empty())
+        return output;
+
+    TRTCVideoFrame& frame = output.frame();
+    frame.videoFormat = TRTCVideoPixelFormat_I420;
+    frame.width = m_canvasWidth;
+    frame.height = m_canvasHeight;
+    frame.timestamp = timestamp;
+
+    //ڹ߳̿ʼǰ׼ŲʱУƹвٷڴ
+    size_t scratchSize = 0;
+    for (size_t i = 0; i < m_layers.size(); ++i)
+    {
+        Layer& layer = *m_layers[i];
+        if (layer.frame.empty())
+        {
+            ++m_stats.emptyLayerCount;
+            continue;
+        }
+        updateLayerMaps(layer);
+        scratchSize = std::max(scratchSize, (size_t)layer.frame.frame().width + 16);
+    }
+    for (size_t i = 0; i < m_scratch.size(); ++i)
+    {
+        if (m_scratch[i].size() < scratchSize)
+            m_scratch[i].resize(scratchSize);
+    }
+
+    m_planes[0] = reinterpret_cast<uint8_t*>(frame.data);
+    m_planes[1] = m_planes[0] + m_canvasWidth * m_canvasHeight;
+    m_planes[2] = m_planes[1] + (m_canvasWidth / 2) * (m_canvasHeight / 2);
+    m_tileCount = (int)((m_canvasHeight + kTileRows - 1) / kTileRows);
+    m_nextTile.store(0, std::memory_order_relaxed);
+
+    if (!m_threads.empty())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_jobMutex);
+            m_busyWorkers = (uint32_t)m_threads.size();
+            ++m_jobGeneration;
+        }
+        m_jobCond.notify_all();
+    }
+    runTiles(0);
+    if (!m_threads.empty())
+    {
+        std::unique_lock<std::mutex> lock(m_jobMutex);
+        m_doneCond.wait(lock, [this] { return m_busyWorkers == 0; });
+    }
+
+    double ms = std::chrono::duration<double, std::milli>(CompositorClock::now() - start).count();
+    ++m_stats.composedCount;
+    m_stats.avgComposeMs += (ms - m_stats.avgComposeMs) / m_stats.composedCount;
+    m_stats.maxComposeMs = std::max(m_stats.maxComposeMs, ms);
+    return output;
+}
+
+TRTCVideoCompositorStats TRTCVideoCompositor::getStats() const
+{
+    return m_stats;
+}
+
+void TRTCVideoCompositor::workerThread(size_t index)
+{
+    uint64_t generation = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_jobMutex);
+            m_jobCond.wait(lock, [&] { return m_bQuit || m_jobGeneration != generation; });
+            if (m_bQuit)
+                return;
+            generation = m_jobGeneration;
+        }
+
+        runTiles(index);
+
+        std::lock_guard<std::mutex> lock(m_jobMutex);
+        if (--m_busyWorkers == 0)
+            m_doneCond.notify_one();
+    }
+}
+
+void TRTCVideoCompositor::runTiles(size_t scratchIndex)
+{
+    std::vector<uint8_t>& scratch = m_scratch[scratchIndex];
+    for (;;)
+    {
+        int tile = m_nextTile.fetch_add(1, std::memory_order_relaxed);
+        if (tile >= m_tileCount)
+            break;
+        drawTile(tile, scratch);
+    }
+}
+
+void TRTCVideoCompositor::drawTile(int tile, std::vector<uint8_t>& scratch)
+{
+    for (int plane = 0; plane < 3; ++plane)
+    {
+        //ɫƽĿߡrect Χ
+        int shift = plane == 0 ? 0 : 1;
+        int canvasWidth = (int)m_canvasWidth >> shift;
+        int row0 = (tile * kTileRows) >> shift;
+        int row1 = std::min((int)m_canvasHeight, (tile + 1) * kTileRows) >> shift;
+        uint8_t* canvas = m_planes[plane];
+
+        //Ϊɫ
+        memset(canvas + row0 * canvasWidth, plane == 0 ? 16 : 128, (row1 - row0) * canvasWidth);
+
+        for (size_t i = 0; i < m_layers.size(); ++i)
+        {
+            const Layer& layer = *m_layers[i];
+            if (layer.frame.empty())
+                continue;
+
+            const PlaneMap& map = layer.maps[shift];
+            int left = layer.left >> shift;
+            int top = layer.top >> shift;
+            int y0 = std::max(row0, top);
+            int y1 = std::min(row1, top + map.height);
+            int x0 = std::max(0, left);
+            int x1 = std::min(canvasWidth, left + map.width);
+            if (y0 >= y1 || x0 >= x1)
+                continue;
+
+            const TRTCVideoFrame& frame = layer.frame.frame();
+            const uint8_t* src = reinterpret_cast<const uint8_t*>(frame.data);
+            int srcStride = (int)frame.width;
+            if (plane > 0)
+            {
+                int chromaWidth = (int)(frame.width + 1) / 2;
+                src += frame.width * frame.height + (plane - 1) * chromaWidth * ((frame.height + 1) / 2);
+                srcStride = chromaWidth;
+            }
+
+            for (int y = y0; y < y1; ++y)
+                drawLayerRow(map, src, srcStride, y - top, x0 - left, x1 - left, canvas + y * canvasWidth + x0, &scratch[0]);
+        }
+    }
+}
@@ -0,0 +1,89 @@
+#pragma once
+/*
+* Module:   TRTCVideoCompositor
+*
+* Function: ڱذ TRTCTranscodingConfig ĻְѶ· I420 ϳɵһŻϣڱ¼ƺͻԤ
+*
+*    1. Сȡ videoWidth x videoHeightÿ TRTCMixUser  zOrder Сλ rect zOrder ϲ㣻
+*       水 Fill ʽȱţ rect Ĳ־вõûлͼ㱣ֺɫ
+*
+*    2. ʹ˫ԲֵÿͼӳڲֻԴߴ仯ʱһβ棻ֱļȨ SSE2/NEON һδ 16 أ
+*       ߴ粻ͼֱӰп
+*
+*    3. гڲĹ̺߳͵ compose ߳һȡÿڰͼ˳ƣ֮û
+*
+*    4.  compose ڼĹ߳⣬нӿڶӦͬһ̵߳á
+*/
+
+#include "TRTCCloudDef.h"
+#include "TRTCVideoFramePool.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <stdint.h>
+
+class TRTCVideoMailboxCallback;
+
+struct TRTCVideoCompositorStats
+{
+    uint64_t composedCount = 0;
+    uint64_t emptyLayerCount = 0;       //ϳʱûлͼۼ
+    double avgComposeMs = 0;
+    double maxComposeMs = 0;
+};
+
+class TRTCVideoCompositor
+{
+public:
+    //threadCount Ϊ 0 ʱ CPU ȡ 4  compose ̣߳
+    explicit TRTCVideoCompositor(TRTCVideoFramePool* pool, uint32_t threadCount = 0);
+    ~TRTCVideoCompositor();
+
+    //ֻʹ videoWidthvideoHeight  mixUsersArrayͼĻ汣
+    void setLayout(const TRTCTranscodingConfig& config);
+
+    //һ·棬ֻܿΪ 2  I420 ڴ֡ڲе
+    void setInputFrame(const std::string& userId, TRTCVideoStreamType streamType, const TRTCVideoFrameRef& frame);
+    //ӸͼӦȡ֡û֡ͼһ֡
+    void pullFrom(TRTCVideoMailboxCallback& mailboxes);
+
+    //ϳһ֡ I420 棬ûòֻ򻺳ʧʱؿվ
+    TRTCVideoFrameRef compose(uint64_t timestamp);
+
+    TRTCVideoCompositorStats getStats() const;
+
+    struct Layer;
+private:
+    TRTCVideoCompositor(const TRTCVideoCompositor&);
+    TRTCVideoCompositor& operator =(const TRTCVideoCompositor&);
+
+    void workerThread(size_t index);
+    void runTiles(size_t scratchIndex);
+    void drawTile(int tile, std::vector<uint8_t>& scratch);
+private:
+    TRTCVideoFramePool* m_pool;
+    uint32_t m_canvasWidth = 0;
+    uint32_t m_canvasHeight = 0;
+    std::vector<std::unique_ptr<Layer>> m_layers;   // zOrder С
+
+    //compose ڼֻ߳
+    uint8_t* m_planes[3];
+    int m_tileCount = 0;
+    std::atomic<int> m_nextTile;
+
+    std::vector<std::thread> m_threads;
+    std::vector<std::vector<uint8_t>> m_scratch;    //ÿ߳һݣ0 Ÿ compose ߳
+    std::mutex m_jobMutex;
+    std::condition_variable m_jobCond;
+    std::condition_variable m_doneCond;
+    uint64_t m_jobGeneration = 0;
+    uint32_t m_busyWorkers = 0;
+    bool m_bQuit = false;
+
+    TRTCVideoCompositorStats m_stats;
+};
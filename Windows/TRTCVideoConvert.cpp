@@ -0,0 +1,957 @@
+/*
+* Module:   TRTCVideoConvert
+*
+* Function: LiteAVVideoFrame  I420  BGRA32 ת ITRTCVideoRenderCallback ʹ÷ CPU ϴ
+*/
+
+#include "TRTCVideoConvert.h"
+#include "Base.h"
+#include "Benchmark.h"
+
+#include <random>
+#include <algorithm>
+#include <string.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#include <immintrin.h>
+#define VIDEO_CONVERT_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#define VIDEO_CONVERT_AVX2_TARGET
+#else
+#include <cpuid.h>
+#define VIDEO_CONVERT_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#include <arm_neon.h>
+#define VIDEO_CONVERT_NEON
+#endif
+
+//YUV ת RGBR = (yk*Y' + rv*V' + 2^12) >> 13GB ͬY' = Y - yOffsetU' = U - 128V' = V - 128
+struct YUVToRGBCoeffs
+{
+    int16_t yOffset;
+    int16_t yk;
+    int16_t rv;
+    int16_t gu;
+    int16_t gv;
+    int16_t bu;
+};
+
+//RGB ת YUVY = (yr*R + yg*G + yb*B + yRound) >> 15UV  2x2 ֮ͼ㣬 17 λ
+struct RGBToYUVCoeffs
+{
+    int16_t yr, yg, yb;
+    int16_t ur, ug, ub;
+    int16_t vr, vg, vb;
+    int32_t yRound;         //(yOffset << 15) + 2^14
+};
+
+static const int32_t kYUVRound = 1 << 12;
+static const int32_t kChromaRound = (128 << 17) + (1 << 16);
+
+typedef void (*I420ToBGRARowFunc)(const uint8_t* y, const uint8_t* u, const uint8_t* v, uint8_t* dst, int width, const YUVToRGBCoeffs& k);
+//һδУһɫȣ߶Ϊһ src1/y1  src0/y0 ͬ
+typedef void (*BGRAToI420RowsFunc)(const uint8_t* src0, const uint8_t* src1, uint8_t* y0, uint8_t* y1, uint8_t* u, uint8_t* v, int width, const RGBToYUVCoeffs& k);
+
+struct ConvertKernelFuncs
+{
+    I420ToBGRARowFunc i420ToBGRARow;
+    BGRAToI420RowsFunc bgraToI420Rows;
+};
+
+static int16_t roundCoeff(double value)
+{
+    return (int16_t)(value < 0 ? value - 0.5 : value + 0.5);
+}
+
+static void colorSpaceParams(const TRTCColorSpace& colorSpace, double& kr, double& kb, double& yScale, double& cScale, int& yOffset)
+{
+    if (colorSpace.matrix == TRTCColorMatrixBT709)
+    {
+        kr = 0.2126;
+        kb = 0.0722;
+    }
+    else
+    {
+        kr = 0.299;
+        kb = 0.114;
+    }
+
+    if (colorSpace.range == TRTCColorRangeFull)
+    {
+        yScale = 1.0;
+        cScale = 1.0;
+        yOffset = 0;
+    }
+    else
+    {
+        yScale = 219.0 / 255.0;
+        cScale = 224.0 / 255.0;
+        yOffset = 16;
+    }
+}
+
+static YUVToRGBCoeffs makeYUVToRGBCoeffs(const TRTCColorSpace& colorSpace)
+{
+    double kr = 0, kb = 0, yScale = 1, cScale = 1;
+    int yOffset = 0;
+    colorSpaceParams(colorSpace, kr, kb, yScale, cScale, yOffset);
+    double kg = 1.0 - kr - kb;
+
+    YUVToRGBCoeffs k;
+    k.yOffset = (int16_t)yOffset;
+    k.yk = roundCoeff(8192.0 / yScale);
+    k.rv = roundCoeff(8192.0 * 2 * (1 - kr) / cScale);
+    k.gu = roundCoeff(-8192.0 * 2 * (1 - kb) * kb / kg / cScale);
+    k.gv = roundCoeff(-8192.0 * 2 * (1 - kr) * kr / kg / cScale);
+    k.bu = roundCoeff(8192.0 * 2 * (1 - kb) / cScale);
+    return k;
+}
+
+static RGBToYUVCoeffs makeRGBToYUVCoeffs(const TRTCColorSpace& colorSpace)
+{
+    double kr = 0, kb = 0, yScale = 1, cScale = 1;
+    int yOffset = 0;
+    colorSpaceParams(colorSpace, kr, kb, yScale, cScale, yOffset);
+
+    //ygugvg 룬֤ɫõȡɫɫΪ 128
+    RGBToYUVCoeffs k;
+    k.yr = roundCoeff(32768.0 * kr * yScale);
+    k.yb = roundCoeff(32768.0 * kb * yScale);
+    k.yg = (int16_t)((int)(32768.0 * yScale + 0.5) - k.yr - k.yb);
+    k.ub = roundCoeff(32768.0 * 0.5 * cScale);
+    k.ur = roundCoeff(-32768.0 * 0.5 * cScale * kr / (1 - kb));
+    k.ug = (int16_t)(-k.ub - k.ur);
+    k.vr = k.ub;
+    k.vb = roundCoeff(-32768.0 * 0.5 * cScale * kb / (1 - kr));
+    k.vg = (int16_t)(-k.vr - k.vb);
+    k.yRound = (yOffset << 15) + (1 << 14);
+    return k;
+}
+
+static inline uint8_t clampByte(int value)
+{
+    return (uint8_t)(value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+//////////////////////////////////////////////////////////////////////////ʵ
+
+static void i420ToBGRARowScalar(const uint8_t* y, const uint8_t* u, const uint8_t* v, uint8_t* dst, int width, const YUVToRGBCoeffs& k)
+{
+    for (int x = 0; x < width; ++x)
+    {
+        int cu = u[x >> 1] - 128;
+        int cv = v[x >> 1] - 128;
+        int yt = k.yk * (y[x] - k.yOffset) + kYUVRound;
+        dst[0] = clampByte((yt + k.bu * cu) >> 13);
+        dst[1] = clampByte((yt + k.gu * cu + k.gv * cv) >> 13);
+        dst[2] = clampByte((yt + k.rv * cv) >> 13);
+        dst[3] = 255;
+        dst += 4;
+    }
+}
+
+static inline uint8_t lumaScalar(const uint8_t* bgra, const RGBToYUVCoeffs& k)
+{
+    return clampByte((k.yr * bgra[2] + k.yg * bgra[1] + k.yb * bgra[0] + k.yRound) >> 15);
+}
+
+static void bgraToI420RowsScalar(const uint8_t* src0, const uint8_t* src1, uint8_t* y0, uint8_t* y1, uint8_t* u, uint8_t* v, int width, const RGBToYUVCoeffs& k)
+{
+    for (int x = 0; x < width; x += 2)
+    {
+        const uint8_t* a = src0 + x * 4;
+        const uint8_t* b = src1 + x * 4;
+        int next = (x + 1 < width) ? 4 : 0;     //Ϊʱһ
+
+        y0[x] = lumaScalar(a, k);
+        y1[x] = lumaScalar(b, k);
+        if (next != 0)
+        {
+            y0[x + 1] = lumaScalar(a + next, k);
+            y1[x + 1] = lumaScalar(b + next, k);
+        }
+
+        int sb = a[0] + a[next] + b[0] + b[next];
+        int sg = a[1] + a[next + 1] + b[1] + b[next + 1];
+        int sr = a[2] + a[next + 2] + b[2] + b[next + 2];
+        u[x >> 1] = clampByte((k.ur * sr + k.ug * sg + k.ub * sb + kChromaRound) >> 17);
+        v[x >> 1] = clampByte((k.vr * sr + k.vg * sg + k.vb * sb + kChromaRound) >> 17);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////SSE2/AVX2 ʵ
+//
+//ʵֵһ (width - ) ȡżʼǰһصظдͬĽ
+//ֻпΪʱʣµһнʵ֡AVX2 β SSE2 ʵָ֣лĿ
+
+#if defined(VIDEO_CONVERT_X86)
+
+// 16 λϵ _mm_madd_epi16 һԳlo żλáhi λ
+static inline int32_t coeffPair(int16_t lo, int16_t hi)
+{
+    return (int32_t)(((uint32_t)(uint16_t)hi << 16) | (uint16_t)lo);
+}
+
+static bool cpuSupportsAVX2()
+{
+#ifdef _MSC_VER
+    int info[4] = { 0 };
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+    __cpuid(info, 1);
+    //AVX  OSXSAVE Ҫ֧֣ϵͳ YMM Ĵ
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0)
+        return false;
+    if ((_xgetbv(0) & 6) != 6)
+        return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (__get_cpuid_max(0, NULL) < 7)
+        return false;
+    __cpuid(1, eax, ebx, ecx, edx);
+    if ((ecx & (1u << 27)) == 0 || (ecx & (1u << 28)) == 0)
+        return false;
+    unsigned int xcr0 = 0, xcr0High = 0;
+    __asm__ volatile("xgetbv" : "=a"(xcr0), "=d"(xcr0High) : "c"(0));
+    if ((xcr0 & 6) != 6)
+        return false;
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    return (ebx & (1u << 5)) != 0;
+#endif
+}
+
+//16 ص BGR  16 ֽڣ֯ BGRA д
+static inline void storeBGRASSE2(__m128i b8, __m128i g8, __m128i r8, __m128i a8, uint8_t* dst)
+{
+    __m128i bgLo = _mm_unpacklo_epi8(b8, g8);
+    __m128i bgHi = _mm_unpackhi_epi8(b8, g8);
+    __m128i raLo = _mm_unpacklo_epi8(r8, a8);
+    __m128i raHi = _mm_unpackhi_epi8(r8, a8);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi16(bgLo, raLo));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 16), _mm_unpackhi_epi16(bgLo, raLo));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 32), _mm_unpacklo_epi16(bgHi, raHi));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 48), _mm_unpackhi_epi16(bgHi, raHi));
+}
+
+static void i420ToBGRARowSSE2(const uint8_t* y, const uint8_t* u, const uint8_t* v, uint8_t* dst, int width, const YUVToRGBCoeffs& k)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i alpha = _mm_set1_epi8((char)0xFF);
+    const __m128i yOffset = _mm_set1_epi16(k.yOffset);
+    const __m128i chromaBias = _mm_set1_epi16(128);
+    //Y 볣 1 ֯ (yk, )UV ֯˶Ӧһϵ
+    const __m128i yCoeff = _mm_set1_epi32(coeffPair(k.yk, (int16_t)kYUVRound));
+    const __m128i rCoeff = _mm_set1_epi32(coeffPair(0, k.rv));
+    const __m128i gCoeff = _mm_set1_epi32(coeffPair(k.gu, k.gv));
+    const __m128i bCoeff = _mm_set1_epi32(coeffPair(k.bu, 0));
+
+    const int lastX = (width - 16) & ~1;
+    int x = 0;
+    for (; width >= 16; x = std::min(x + 16, lastX))
+    {
+        __m128i y8 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + x));
+        __m128i u16 = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(u + x / 2)), zero), chromaBias);
+        __m128i v16 = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(v + x / 2)), zero), chromaBias);
+        __m128i uv[2] = { _mm_unpacklo_epi16(u16, v16), _mm_unpackhi_epi16(u16, v16) };
+
+        __m128i yLo = _mm_sub_epi16(_mm_unpacklo_epi8(y8, zero), yOffset);
+        __m128i yHi = _mm_sub_epi16(_mm_unpackhi_epi8(y8, zero), yOffset);
+        __m128i yt[4] = {
+            _mm_madd_epi16(_mm_unpacklo_epi16(yLo, one), yCoeff),
+            _mm_madd_epi16(_mm_unpackhi_epi16(yLo, one), yCoeff),
+            _mm_madd_epi16(_mm_unpacklo_epi16(yHi, one), yCoeff),
+            _mm_madd_epi16(_mm_unpackhi_epi16(yHi, one), yCoeff),
+        };
+
+        __m128i r[4], g[4], b[4];
+        for (int i = 0; i < 2; ++i)
+        {
+            //ÿɫӦ
+            __m128i rc = _mm_madd_epi16(uv[i], rCoeff);
+            __m128i gc = _mm_madd_epi16(uv[i], gCoeff);
+            __m128i bc = _mm_madd_epi16(uv[i], bCoeff);
+            r[2 * i] = _mm_srai_epi32(_mm_add_epi32(yt[2 * i], _mm_unpacklo_epi32(rc, rc)), 13);
+            r[2 * i + 1] = _mm_srai_epi32(_mm_add_epi32(yt[2 * i + 1], _mm_unpackhi_epi32(rc, rc)), 13);
+            g[2 * i] = _mm_srai_epi32(_mm_add_epi32(yt[2 * i], _mm_unpacklo_epi32(gc, gc)), 13);
+            g[2 * i + 1] = _mm_srai_epi32(_mm_add_epi32(yt[2 * i + 1], _mm_unpackhi_epi32(gc, gc)), 13);
+            b[2 * i] = _mm_srai_epi32(_mm_add_epi32(yt[2 * i], _mm_unpacklo_epi32(bc, bc)), 13);
+            b[2 * i + 1] = _mm_srai_epi32(_mm_add_epi32(yt[2 * i + 1], _mm_unpackhi_epi32(bc, bc)), 13);
+        }
+
+        __m128i r8 = _mm_packus_epi16(_mm_packs_epi32(r[0], r[1]), _mm_packs_epi32(r[2], r[3]));
+        __m128i g8 = _mm_packus_epi16(_mm_packs_epi32(g[0], g[1]), _mm_packs_epi32(g[2], g[3]));
+        __m128i b8 = _mm_packus_epi16(_mm_packs_epi32(b[0], b[1]), _mm_packs_epi32(b[2], b[3]));
+        storeBGRASSE2(b8, g8, r8, alpha, dst + x * 4);
+        if (x == lastX)
+        {
+            x += 16;
+            break;
+        }
+    }
+
+    if (x < width)
+        i420ToBGRARowScalar(y + x, u + x / 2, v + x / 2, dst + x * 4, width - x, k);
+}
+
+//pairApairB ص 16 λ BGRAĸ coeff ĵ˳Ϊ A0 A1 B0 B1
+static inline __m128i dotPixelsSSE2(__m128i pairA, __m128i pairB, __m128i coeff)
+{
+    __m128i a = _mm_shuffle_epi32(_mm_madd_epi16(pairA, coeff), _MM_SHUFFLE(3, 1, 2, 0));
+    __m128i b = _mm_shuffle_epi32(_mm_madd_epi16(pairB, coeff), _MM_SHUFFLE(3, 1, 2, 0));
+    return _mm_add_epi32(_mm_unpacklo_epi64(a, b), _mm_unpackhi_epi64(a, b));
+}
+
+static inline void storeLumaSSE2(const __m128i* pixels, uint8_t* dst, __m128i yCoeff, __m128i yRound)
+{
+    __m128i l[4];
+    for (int i = 0; i < 4; ++i)
+        l[i] = _mm_srai_epi32(_mm_add_epi32(dotPixelsSSE2(pixels[2 * i], pixels[2 * i + 1], yCoeff), yRound), 15);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(_mm_packs_epi32(l[0], l[1]), _mm_packs_epi32(l[2], l[3])));
+}
+
+static inline void storeChromaSSE2(const __m128i* sums, uint8_t* dst, __m128i coeff, __m128i round)
+{
+    __m128i lo = _mm_srai_epi32(_mm_add_epi32(dotPixelsSSE2(sums[0], sums[1], coeff), round), 17);
+    __m128i hi = _mm_srai_epi32(_mm_add_epi32(dotPixelsSSE2(sums[2], sums[3], coeff), round), 17);
+    __m128i c16 = _mm_packs_epi32(lo, hi);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(c16, c16));
+}
+
+static void bgraToI420RowsSSE2(const uint8_t* src0, const uint8_t* src1, uint8_t* y0, uint8_t* y1, uint8_t* u, uint8_t* v, int width, const RGBToYUVCoeffs& k)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i yCoeff = _mm_set_epi16(0, k.yr, k.yg, k.yb, 0, k.yr, k.yg, k.yb);
+    const __m128i uCoeff = _mm_set_epi16(0, k.ur, k.ug, k.ub, 0, k.ur, k.ug, k.ub);
+    const __m128i vCoeff = _mm_set_epi16(0, k.vr, k.vg, k.vb, 0, k.vr, k.vg, k.vb);
+    const __m128i yRound = _mm_set1_epi32(k.yRound);
+    const __m128i chromaRound = _mm_set1_epi32(kChromaRound);
+
+    const int lastX = (width - 16) & ~1;
+    int x = 0;
+    for (; width >= 16; x = std::min(x + 16, lastX))
+    {
+        //ÿԪչ 16 λ BGRA
+        __m128i p0[8], p1[8];
+        for (int i = 0; i < 4; ++i)
+        {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src0 + x * 4 + i * 16));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src1 + x * 4 + i * 16));
+            p0[2 * i] = _mm_unpacklo_epi8(a, zero);
+            p0[2 * i + 1] = _mm_unpackhi_epi8(a, zero);
+            p1[2 * i] = _mm_unpacklo_epi8(b, zero);
+            p1[2 * i + 1] = _mm_unpackhi_epi8(b, zero);
+        }
+        storeLumaSSE2(p0, y0 + x, yCoeff, yRound);
+        storeLumaSSE2(p1, y1 + x, yCoeff, yRound);
+
+        //ӺҲӣõ 2x2 ֮ͣÿԪطɫ
+        __m128i sums[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            __m128i s0 = _mm_add_epi16(p0[2 * i], p1[2 * i]);
+            __m128i s1 = _mm_add_epi16(p0[2 * i + 1], p1[2 * i + 1]);
+            s0 = _mm_add_epi16(s0, _mm_srli_si128(s0, 8));
+            s1 = _mm_add_epi16(s1, _mm_srli_si128(s1, 8));
+            sums[i] = _mm_unpacklo_epi64(s0, s1);
+        }
+        storeChromaSSE2(sums, u + x / 2, uCoeff, chromaRound);
+        storeChromaSSE2(sums, v + x / 2, vCoeff, chromaRound);
+        if (x == lastX)
+        {
+            x += 16;
+            break;
+        }
+    }
+
+    if (x < width)
+        bgraToI420RowsScalar(src0 + x * 4, src1 + x * 4, y0 + x, y1 + x, u + x / 2, v + x / 2, width - x, k);
+}
+
+//AVX2  unpack/pack ֻڸԵ 128 λڽУע "Ͱ | ߰" ÿĴ
+VIDEO_CONVERT_AVX2_TARGET
+static void i420ToBGRARowAVX2(const uint8_t* y, const uint8_t* u, const uint8_t* v, uint8_t* dst, int width, const YUVToRGBCoeffs& k)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi16(1);
+    const __m256i alpha = _mm256_set1_epi8((char)0xFF);
+    const __m256i yOffset = _mm256_set1_epi16(k.yOffset);
+    const __m256i chromaBias = _mm256_set1_epi16(128);
+    const __m256i yCoeff = _mm256_set1_epi32(coeffPair(k.yk, (int16_t)kYUVRound));
+    const __m256i rCoeff = _mm256_set1_epi32(coeffPair(0, k.rv));
+    const __m256i gCoeff = _mm256_set1_epi32(coeffPair(k.gu, k.gv));
+    const __m256i bCoeff = _mm256_set1_epi32(coeffPair(k.bu, 0));
+
+    const int lastX = (width - 32) & ~1;
+    int x = 0;
+    for (; width >= 32; x = std::min(x + 32, lastX))
+    {
+        __m256i y8 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + x));
+        //ɫ 0~15 ˳չ֯Ϊ 0~3 | 8~11  4~7 | 12~15
+        __m256i u16 = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(u + x / 2))), chromaBias);
+        __m256i v16 = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(v + x / 2))), chromaBias);
+        __m256i uv[2] = { _mm256_unpacklo_epi16(u16, v16), _mm256_unpackhi_epi16(u16, v16) };
+
+        //ȣ0~7 | 16~23  8~15 | 24~31ٷֳ 0~3 | 16~194~7 | 20~238~11 | 24~2712~15 | 28~31ɫȸƺλһ
+        __m256i yLo = _mm256_sub_epi16(_mm256_unpacklo_epi8(y8, zero), yOffset);
+        __m256i yHi = _mm256_sub_epi16(_mm256_unpackhi_epi8(y8, zero), yOffset);
+        __m256i yt[4] = {
+            _mm256_madd_epi16(_mm256_unpacklo_epi16(yLo, one), yCoeff),
+            _mm256_madd_epi16(_mm256_unpackhi_epi16(yLo, one), yCoeff),
+            _mm256_madd_epi16(_mm256_unpacklo_epi16(yHi, one), yCoeff),
+            _mm256_madd_epi16(_mm256_unpackhi_epi16(yHi, one), yCoeff),
+        };
+
+        __m256i r[4], g[4], b[4];
+        for (int i = 0; i < 2; ++i)
+        {
+            __m256i rc = _mm256_madd_epi16(uv[i], rCoeff);
+            __m256i gc = _mm256_madd_epi16(uv[i], gCoeff);
+            __m256i bc = _mm256_madd_epi16(uv[i], bCoeff);
+            r[2 * i] = _mm256_srai_epi32(_mm256_add_epi32(yt[2 * i], _mm256_unpacklo_epi32(rc, rc)), 13);
+            r[2 * i + 1] = _mm256_srai_epi32(_mm256_add_epi32(yt[2 * i + 1], _mm256_unpackhi_epi32(rc, rc)), 13);
+            g[2 * i] = _mm256_srai_epi32(_mm256_add_epi32(yt[2 * i], _mm256_unpacklo_epi32(gc, gc)), 13);
+            g[2 * i + 1] = _mm256_srai_epi32(_mm256_add_epi32(yt[2 * i + 1], _mm256_unpackhi_epi32(gc, gc)), 13);
+            b[2 * i] = _mm256_srai_epi32(_mm256_add_epi32(yt[2 * i], _mm256_unpacklo_epi32(bc, bc)), 13);
+            b[2 * i + 1] = _mm256_srai_epi32(_mm256_add_epi32(yt[2 * i + 1], _mm256_unpackhi_epi32(bc, bc)), 13);
+        }
+
+        // pack ָΪ 0~15 | 16~31 Ȼ˳
+        __m256i r8 = _mm256_packus_epi16(_mm256_packs_epi32(r[0], r[1]), _mm256_packs_epi32(r[2], r[3]));
+        __m256i g8 = _mm256_packus_epi16(_mm256_packs_epi32(g[0], g[1]), _mm256_packs_epi32(g[2], g[3]));
+        __m256i b8 = _mm256_packus_epi16(_mm256_packs_epi32(b[0], b[1]), _mm256_packs_epi32(b[2], b[3]));
+
+        __m256i bgLo = _mm256_unpacklo_epi8(b8, g8);
+        __m256i bgHi = _mm256_unpackhi_epi8(b8, g8);
+        __m256i raLo = _mm256_unpacklo_epi8(r8, alpha);
+        __m256i raHi = _mm256_unpackhi_epi8(r8, alpha);
+        __m256i q0 = _mm256_unpacklo_epi16(bgLo, raLo);    //0~3 | 16~19
+        __m256i q1 = _mm256_unpackhi_epi16(bgLo, raLo);    //4~7 | 20~23
+        __m256i q2 = _mm256_unpacklo_epi16(bgHi, raHi);    //8~11 | 24~27
+        __m256i q3 = _mm256_unpackhi_epi16(bgHi, raHi);    //12~15 | 28~31
+        uint8_t* out = dst + x * 4;
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_permute2x128_si256(q0, q1, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 32), _mm256_permute2x128_si256(q2, q3, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 64), _mm256_permute2x128_si256(q0, q1, 0x31));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 96), _mm256_permute2x128_si256(q2, q3, 0x31));
+        if (x == lastX)
+        {
+            x += 32;
+            break;
+        }
+    }
+
+    if (x < width)
+        i420ToBGRARowScalar(y + x, u + x / 2, v + x / 2, dst + x * 4, width - x, k);
+}
+
+// dotPixelsSSE2 ͬ 128 λڷֱУٰ order ųȻ˳
+VIDEO_CONVERT_AVX2_TARGET
+static inline __m256i dotPixelsAVX2(__m256i pairA, __m256i pairB, __m256i coeff, __m256i order)
+{
+    __m256i a = _mm256_shuffle_epi32(_mm256_madd_epi16(pairA, coeff), _MM_SHUFFLE(3, 1, 2, 0));
+    __m256i b = _mm256_shuffle_epi32(_mm256_madd_epi16(pairB, coeff), _MM_SHUFFLE(3, 1, 2, 0));
+    return _mm256_permutevar8x32_epi32(_mm256_add_epi32(_mm256_unpacklo_epi64(a, b), _mm256_unpackhi_epi64(a, b)), order);
+}
+
+//8  32 λͳ 8  16 λ
+VIDEO_CONVERT_AVX2_TARGET
+static inline __m128i packs256To128(__m256i value)
+{
+    return _mm_packs_epi32(_mm256_castsi256_si128(value), _mm256_extracti128_si256(value, 1));
+}
+
+VIDEO_CONVERT_AVX2_TARGET
+static void bgraToI420RowsAVX2(const uint8_t* src0, const uint8_t* src1, uint8_t* y0, uint8_t* y1, uint8_t* u, uint8_t* v, int width, const RGBToYUVCoeffs& k)
+{
+    const __m256i yCoeff = _mm256_setr_epi16(k.yb, k.yg, k.yr, 0, k.yb, k.yg, k.yr, 0, k.yb, k.yg, k.yr, 0, k.yb, k.yg, k.yr, 0);
+    const __m256i uCoeff = _mm256_setr_epi16(k.ub, k.ug, k.ur, 0, k.ub, k.ug, k.ur, 0, k.ub, k.ug, k.ur, 0, k.ub, k.ug, k.ur, 0);
+    const __m256i vCoeff = _mm256_setr_epi16(k.vb, k.vg, k.vr, 0, k.vb, k.vg, k.vr, 0, k.vb, k.vg, k.vr, 0, k.vb, k.vg, k.vr, 0);
+    const __m256i yRound = _mm256_set1_epi32(k.yRound);
+    const __m256i chromaRound = _mm256_set1_epi32(kChromaRound);
+    //ȵΪ 0 1 4 5 | 2 3 6 7ɫȵΪ 0 2 4 6 | 1 3 5 7
+    const __m256i lumaOrder = _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7);
+    const __m256i chromaOrder = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+    const int lastX = (width - 16) & ~1;
+    int x = 0;
+    for (; width >= 16; x = std::min(x + 16, lastX))
+    {
+        //p[i] Ϊ 4i4i+1 | 4i+24i+3
+        __m256i p0[4], p1[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            p0[i] = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src0 + x * 4 + i * 16)));
+            p1[i] = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src1 + x * 4 + i * 16)));
+        }
+
+        const __m256i* rows[2] = { p0, p1 };
+        uint8_t* lumaDst[2] = { y0 + x, y1 + x };
+        for (int row = 0; row < 2; ++row)
+        {
+            const __m256i* p = rows[row];
+            __m256i lo = _mm256_srai_epi32(_mm256_add_epi32(dotPixelsAVX2(p[0], p[1], yCoeff, lumaOrder), yRound), 15);
+            __m256i hi = _mm256_srai_epi32(_mm256_add_epi32(dotPixelsAVX2(p[2], p[3], yCoeff, lumaOrder), yRound), 15);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(lumaDst[row]), _mm_packus_epi16(packs256To128(lo), packs256To128(hi)));
+        }
+
+        //h[i] ĵ 64 λΪɫ 2i | 2i+1
+        __m256i h[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            __m256i s = _mm256_add_epi16(p0[i], p1[i]);
+            h[i] = _mm256_add_epi16(s, _mm256_srli_si256(s, 8));
+        }
+        __m256i c01 = _mm256_unpacklo_epi64(h[0], h[1]);   //0 2 | 1 3
+        __m256i c23 = _mm256_unpacklo_epi64(h[2], h[3]);   //4 6 | 5 7
+
+        __m256i cu = _mm256_srai_epi32(_mm256_add_epi32(dotPixelsAVX2(c01, c23, uCoeff, chromaOrder), chromaRound), 17);
+        __m256i cv = _mm256_srai_epi32(_mm256_add_epi32(dotPixelsAVX2(c01, c23, vCoeff, chromaOrder), chromaRound), 17);
+        __m128i u16 = packs256To128(cu);
+        __m128i v16 = packs256To128(cv);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(u + x / 2), _mm_packus_epi16(u16, u16));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(v + x / 2), _mm_packus_epi16(v16, v16));
+        if (x == lastX)
+        {
+            x += 16;
+            break;
+        }
+    }
+
+    if (x < width)
+        bgraToI420RowsScalar(src0 + x * 4, src1 + x * 4, y0 + x, y1 + x, u + x / 2, v + x / 2, width - x, k);
+}
+
+#endif
+
+//////////////////////////////////////////////////////////////////////////NEON ʵ
+
+#if defined(VIDEO_CONVERT_NEON)
+
+static void i420ToBGRARowNEON(const uint8_t* y, const uint8_t* u, const uint8_t* v, uint8_t* dst, int width, const YUVToRGBCoeffs& k)
+{
+    const int16x8_t yOffset = vdupq_n_s16(k.yOffset);
+    const int16x8_t chromaBias = vdupq_n_s16(128);
+    const int32x4_t round = vdupq_n_s32(kYUVRound);
+
+    const int lastX = (width - 16) & ~1;
+    int x = 0;
+    for (; width >= 16; x = std::min(x + 16, lastX))
+    {
+        uint8x16_t y8 = vld1q_u8(y + x);
+        int16x8_t u16 = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(u + x / 2))), chromaBias);
+        int16x8_t v16 = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(v + x / 2))), chromaBias);
+        int16x8_t yLo = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(y8))), yOffset);
+        int16x8_t yHi = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(y8))), yOffset);
+        int16x4_t yParts[4] = { vget_low_s16(yLo), vget_high_s16(yLo), vget_low_s16(yHi), vget_high_s16(yHi) };
+        int16x4_t uParts[2] = { vget_low_s16(u16), vget_high_s16(u16) };
+        int16x4_t vParts[2] = { vget_low_s16(v16), vget_high_s16(v16) };
+
+        int16x4_t r[4], g[4], b[4];
+        for (int i = 0; i < 2; ++i)
+        {
+            //ÿɫƸ
+            int32x4x2_t rc = vzipq_s32(vmull_n_s16(vParts[i], k.rv), vmull_n_s16(vParts[i], k.rv));
+            int32x4_t gcValue = vmlal_n_s16(vmull_n_s16(uParts[i], k.gu), vParts[i], k.gv);
+            int32x4x2_t gc = vzipq_s32(gcValue, gcValue);
+            int32x4x2_t bc = vzipq_s32(vmull_n_s16(uParts[i], k.bu), vmull_n_s16(uParts[i], k.bu));
+            for (int j = 0; j < 2; ++j)
+            {
+                int32x4_t yt = vmlal_n_s16(round, yParts[2 * i + j], k.yk);
+                r[2 * i + j] = vqmovn_s32(vshrq_n_s32(vaddq_s32(yt, rc.val[j]), 13));
+                g[2 * i + j] = vqmovn_s32(vshrq_n_s32(vaddq_s32(yt, gc.val[j]), 13));
+                b[2 * i + j] = vqmovn_s32(vshrq_n_s32(vaddq_s32(yt, bc.val[j]), 13));
+            }
+        }
+
+        uint8x16x4_t bgra;
+        bgra.val[0] = vcombine_u8(vqmovun_s16(vcombine_s16(b[0], b[1])), vqmovun_s16(vcombine_s16(b[2], b[3])));
+        bgra.val[1] = vcombine_u8(vqmovun_s16(vcombine_s16(g[0], g[1])), vqmovun_s16(vcombine_s16(g[2], g[3])));
+        bgra.val[2] = vcombine_u8(vqmovun_s16(vcombine_s16(r[0], r[1])), vqmovun_s16(vcombine_s16(r[2], r[3])));
+        bgra.val[3] = vdupq_n_u8(255);
+        vst4q_u8(dst + x * 4, bgra);
+        if (x == lastX)
+        {
+            x += 16;
+            break;
+        }
+    }
+
+    if (x < width)
+        i420ToBGRARowScalar(y + x, u + x / 2, v + x / 2, dst + x * 4, width - x, k);
+}
+
+static inline int16x4_t lumaNEON(int16x4_t b, int16x4_t g, int16x4_t r, const RGBToYUVCoeffs& k)
+{
+    int32x4_t sum = vmlal_n_s16(vmlal_n_s16(vmlal_n_s16(vdupq_n_s32(k.yRound), b, k.yb), g, k.yg), r, k.yr);
+    return vqmovn_s32(vshrq_n_s32(sum, 15));
+}
+
+static inline void storeLumaNEON(const uint8x16x4_t& pixels, uint8_t* dst, const RGBToYUVCoeffs& k)
+{
+    int16x8_t b[2] = { vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(pixels.val[0]))), vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(pixels.val[0]))) };
+    int16x8_t g[2] = { vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(pixels.val[1]))), vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(pixels.val[1]))) };
+    int16x8_t r[2] = { vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(pixels.val[2]))), vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(pixels.val[2]))) };
+    uint8x8_t out[2];
+    for (int i = 0; i < 2; ++i)
+    {
+        int16x4_t lo = lumaNEON(vget_low_s16(b[i]), vget_low_s16(g[i]), vget_low_s16(r[i]), k);
+        int16x4_t hi = lumaNEON(vget_high_s16(b[i]), vget_high_s16(g[i]), vget_high_s16(r[i]), k);
+        out[i] = vqmovun_s16(vcombine_s16(lo, hi));
+    }
+    vst1q_u8(dst, vcombine_u8(out[0], out[1]));
+}
+
+static inline uint8x8_t chromaNEON(int16x8_t sr, int16x8_t sg, int16x8_t sb, int16_t cr, int16_t cg, int16_t cb)
+{
+    const int32x4_t round = vdupq_n_s32(kChromaRound);
+    int32x4_t lo = vmlal_n_s16(vmlal_n_s16(vmlal_n_s16(round, vget_low_s16(sr), cr), vget_low_s16(sg), cg), vget_low_s16(sb), cb);
+    int32x4_t hi = vmlal_n_s16(vmlal_n_s16(vmlal_n_s16(round, vget_high_s16(sr), cr), vget_high_s16(sg), cg), vget_high_s16(sb), cb);
+    return vqmovun_s16(vcombine_s16(vqmovn_s32(vshrq_n_s32(lo, 17)), vqmovn_s32(vshrq_n_s32(hi, 17))));
+}
+
+static void bgraToI420RowsNEON(const uint8_t* src0, const uint8_t* src1, uint8_t* y0, uint8_t* y1, uint8_t* u, uint8_t* v, int width, const RGBToYUVCoeffs& k)
+{
+    const int lastX = (width - 16) & ~1;
+    int x = 0;
+    for (; width >= 16; x = std::min(x + 16, lastX))
+    {
+        uint8x16x4_t a = vld4q_u8(src0 + x * 4);
+        uint8x16x4_t b = vld4q_u8(src1 + x * 4);
+        storeLumaNEON(a, y0 + x, k);
+        storeLumaNEON(b, y1 + x, k);
+
+        //ӺۼһУõ 2x2 ֮
+        int16x8_t sb = vreinterpretq_s16_u16(vpadalq_u8(vpaddlq_u8(a.val[0]), b.val[0]));
+        int16x8_t sg = vreinterpretq_s16_u16(vpadalq_u8(vpaddlq_u8(a.val[1]), b.val[1]));
+        int16x8_t sr = vreinterpretq_s16_u16(vpadalq_u8(vpaddlq_u8(a.val[2]), b.val[2]));
+        vst1_u8(u + x / 2, chromaNEON(sr, sg, sb, k.ur, k.ug, k.ub));
+        vst1_u8(v + x / 2, chromaNEON(sr, sg, sb, k.vr, k.vg, k.vb));
+        if (x == lastX)
+        {
+            x += 16;
+            break;
+        }
+    }
+
+    if (x < width)
+        bgraToI420RowsScalar(src0 + x * 4, src1 + x * 4, y0 + x, y1 + x, u + x / 2, v + x / 2, width - x, k);
+}
+
+#endif
+
+//////////////////////////////////////////////////////////////////////////TRTCVideoConvert
+
+static TRTCConvertKernel resolveKernel(TRTCConvertKernel kernel)
+{
+    if (kernel == TRTCConvertKernelAuto)
+        return TRTCVideoConvert::bestKernel();
+    return TRTCVideoConvert::isKernelSupported(kernel) ? kernel : TRTCConvertKernelScalar;
+}
+
+static ConvertKernelFuncs kernelFuncs(TRTCConvertKernel kernel)
+{
+    ConvertKernelFuncs funcs = { i420ToBGRARowScalar, bgraToI420RowsScalar };
+    switch (resolveKernel(kernel))
+    {
+#if defined(VIDEO_CONVERT_X86)
+    case TRTCConvertKernelSSE2:
+        funcs.i420ToBGRARow = i420ToBGRARowSSE2;
+        funcs.bgraToI420Rows = bgraToI420RowsSSE2;
+        break;
+    case TRTCConvertKernelAVX2:
+        funcs.i420ToBGRARow = i420ToBGRARowAVX2;
+        funcs.bgraToI420Rows = bgraToI420RowsAVX2;
+        break;
+#endif
+#if defined(VIDEO_CONVERT_NEON)
+    case TRTCConvertKernelNEON:
+        funcs.i420ToBGRARow = i420ToBGRARowNEON;
+        funcs.bgraToI420Rows = bgraToI420RowsNEON;
+        break;
+#endif
+    default:
+        break;
+    }
+    return funcs;
+}
+
+bool TRTCVideoConvert::isKernelSupported(TRTCConvertKernel kernel)
+{
+    switch (kernel)
+    {
+    case TRTCConvertKernelAuto:
+    case TRTCConvertKernelScalar:
+        return true;
+#if defined(VIDEO_CONVERT_X86)
+    case TRTCConvertKernelSSE2:
+        return true;
+    case TRTCConvertKernelAVX2:
+    {
+        static const bool bAVX2 = cpuSupportsAVX2();
+        return bAVX2;
+    }
+#endif
+#if defined(VIDEO_CONVERT_NEON)
+    case TRTCConvertKernelNEON:
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+TRTCConvertKernel TRTCVideoConvert::bestKernel()
+{
+    if (isKernelSupported(TRTCConvertKernelAVX2))
+        return TRTCConvertKernelAVX2;
+    if (isKernelSupported(TRTCConvertKernelSSE2))
+        return TRTCConvertKernelSSE2;
+    if (isKernelSupported(TRTCConvertKernelNEON))
+        return TRTCConvertKernelNEON;
+    return TRTCConvertKernelScalar;
+}
+
+const char* TRTCVideoConvert::kernelName(TRTCConvertKernel kernel)
+{
+    switch (kernel)
+    {
+    case TRTCConvertKernelAuto: return "auto";
+    case TRTCConvertKernelScalar: return "scalar";
+    case TRTCConvertKernelSSE2: return "sse2";
+    case TRTCConvertKernelAVX2: return "avx2";
+    case TRTCConvertKernelNEON: return "neon";
+    default: return "unknown";
+    }
+}
+
+uint32_t TRTCVideoConvert::frameLength(TRTCVideoPixelFormat format, uint32_t width, uint32_t height)
+{
+    if (format == TRTCVideoPixelFormat_I420)
+        return width * height + 2 * ((width + 1) / 2) * ((height + 1) / 2);
+    if (format == TRTCVideoPixelFormat_BGRA32)
+        return width * height * 4;
+    return 0;
+}
+
+void TRTCVideoConvert::i420ToBGRA(const uint8_t* srcY, int strideY, const uint8_t* srcU, int strideU, const uint8_t* srcV, int strideV,
+    uint8_t* dstBGRA, int strideBGRA, int width, int height, const TRTCColorSpace& colorSpace, TRTCConvertKernel kernel)
+{
+    if (width <= 0 || height <= 0)
+        return;
+
+    YUVToRGBCoeffs k = makeYUVToRGBCoeffs(colorSpace);
+    I420ToBGRARowFunc rowFunc = kernelFuncs(kernel).i420ToBGRARow;
+    for (int row = 0; row < height; ++row)
+    {
+        rowFunc(srcY + (ptrdiff_t)row * strideY, srcU + (ptrdiff_t)(row >> 1) * strideU, srcV + (ptrdiff_t)(row >> 1) * strideV,
+            dstBGRA + (ptrdiff_t)row * strideBGRA, width, k);
+    }
+}
+
+void TRTCVideoConvert::bgraToI420(const uint8_t* srcBGRA, int strideBGRA,
+    uint8_t* dstY, int strideY, uint8_t* dstU, int strideU, uint8_t* dstV, int strideV, int width, int height,
+    const TRTCColorSpace& colorSpace, TRTCConvertKernel kernel)
+{
+    if (width <= 0 || height <= 0)
+        return;
+
+    RGBToYUVCoeffs k = makeRGBToYUVCoeffs(colorSpace);
+    BGRAToI420RowsFunc rowsFunc = kernelFuncs(kernel).bgraToI420Rows;
+    for (int row = 0; row < height; row += 2)
+    {
+        const uint8_t* src0 = srcBGRA + (ptrdiff_t)row * strideBGRA;
+        uint8_t* y0 = dstY + (ptrdiff_t)row * strideY;
+        bool bLastOddRow = (row + 1 == height);
+        rowsFunc(src0, bLastOddRow ? src0 : src0 + strideBGRA, y0, bLastOddRow ? y0 : y0 + strideY,
+            dstU + (ptrdiff_t)(row >> 1) * strideU, dstV + (ptrdiff_t)(row >> 1) * strideV, width, k);
+    }
+}
+
+bool TRTCVideoConvert::convertFrame(const TRTCVideoFrame& src, TRTCVideoFrame& dst, const TRTCColorSpace& colorSpace, TRTCConvertKernel kernel)
+{
+    if (src.bufferType != TRTCVideoBufferType_Buffer || src.data == NULL || dst.data == NULL)
+        return false;
+
+    uint32_t srcLength = frameLength(src.videoFormat, src.width, src.height);
+    uint32_t dstLength = frameLength(dst.videoFormat, src.width, src.height);
+    if (srcLength == 0 || dstLength == 0 || src.length < srcLength || dst.length < dstLength)
+        return false;
+
+    int width = (int)src.width;
+    int height = (int)src.height;
+    int chromaWidth = (width + 1) / 2;
+    int chromaSize = chromaWidth * ((height + 1) / 2);
+    const uint8_t* srcData = reinterpret_cast<const uint8_t*>(src.data);
+    uint8_t* dstData = reinterpret_cast<uint8_t*>(dst.data);
+
+    if (src.videoFormat == dst.videoFormat)
+    {
+        memcpy(dstData, srcData, dstLength);
+    }
+    else if (src.videoFormat == TRTCVideoPixelFormat_I420)
+    {
+        const uint8_t* srcU = srcData + width * height;
+        i420ToBGRA(srcData, width, srcU, chromaWidth, srcU + chromaSize, chromaWidth,
+            dstData, width * 4, width, height, colorSpace, kernel);
+    }
+    else
+    {
+        uint8_t* dstU = dstData + width * height;
+        bgraToI420(srcData, width * 4, dstData, width, dstU, chromaWidth, dstU + chromaSize, chromaWidth,
+            width, height, colorSpace, kernel);
+    }
+
+    dst.bufferType = TRTCVideoBufferType_Buffer;
+    dst.length = dstLength;
+    dst.width = src.width;
+    dst.height = src.height;
+    dst.timestamp = src.timestamp;
+    dst.rotation = src.rotation;
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////ܲ
+
+struct BenchResolution
+{
+    TRTCVideoResolution resolution;
+    uint32_t width;
+    uint32_t height;
+};
+
+static const BenchResolution kBenchResolutions[] = {
+    { TRTCVideoResolution_120_120, 120, 120 },
+    { TRTCVideoResolution_160_160, 160, 160 },
+    { TRTCVideoResolution_270_270, 270, 270 },
+    { TRTCVideoResolution_480_480, 480, 480 },
+    { TRTCVideoResolution_160_120, 160, 120 },
+    { TRTCVideoResolution_240_180, 240, 180 },
+    { TRTCVideoResolution_280_210, 280, 210 },
+    { TRTCVideoResolution_320_240, 320, 240 },
+    { TRTCVideoResolution_400_300, 400, 300 },
+    { TRTCVideoResolution_480_360, 480, 360 },
+    { TRTCVideoResolution_640_480, 640, 480 },
+    { TRTCVideoResolution_960_720, 960, 720 },
+    { TRTCVideoResolution_160_90, 160, 90 },
+    { TRTCVideoResolution_256_144, 256, 144 },
+    { TRTCVideoResolution_320_180, 320, 180 },
+    { TRTCVideoResolution_480_270, 480, 270 },
+    { TRTCVideoResolution_640_360, 640, 360 },
+    { TRTCVideoResolution_960_540, 960, 540 },
+    { TRTCVideoResolution_1280_720, 1280, 720 },
+    { TRTCVideoResolution_1920_1080, 1920, 1080 },
+};
+
+static TRTCVideoFrame makeBenchFrame(TRTCVideoPixelFormat format, std::vector<char>& buffer, uint32_t width, uint32_t height)
+{
+    TRTCVideoFrame frame;
+    frame.videoFormat = format;
+    frame.bufferType = TRTCVideoBufferType_Buffer;
+    frame.data = buffer.data();
+    frame.length = (uint32_t)buffer.size();
+    frame.width = width;
+    frame.height = height;
+    return frame;
+}
+
+std::vector<TRTCVideoConvertBenchResult> TRTCVideoConvert::runBenchmark(uint32_t durationMs)
+{
+    static const TRTCConvertKernel kKernels[] = { TRTCConvertKernelScalar, TRTCConvertKernelSSE2, TRTCConvertKernelAVX2, TRTCConvertKernelNEON };
+    TRTCColorSpace colorSpaces[4];
+    colorSpaces[1].range = TRTCColorRangeFull;
+    colorSpaces[2].matrix = TRTCColorMatrixBT709;
+    colorSpaces[3].matrix = TRTCColorMatrixBT709;
+    colorSpaces[3].range = TRTCColorRangeFull;
+
+    std::vector<TRTCVideoConvertBenchResult> results;
+    std::mt19937 random(20190101);
+    for (size_t i = 0; i < _countof(kBenchResolutions); ++i)
+    {
+        uint32_t width = kBenchResolutions[i].width;
+        uint32_t height = kBenchResolutions[i].height;
+
+        //ݸǱͽضϵĸ
+        std::vector<char> i420(frameLength(TRTCVideoPixelFormat_I420, width, height));
+        std::vector<char> bgra(frameLength(TRTCVideoPixelFormat_BGRA32, width, height));
+        for (size_t j = 0; j < i420.size(); ++j)
+            i420[j] = (char)random();
+        for (size_t j = 0; j < bgra.size(); ++j)
+            bgra[j] = (char)random();
+
+        //ʵɫʿռµΪ
+        std::vector<char> refBGRA[4], refI420[4];
+        for (int cs = 0; cs < 4; ++cs)
+        {
+            refBGRA[cs].resize(bgra.size());
+            refI420[cs].resize(i420.size());
+            TRTCVideoFrame toBGRA = makeBenchFrame(TRTCVideoPixelFormat_BGRA32, refBGRA[cs], width, height);
+            TRTCVideoFrame toI420 = makeBenchFrame(TRTCVideoPixelFormat_I420, refI420[cs], width, height);
+            convertFrame(makeBenchFrame(TRTCVideoPixelFormat_I420, i420, width, height), toBGRA, colorSpaces[cs], TRTCConvertKernelScalar);
+            convertFrame(makeBenchFrame(TRTCVideoPixelFormat_BGRA32, bgra, width, height), toI420, colorSpaces[cs], TRTCConvertKernelScalar);
+        }
+
+        for (size_t j = 0; j < _countof(kKernels); ++j)
+        {
+            TRTCConvertKernel kernel = kKernels[j];
+            if (!isKernelSupported(kernel))
+                continue;
+
+            TRTCVideoConvertBenchResult result;
+            result.resolution = kBenchResolutions[i].resolution;
+            result.width = width;
+            result.height = height;
+            result.kernel = kernel;
+
+            std::vector<char> outBGRA(bgra.size());
+            std::vector<char> outI420(i420.size());
+            TRTCVideoFrame srcI420 = makeBenchFrame(TRTCVideoPixelFormat_I420, i420, width, height);
+            TRTCVideoFrame srcBGRA = makeBenchFrame(TRTCVideoPixelFormat_BGRA32, bgra, width, height);
+            TRTCVideoFrame dstBGRA = makeBenchFrame(TRTCVideoPixelFormat_BGRA32, outBGRA, width, height);
+            TRTCVideoFrame dstI420 = makeBenchFrame(TRTCVideoPixelFormat_I420, outI420, width, height);
+
+            for (int cs = 0; cs < 4 && kernel != TRTCConvertKernelScalar; ++cs)
+            {
+                convertFrame(srcI420, dstBGRA, colorSpaces[cs], kernel);
+                convertFrame(srcBGRA, dstI420, colorSpaces[cs], kernel);
+                if (outBGRA != refBGRA[cs] || outI420 != refI420[cs])
+                    result.bMatchScalar = false;
+            }
+
+            result.i420ToBGRAMs = MeasureAverageMs(durationMs, [&]() {
+                convertFrame(srcI420, dstBGRA, colorSpaces[0], kernel);
+            });
+            result.bgraToI420Ms = MeasureAverageMs(durationMs, [&]() {
+                convertFrame(srcBGRA, dstI420, colorSpaces[0], kernel);
+            });
+            results.push_back(result);
+        }
+    }
+    return results;
+}
+
+std::string TRTCVideoConvert::formatBenchmark(const std::vector<TRTCVideoConvertBenchResult>& results)
+{
+    std::string report;
+    format_to(report, "%10s %7s %12s %8s %12s %8s %6s\r\n",
+        "resolution", "kernel", "i420>bgra ms", "Mpix/s", "bgra>i420 ms", "Mpix/s", "match");
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const TRTCVideoConvertBenchResult& r = results[i];
+        double megaPixels = (double)r.width * r.height / 1000000.0;
+        char resolution[32] = { 0 };
+        _snprintf_s(resolution, _countof(resolution), _TRUNCATE, "%ux%u", r.width, r.height);
+        format_to(report, "%10s %7s %12.3f %8.1f %12.3f %8.1f %6s\r\n",
+            resolution, kernelName(r.kernel),
+            r.i420ToBGRAMs, r.i420ToBGRAMs > 0 ? megaPixels * 1000.0 / r.i420ToBGRAMs : 0.0,
+            r.bgraToI420Ms, r.bgraToI420Ms > 0 ? megaPixels * 1000.0 / r.bgraToI420Ms : 0.0,
+            r.bMatchScalar ? "yes" : "NO");
+    }
+    return report;
+}
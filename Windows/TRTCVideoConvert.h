@@ -0,0 +1,90 @@
+#pragma once
+/*
+* Module:   TRTCVideoConvert
+*
+* Function: LiteAVVideoFrame  I420  BGRA32 ת ITRTCVideoRenderCallback ʹ÷ CPU ϴ
+*
+*    1. ֧ BT.601/BT.709 ־ limited(16~235)/full(0~255) ַΧYUV ת RGB ϵȡ 13 λ㣬
+*       RGB ת YUV ȡ 15 λ㣬м 32 λ
+*
+*    2. ͬһ׶㹫ʽбSSE2AVX2NEON ĸʵ֣ʵʵֵֽһ£
+*       TRTCConvertKernelAuto ʱ CPU ѡʵ֡
+*
+*    3. BGRA32 ת I420 ʱɫȡ 2x2 صƽֵΪʱһ/һаظؼ㡣
+*
+*    4. runBenchmark  TRTCVideoResolution ÿһֱַʲʵֵĵ֡ʱУɫʿռʵֵһ¡
+*/
+
+#include "TRTCCloudDef.h"
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+enum TRTCColorMatrix
+{
+    TRTCColorMatrixBT601,
+    TRTCColorMatrixBT709,
+};
+
+enum TRTCColorRange
+{
+    TRTCColorRangeLimited,      //Y 16~235UV 16~240
+    TRTCColorRangeFull,         //YUV 0~255
+};
+
+struct TRTCColorSpace
+{
+    TRTCColorMatrix matrix = TRTCColorMatrixBT601;
+    TRTCColorRange range = TRTCColorRangeLimited;
+};
+
+enum TRTCConvertKernel
+{
+    TRTCConvertKernelAuto,
+    TRTCConvertKernelScalar,
+    TRTCConvertKernelSSE2,
+    TRTCConvertKernelAVX2,
+    TRTCConvertKernelNEON,
+};
+
+struct TRTCVideoConvertBenchResult
+{
+    TRTCVideoResolution resolution = TRTCVideoResolution_640_360;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    TRTCConvertKernel kernel = TRTCConvertKernelScalar;
+    double i420ToBGRAMs = 0;        //֡ƽʱ룩
+    double bgraToI420Ms = 0;
+    bool bMatchScalar = true;       //ɫʿռʵһ
+};
+
+class TRTCVideoConvert
+{
+public:
+    static bool isKernelSupported(TRTCConvertKernel kernel);
+    static TRTCConvertKernel bestKernel();
+    static const char* kernelName(TRTCConvertKernel kernel);
+
+    // width * height һֽ֡I420 ɫƽȡֵ֧ĸʽ 0
+    static uint32_t frameLength(TRTCVideoPixelFormat format, uint32_t width, uint32_t height);
+
+    //ƽתstride λΪֽڣָ kernel ǰ CPU ֧ʱ˻رʵ
+    static void i420ToBGRA(const uint8_t* srcY, int strideY, const uint8_t* srcU, int strideU, const uint8_t* srcV, int strideV,
+        uint8_t* dstBGRA, int strideBGRA, int width, int height,
+        const TRTCColorSpace& colorSpace = TRTCColorSpace(), TRTCConvertKernel kernel = TRTCConvertKernelAuto);
+    static void bgraToI420(const uint8_t* srcBGRA, int strideBGRA,
+        uint8_t* dstY, int strideY, uint8_t* dstU, int strideU, uint8_t* dstV, int strideV, int width, int height,
+        const TRTCColorSpace& colorSpace = TRTCColorSpace(), TRTCConvertKernel kernel = TRTCConvertKernelAuto);
+
+    // dst.videoFormat ת srcdst.data ɵ÷䣬 frameLength ֽڣ
+    //ɹʱд dst  lengthߡʱתǶȣʽͬʱֱӿ
+    static bool convertFrame(const TRTCVideoFrame& src, TRTCVideoFrame& dst,
+        const TRTCColorSpace& colorSpace = TRTCColorSpace(), TRTCConvertKernel kernel = TRTCConvertKernelAuto);
+
+    //ÿֱַʡÿʵ֡ÿ durationMs 
+    static std::vector<TRTCVideoConvertBenchResult> runBenchmark(uint32_t durationMs = 100);
+    static std::string formatBenchmark(const std::vector<TRTCVideoConvertBenchResult>& results);
+private:
+    TRTCVideoConvert();
+};
@@ -0,0 +1,325 @@
+/*
+* Module:   TRTCVideoFramePool
+*
+* Function: СֵõƵ֡onRenderVideoFrame  SDK ֡ƳȾ߳ʱÿ֡ new/delete
+*/
+
+#include "TRTCVideoFramePool.h"
+#include "BoundedQueue.h"
+
+#include <vector>
+#include <memory>
+#include <utility>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+//λСΪ (4 + i % 4) << (10 + i / 4) 4KB5KB6KB7KB8KB10KB 56MB
+static const int kBucketCount = 56;
+static const uint32_t kMinBucketSize = 4096;
+
+struct TRTCVideoFramePool::State
+{
+    std::atomic<uint32_t> refCount;         //رÿڵĻ
+    std::atomic<bool> bClosed;
+    std::vector<std::unique_ptr<CBoundedQueue<TRTCVideoFrameBuffer*>>> buckets;
+
+    std::atomic<uint64_t> hitCount;
+    std::atomic<uint64_t> missCount;
+    std::atomic<uint64_t> discardCount;
+    std::atomic<uint32_t> liveCount;
+    std::atomic<uint64_t> liveBytes;
+
+    explicit State(uint32_t maxFreePerBucket)
+        : refCount(1), bClosed(false), hitCount(0), missCount(0), discardCount(0), liveCount(0), liveBytes(0)
+    {
+        for (int i = 0; i < kBucketCount; ++i)
+            buckets.emplace_back(new CBoundedQueue<TRTCVideoFrameBuffer*>(maxFreePerBucket));
+    }
+};
+
+struct TRTCVideoFrameBuffer
+{
+    std::atomic<uint32_t> refCount;
+    TRTCVideoFramePool::State* state;
+    int bucket;                 //-1 ʾλ
+    uint32_t capacity;
+    char* data;
+    TRTCVideoFrame frame;
+};
+
+static uint32_t bucketSize(int bucket)
+{
+    return (uint32_t)(4 + bucket % 4) << (10 + bucket / 4);
+}
+
+//ܷ length ֽڵСλλ -1
+static int bucketIndex(uint32_t length)
+{
+    if (length <= kMinBucketSize)
+        return 0;
+
+    //n λڵ k λȡߵ 3 λ t4~7ڵ length Сλ (t + 1) << (k - 2)
+    uint32_t n = length - 1;
+    int k = 0;
+    while ((n >> (k + 1)) != 0)
+        ++k;
+    uint32_t m = (n >> (k - 2)) + 1;
+    int shift = k - 2;
+    if (m == 8)
+    {
+        m = 4;
+        ++shift;
+    }
+    int bucket = (shift - 10) * 4 + (int)(m - 4);
+    return bucket < kBucketCount ? bucket : -1;
+}
+
+static char* allocAligned(size_t size)
+{
+#ifdef _WIN32
+    return static_cast<char*>(_aligned_malloc(size, TRTCVideoFramePool::kAlignment));
+#else
+    void* data = NULL;
+    return posix_memalign(&data, TRTCVideoFramePool::kAlignment, size) == 0 ? static_cast<char*>(data) : NULL;
+#endif
+}
+
+static void freeAligned(char* data)
+{
+#ifdef _WIN32
+    _aligned_free(data);
+#else
+    free(data);
+#endif
+}
+
+static void releaseState(TRTCVideoFramePool::State* state)
+{
+    if (state->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        delete state;
+}
+
+static void destroyBuffer(TRTCVideoFrameBuffer* buffer)
+{
+    TRTCVideoFramePool::State* state = buffer->state;
+    state->liveCount.fetch_sub(1, std::memory_order_relaxed);
+    state->liveBytes.fetch_sub(buffer->capacity, std::memory_order_relaxed);
+    freeAligned(buffer->data);
+    delete buffer;
+    releaseState(state);
+}
+
+//÷Ҫ state һ
+static void drainBuckets(TRTCVideoFramePool::State* state)
+{
+    for (size_t i = 0; i < state->buckets.size(); ++i)
+    {
+        TRTCVideoFrameBuffer* buffer = NULL;
+        while (state->buckets[i]->TryPop(buffer))
+            destroyBuffer(buffer);
+    }
+}
+
+//һͷʱãŻλ١λ򲻻ʱͷ
+static void recycleBuffer(TRTCVideoFrameBuffer* buffer)
+{
+    TRTCVideoFramePool::State* state = buffer->state;
+    if (buffer->bucket < 0 || state->bClosed.load(std::memory_order_acquire))
+    {
+        state->discardCount.fetch_add(1, std::memory_order_relaxed);
+        destroyBuffer(buffer);
+        return;
+    }
+
+    //Żضк󻺳ʱܱصͷŲ state һãȶһ
+    state->refCount.fetch_add(1, std::memory_order_relaxed);
+    if (!state->buckets[buffer->bucket]->TryPush(buffer))
+    {
+        state->discardCount.fetch_add(1, std::memory_order_relaxed);
+        destroyBuffer(buffer);
+    }
+    else
+    {
+        // bClosed/ԣҪô￴ bClosedҪôʱȡշŻصĻ
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (state->bClosed.load(std::memory_order_relaxed))
+            drainBuckets(state);
+    }
+    releaseState(state);
+}
+
+//////////////////////////////////////////////////////////////////////////TRTCVideoFrameRef
+
+TRTCVideoFrameRef::TRTCVideoFrameRef()
+    : m_buffer(NULL)
+{
+}
+
+TRTCVideoFrameRef::TRTCVideoFrameRef(TRTCVideoFrameBuffer* buffer)
+    : m_buffer(buffer)
+{
+}
+
+TRTCVideoFrameRef::TRTCVideoFrameRef(const TRTCVideoFrameRef& other)
+    : m_buffer(other.m_buffer)
+{
+    if (m_buffer != NULL)
+        m_buffer->refCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+TRTCVideoFrameRef::TRTCVideoFrameRef(TRTCVideoFrameRef&& other)
+    : m_buffer(other.m_buffer)
+{
+    other.m_buffer = NULL;
+}
+
+TRTCVideoFrameRef& TRTCVideoFrameRef::operator =(const TRTCVideoFrameRef& other)
+{
+    if (m_buffer != other.m_buffer)
+    {
+        if (other.m_buffer != NULL)
+            other.m_buffer->refCount.fetch_add(1, std::memory_order_relaxed);
+        reset();
+        m_buffer = other.m_buffer;
+    }
+    return *this;
+}
+
+TRTCVideoFrameRef& TRTCVideoFrameRef::operator =(TRTCVideoFrameRef&& other)
+{
+    if (this != &other)
+    {
+        reset();
+        m_buffer = other.m_buffer;
+        other.m_buffer = NULL;
+    }
+    return *this;
+}
+
+TRTCVideoFrameRef::~TRTCVideoFrameRef()
+{
+    reset();
+}
+
+bool TRTCVideoFrameRef::empty() const
+{
+    return m_buffer == NULL;
+}
+
+void TRTCVideoFrameRef::reset()
+{
+    TRTCVideoFrameBuffer* buffer = m_buffer;
+    m_buffer = NULL;
+    if (buffer != NULL && buffer->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        recycleBuffer(buffer);
+}
+
+const TRTCVideoFrame& TRTCVideoFrameRef::frame() const
+{
+    return m_buffer->frame;
+}
+
+TRTCVideoFrame& TRTCVideoFrameRef::frame()
+{
+    return m_buffer->frame;
+}
+
+uint32_t TRTCVideoFrameRef::capacity() const
+{
+    return m_buffer != NULL ? m_buffer->capacity : 0;
+}
+
+uint32_t TRTCVideoFrameRef::useCount() const
+{
+    return m_buffer != NULL ? m_buffer->refCount.load(std::memory_order_relaxed) : 0;
+}
+
+//////////////////////////////////////////////////////////////////////////TRTCVideoFramePool
+
+TRTCVideoFramePool::TRTCVideoFramePool(uint32_t maxFreePerBucket)
+    : m_state(new State(maxFreePerBucket))
+{
+}
+
+TRTCVideoFramePool::~TRTCVideoFramePool()
+{
+    m_state->bClosed.store(true, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    drainBuckets(m_state);
+    releaseState(m_state);
+}
+
+TRTCVideoFrameRef TRTCVideoFramePool::acquire(uint32_t length)
+{
+    int bucket = bucketIndex(length);
+    TRTCVideoFrameBuffer* buffer = NULL;
+    if (bucket >= 0 && m_state->buckets[bucket]->TryPop(buffer))
+    {
+        m_state->hitCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        m_state->missCount.fetch_add(1, std::memory_order_relaxed);
+
+        uint32_t capacity = bucket >= 0 ? bucketSize(bucket) : length;
+        char* data = allocAligned(capacity);
+        if (data == NULL)
+            return TRTCVideoFrameRef();
+
+        buffer = new TRTCVideoFrameBuffer;
+        buffer->state = m_state;
+        buffer->bucket = bucket;
+        buffer->capacity = capacity;
+        buffer->data = data;
+        m_state->refCount.fetch_add(1, std::memory_order_relaxed);
+        m_state->liveCount.fetch_add(1, std::memory_order_relaxed);
+        m_state->liveBytes.fetch_add(capacity, std::memory_order_relaxed);
+    }
+
+    buffer->refCount.store(1, std::memory_order_relaxed);
+    buffer->frame = TRTCVideoFrame();
+    buffer->frame.bufferType = TRTCVideoBufferType_Buffer;
+    buffer->frame.data = buffer->data;
+    buffer->frame.length = length;
+    return TRTCVideoFrameRef(buffer);
+}
+
+TRTCVideoFrameRef TRTCVideoFramePool::copyFrom(const TRTCVideoFrame& frame)
+{
+    if (frame.bufferType != TRTCVideoBufferType_Buffer || frame.data == NULL)
+        return TRTCVideoFrameRef();
+
+    TRTCVideoFrameRef ref = acquire(frame.length);
+    if (ref.empty())
+        return ref;
+
+    TRTCVideoFrame& copy = ref.frame();
+    memcpy(copy.data, frame.data, frame.length);
+    copy.videoFormat = frame.videoFormat;
+    copy.width = frame.width;
+    copy.height = frame.height;
+    copy.timestamp = frame.timestamp;
+    copy.rotation = frame.rotation;
+    return ref;
+}
+
+void TRTCVideoFramePool::trim()
+{
+    drainBuckets(m_state);
+}
+
+TRTCVideoFramePoolStats TRTCVideoFramePool::getStats() const
+{
+    TRTCVideoFramePoolStats stats;
+    stats.hitCount = m_state->hitCount.load(std::memory_order_relaxed);
+    stats.missCount = m_state->missCount.load(std::memory_order_relaxed);
+    stats.discardCount = m_state->discardCount.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < m_state->buckets.size(); ++i)
+        stats.freeCount += (uint32_t)m_state->buckets[i]->SizeApprox();
+    stats.liveCount = m_state->liveCount.load(std::memory_order_relaxed);
+    stats.liveBytes = m_state->liveBytes.load(std::memory_order_relaxed);
+    return stats;
+}
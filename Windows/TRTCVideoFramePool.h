@@ -0,0 +1,84 @@
+#pragma once
+/*
+* Module:   TRTCVideoFramePool
+*
+* Function: СֵõƵ֡onRenderVideoFrame  SDK ֡ƳȾ߳ʱÿ֡ new/delete
+*
+*    1.  4KB ÿһĵĴС࣬ÿĿлһȡú͹黹
+*
+*    2. TRTCVideoFrameRef Ǵüľ֮߳俽ݣһʱصĵλ
+*       λ򳬹λʱֱͷšھҲû⣬ʣµĻһʱͷš
+*
+*    3.  kAlignment ֽڶ룬ֱӽ SSE/AVX 봦
+*
+*    4. ȶʱÿȡöплѷ䣻getStats СδкͶĴ
+*/
+
+#include "TRTCCloudDef.h"
+
+#include <stdint.h>
+
+struct TRTCVideoFrameBuffer;
+
+class TRTCVideoFrameRef
+{
+public:
+    TRTCVideoFrameRef();
+    TRTCVideoFrameRef(const TRTCVideoFrameRef& other);
+    TRTCVideoFrameRef(TRTCVideoFrameRef&& other);
+    TRTCVideoFrameRef& operator =(const TRTCVideoFrameRef& other);
+    TRTCVideoFrameRef& operator =(TRTCVideoFrameRef&& other);
+    ~TRTCVideoFrameRef();
+
+    bool empty() const;
+    void reset();
+
+    //frame().data ָĻlength ΪЧݳȣͬһ֡дǰɵ÷֤û
+    const TRTCVideoFrame& frame() const;
+    TRTCVideoFrame& frame();
+    uint32_t capacity() const;
+    uint32_t useCount() const;
+private:
+    friend class TRTCVideoFramePool;
+    explicit TRTCVideoFrameRef(TRTCVideoFrameBuffer* buffer);
+
+    TRTCVideoFrameBuffer* m_buffer;
+};
+
+struct TRTCVideoFramePoolStats
+{
+    uint64_t hitCount = 0;          //ȡʱ˿л
+    uint64_t missCount = 0;         //ȡʱ·˻
+    uint64_t discardCount = 0;      //黹ʱλ򳬹λͷ
+    uint32_t freeCount = 0;         //ǰеĻ
+    uint32_t liveCount = 0;         //ǰڵĻеĺ;е
+    uint64_t liveBytes = 0;
+};
+
+class TRTCVideoFramePool
+{
+public:
+    static const uint32_t kAlignment = 64;
+
+    //maxFreePerBucket ΪÿλౣĿл
+    explicit TRTCVideoFramePool(uint32_t maxFreePerBucket = 16);
+    ~TRTCVideoFramePool();
+
+    //ȡһ length ֽڵĻframe  length Ϊ lengthֶΪĬֵʧʱؿվ
+    TRTCVideoFrameRef acquire(uint32_t length);
+
+    //һ֡ڴݺĸʽߡʱתǶȣ onRenderVideoFrame ʹã֡ؿվ
+    TRTCVideoFrameRef copyFrom(const TRTCVideoFrame& frame);
+
+    //ͷпл
+    void trim();
+
+    TRTCVideoFramePoolStats getStats() const;
+
+    struct State;
+private:
+    TRTCVideoFramePool(const TRTCVideoFramePool&);
+    TRTCVideoFramePool& operator =(const TRTCVideoFramePool&);
+private:
+    State* m_state;     //ɳغÿͬãһͷʱ
+};
@@ -0,0 +1,187 @@
+/*
+* Module:   TRTCVideoMailbox
+*
+* Function: ÿһ·Ƶֻһ֡䣬Ⱦ̸߳ʱֱ֡ӱ֡ǣڶԽԽ
+*/
+
+#include "TRTCVideoMailbox.h"
+
+#include <utility>
+#include <string.h>
+
+static const uint32_t kSlotMask = 3;
+static const uint32_t kFreshBit = 4;
+
+//////////////////////////////////////////////////////////////////////////TRTCVideoFrameMailbox
+
+TRTCVideoFrameMailbox::TRTCVideoFrameMailbox()
+    : m_middle(1)
+    , m_publishedCount(0)
+    , m_droppedCount(0)
+    , m_takenCount(0)
+{
+}
+
+void TRTCVideoFrameMailbox::publish(TRTCVideoFrameRef frame)
+{
+    m_slots[m_back] = std::move(frame);
+    uint32_t old = m_middle.exchange(m_back | kFreshBit, std::memory_order_acq_rel);
+
+    //ĲλҪôѾȡյģҪôûüȡߵľ֡
+    m_back = old & kSlotMask;
+    if ((old & kFreshBit) != 0)
+        m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+    m_slots[m_back].reset();
+    m_publishedCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool TRTCVideoFrameMailbox::takeLatest(TRTCVideoFrameRef& frame)
+{
+    if ((m_middle.load(std::memory_order_relaxed) & kFreshBit) == 0)
+        return false;
+
+    uint32_t old = m_middle.exchange(m_front, std::memory_order_acq_rel);
+    m_front = old & kSlotMask;
+    frame = std::move(m_slots[m_front]);
+    m_takenCount.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+uint64_t TRTCVideoFrameMailbox::publishedCount() const
+{
+    return m_publishedCount.load(std::memory_order_relaxed);
+}
+
+uint64_t TRTCVideoFrameMailbox::takenCount() const
+{
+    return m_takenCount.load(std::memory_order_relaxed);
+}
+
+uint64_t TRTCVideoFrameMailbox::droppedCount() const
+{
+    return m_droppedCount.load(std::memory_order_relaxed);
+}
+
+//////////////////////////////////////////////////////////////////////////TRTCVideoMailboxCallback
+
+struct TRTCVideoMailboxCallback::Stream
+{
+    std::string userId;
+    TRTCVideoStreamType streamType;
+    TRTCVideoFrameMailbox mailbox;
+};
+
+TRTCVideoMailboxCallback::TRTCVideoMailboxCallback(TRTCVideoFramePool* pool)
+    : m_pool(pool)
+    , m_streams(std::make_shared<StreamList>())
+    , m_unmatchedCount(0)
+{
+    if (m_pool == NULL)
+    {
+        m_ownedPool.reset(new TRTCVideoFramePool());
+        m_pool = m_ownedPool.get();
+    }
+}
+
+TRTCVideoMailboxCallback::~TRTCVideoMailboxCallback()
+{
+}
+
+TRTCVideoMailboxCallback::Stream* TRTCVideoMailboxCallback::findStream(const StreamList& streams, const char* userId, TRTCVideoStreamType streamType)
+{
+    if (userId == NULL)
+        userId = "";
+    for (size_t i = 0; i < streams.size(); ++i)
+    {
+        Stream* stream = streams[i].get();
+        if (stream->streamType == streamType && strcmp(stream->userId.c_str(), userId) == 0)
+            return stream;
+    }
+    return NULL;
+}
+
+void TRTCVideoMailboxCallback::addStream(const std::string& userId, TRTCVideoStreamType streamType)
+{
+    std::lock_guard<std::mutex> lock(m_streamMutex);
+    std::shared_ptr<const StreamList> current = std::atomic_load(&m_streams);
+    if (findStream(*current, userId.c_str(), streamType) != NULL)
+        return;
+
+    std::shared_ptr<Stream> stream = std::make_shared<Stream>();
+    stream->userId = userId;
+    stream->streamType = streamType;
+
+    std::shared_ptr<StreamList> streams = std::make_shared<StreamList>(*current);
+    streams->push_back(stream);
+    std::atomic_store(&m_streams, std::shared_ptr<const StreamList>(streams));
+}
+
+void TRTCVideoMailboxCallback::removeStream(const std::string& userId, TRTCVideoStreamType streamType)
+{
+    std::lock_guard<std::mutex> lock(m_streamMutex);
+    std::shared_ptr<const StreamList> current = std::atomic_load(&m_streams);
+
+    std::shared_ptr<StreamList> streams = std::make_shared<StreamList>();
+    for (size_t i = 0; i < current->size(); ++i)
+    {
+        const std::shared_ptr<Stream>& stream = (*current)[i];
+        if (stream->streamType != streamType || stream->userId != userId)
+            streams->push_back(stream);
+    }
+    if (streams->size() != current->size())
+        std::atomic_store(&m_streams, std::shared_ptr<const StreamList>(streams));
+}
+
+void TRTCVideoMailboxCallback::removeAllStreams()
+{
+    std::lock_guard<std::mutex> lock(m_streamMutex);
+    std::atomic_store(&m_streams, std::shared_ptr<const StreamList>(std::make_shared<StreamList>()));
+}
+
+bool TRTCVideoMailboxCallback::takeLatest(const std::string& userId, TRTCVideoStreamType streamType, TRTCVideoFrameRef& frame)
+{
+    std::shared_ptr<const StreamList> streams = std::atomic_load(&m_streams);
+    Stream* stream = findStream(*streams, userId.c_str(), streamType);
+    return stream != NULL && stream->mailbox.takeLatest(frame);
+}
+
+std::vector<TRTCVideoMailboxStats> TRTCVideoMailboxCallback::getStats() const
+{
+    std::shared_ptr<const StreamList> streams = std::atomic_load(&m_streams);
+    std::vector<TRTCVideoMailboxStats> stats;
+    for (size_t i = 0; i < streams->size(); ++i)
+    {
+        const Stream& stream = *(*streams)[i];
+        TRTCVideoMailboxStats item;
+        item.userId = stream.userId;
+        item.streamType = stream.streamType;
+        item.publishedCount = stream.mailbox.publishedCount();
+        item.takenCount = stream.mailbox.takenCount();
+        item.droppedCount = stream.mailbox.droppedCount();
+        stats.push_back(item);
+    }
+    return stats;
+}
+
+uint64_t TRTCVideoMailboxCallback::unmatchedCount() const
+{
+    return m_unmatchedCount.load(std::memory_order_relaxed);
+}
+
+void TRTCVideoMailboxCallback::onRenderVideoFrame(const char* userId, TRTCVideoStreamType streamType, TRTCVideoFrame* frame)
+{
+    if (frame == NULL)
+        return;
+
+    std::shared_ptr<const StreamList> streams = std::atomic_load(&m_streams);
+    Stream* stream = findStream(*streams, userId, streamType);
+    TRTCVideoFrameRef copy;
+    if (stream != NULL)
+        copy = m_pool->copyFrom(*frame);
+    if (copy.empty())
+    {
+        m_unmatchedCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    stream->mailbox.publish(std::move(copy));
+}
@@ -0,0 +1,102 @@
+#pragma once
+/*
+* Module:   TRTCVideoMailbox
+*
+* Function: ÿһ·Ƶֻһ֡䣬Ⱦ̸߳ʱֱ֡ӱ֡ǣڶԽԽ
+*
+*    1. TRTCVideoFrameMailbox λ߶ռһд룬߶ռһȡмһԭӱ
+*       ˫ֻһ exchangeȴÿȡĶһ֡дĻ档
+*
+*    2. мλﻹûȡ߾ͱ֡滻֡Ϊ֡ڽͷŻ TRTCVideoFramePool
+*
+*    3. TRTCVideoMailboxCallback Ϊ ITRTCVideoRenderCallback ø SDK (userId, TRTCVideoStreamType) ҵ䣬
+*        onRenderVideoFrame ֡ƽػĻ䡣бնȡɾʱ滻
+*       ص̲߳ʱַֻȽϣڴ档
+*
+*    4. ͬһ·ͬһʱֻһߣSDK ÿ·лصһߣȾ̣߳
+*/
+
+#include "TRTCCloudCallback.h"
+#include "TRTCVideoFramePool.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <stdint.h>
+
+class TRTCVideoFrameMailbox
+{
+public:
+    TRTCVideoFrameMailbox();
+
+    //ߵãһ֡
+    void publish(TRTCVideoFrameRef frame);
+    //ߵãϴ֮֡ʱȡһ֡ true
+    bool takeLatest(TRTCVideoFrameRef& frame);
+
+    uint64_t publishedCount() const;
+    uint64_t takenCount() const;
+    uint64_t droppedCount() const;
+private:
+    TRTCVideoFrameMailbox(const TRTCVideoFrameMailbox&);
+    TRTCVideoFrameMailbox& operator =(const TRTCVideoFrameMailbox&);
+private:
+    TRTCVideoFrameRef m_slots[3];
+    std::atomic<uint32_t> m_middle;     //мλţkFreshBit ʾ߻ûȡߵ֡
+
+    //ߺ߸Ե״ֿ̬ڲͬĻ
+    char m_pad0[64];
+    uint32_t m_back = 0;
+    std::atomic<uint64_t> m_publishedCount;
+    std::atomic<uint64_t> m_droppedCount;
+    char m_pad1[64];
+    uint32_t m_front = 2;
+    std::atomic<uint64_t> m_takenCount;
+};
+
+struct TRTCVideoMailboxStats
+{
+    std::string userId;
+    TRTCVideoStreamType streamType = TRTCVideoStreamTypeBig;
+    uint64_t publishedCount = 0;
+    uint64_t takenCount = 0;
+    uint64_t droppedCount = 0;      //ûȾ߳ȡ߾ͱµ֡
+};
+
+class TRTCVideoMailboxCallback : public ITRTCVideoRenderCallback
+{
+public:
+    //pool ΪʱʹڲĻأⲿ pool Ҫȱø
+    explicit TRTCVideoMailboxCallback(TRTCVideoFramePool* pool = NULL);
+    virtual ~TRTCVideoMailboxCallback();
+
+    // setRemoteVideoRenderCallback/setLocalVideoRenderCallback ֮ǰΪһ·䣬
+    //ûֱ֡ӶԤ userId  SDK صһ£ͨΪմ
+    void addStream(const std::string& userId, TRTCVideoStreamType streamType);
+    void removeStream(const std::string& userId, TRTCVideoStreamType streamType);
+    void removeAllStreams();
+
+    //Ⱦ̵߳ã֡ʱ true
+    bool takeLatest(const std::string& userId, TRTCVideoStreamType streamType, TRTCVideoFrameRef& frame);
+
+    std::vector<TRTCVideoMailboxStats> getStats() const;
+    uint64_t unmatchedCount() const;    //û߸ʧܶ֡
+public:
+    virtual void onRenderVideoFrame(const char* userId, TRTCVideoStreamType streamType, TRTCVideoFrame* frame);
+private:
+    TRTCVideoMailboxCallback(const TRTCVideoMailboxCallback&);
+    TRTCVideoMailboxCallback& operator =(const TRTCVideoMailboxCallback&);
+
+    struct Stream;
+    typedef std::vector<std::shared_ptr<Stream>> StreamList;
+    static Stream* findStream(const StreamList& streams, const char* userId, TRTCVideoStreamType streamType);
+private:
+    std::unique_ptr<TRTCVideoFramePool> m_ownedPool;
+    TRTCVideoFramePool* m_pool;
+
+    std::shared_ptr<const StreamList> m_streams;
+    std::mutex m_streamMutex;       //лɾ
+    std::atomic<uint64_t> m_unmatchedCount;
+};
@@ -0,0 +1,500 @@
+/*
+* Module:   TRTCVideoScaler
+*
+* Function: ԶȾ·ϵĻţ I420  BGRA32  LiteAVVideoFrame ŵⴰڴС TRTCVideoResolution 涨ĳߴ
+*/
+
+#include "TRTCVideoScaler.h"
+#include "TRTCVideoConvert.h"
+
+#include <algorithm>
+#include <utility>
+#include <math.h>
+#include <string.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define VIDEO_SCALER_SSE2
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#include <arm_neon.h>
+#define VIDEO_SCALER_NEON
+#endif
+
+//ȨΪ 14 λ㣬мб 6 λСμȨһ 20 λ
+static const int kWeightBits = 14;
+static const int kRowBits = 6;
+static const int kVerticalShift = kWeightBits - kRowBits;
+static const int kHorizontalShift = kWeightBits + kRowBits;
+static const size_t kMaxCachedTables = 16;
+static const int kTapAlign = 8;
+
+//һÿش start ʼȡ taps ԴأȨ֮Ϊ 1 << kWeightBits
+struct TRTCVideoScaler::AxisTable
+{
+    TRTCScaleFilter filter;
+    int srcSize;
+    int dstSize;
+    int taps;
+    int stride;                     //ÿصȨظtaps ϶뵽 kTapAlignȨΪ 0
+    std::vector<int32_t> start;     //֤ start + taps <= srcSize
+    std::vector<int16_t> weights;
+};
+
+static double filterWeight(TRTCScaleFilter filter, double t)
+{
+    t = fabs(t);
+    if (filter == TRTCScaleFilterBicubic)
+    {
+        //Keys ξa = -0.5
+        if (t < 1.0)
+            return (1.5 * t - 2.5) * t * t + 1.0;
+        if (t < 2.0)
+            return ((-0.5 * t + 2.5) * t - 4.0) * t + 2.0;
+        return 0.0;
+    }
+    return t < 1.0 ? 1.0 - t : 0.0;
+}
+
+static std::shared_ptr<const TRTCVideoScaler::AxisTable> buildAxisTable(TRTCScaleFilter filter, int srcSize, int dstSize)
+{
+    std::shared_ptr<TRTCVideoScaler::AxisTable> table = std::make_shared<TRTCVideoScaler::AxisTable>();
+    table->filter = filter;
+    table->srcSize = srcSize;
+    table->dstSize = dstSize;
+
+    //ȰÿԴϵȨأԽĳͷԵ
+    double scale = (double)srcSize / dstSize;
+    double filterScale = std::max(1.0, scale);
+    double support = (filter == TRTCScaleFilterBicubic ? 2.0 : 1.0) * filterScale;
+    std::vector<std::vector<double>> rows(dstSize);
+    std::vector<int> first(dstSize);
+    int taps = 1;
+    std::vector<double> acc(srcSize, 0.0);
+    for (int i = 0; i < dstSize; ++i)
+    {
+        int lo = srcSize;
+        int hi = -1;
+        if (filter == TRTCScaleFilterArea)
+        {
+            //ظԴ [x0, x1)ȨΪÿԴرǵĳ
+            double x0 = i * scale;
+            double x1 = x0 + scale;
+            for (int j = (int)floor(x0); j < x1 && j < srcSize; ++j)
+            {
+                acc[j] += std::min(x1, j + 1.0) - std::max(x0, (double)j);
+                lo = std::min(lo, j);
+                hi = std::max(hi, j);
+            }
+        }
+        else
+        {
+            double center = (i + 0.5) * scale - 0.5;
+            int j0 = (int)floor(center - support);
+            int j1 = (int)ceil(center + support);
+            for (int j = j0; j <= j1; ++j)
+            {
+                int k = std::min(srcSize - 1, std::max(0, j));
+                acc[k] += filterWeight(filter, (j - center) / filterScale);
+                lo = std::min(lo, k);
+                hi = std::max(hi, k);
+            }
+        }
+
+        //ȥΪ 0 ĳͷȡùĲһ
+        int used0 = lo;
+        int used1 = hi;
+        while (lo < hi && acc[lo] == 0.0)
+            ++lo;
+        while (hi > lo && acc[hi] == 0.0)
+            --hi;
+        double sum = 0;
+        for (int j = lo; j <= hi; ++j)
+            sum += acc[j];
+        rows[i].assign(acc.begin() + lo, acc.begin() + hi + 1);
+        for (size_t j = 0; j < rows[i].size(); ++j)
+            rows[i][j] /= sum;
+        std::fill(acc.begin() + used0, acc.begin() + used1 + 1, 0.0);
+        first[i] = lo;
+        taps = std::max(taps, hi - lo + 1);
+    }
+
+    //ͳһͷ start Ų֤ԽԴұ
+    table->taps = taps;
+    table->stride = (taps + kTapAlign - 1) / kTapAlign * kTapAlign;
+    table->start.resize(dstSize);
+    table->weights.assign((size_t)dstSize * table->stride, 0);
+    for (int i = 0; i < dstSize; ++i)
+    {
+        int start = std::min(first[i], srcSize - taps);
+        int offset = first[i] - start;
+        int16_t* weights = &table->weights[(size_t)i * table->stride];
+        int total = 0;
+        int largest = offset;
+        for (size_t j = 0; j < rows[i].size(); ++j)
+        {
+            double value = rows[i][j] * (1 << kWeightBits);
+            weights[offset + j] = (int16_t)(value < 0 ? value - 0.5 : value + 0.5);
+            total += weights[offset + j];
+            if (weights[offset + j] > weights[largest])
+                largest = offset + (int)j;
+        }
+        //Ȩϣ֤ɫź󲻱
+        weights[largest] += (int16_t)((1 << kWeightBits) - total);
+        table->start[i] = start;
+    }
+    return table;
+}
+
+//ֱ򣺰 taps ԴаȨؼӵ dstwidth Ϊһеֽ
+static void verticalPass(const uint8_t* src, int srcStride, int taps, const int16_t* weights, int16_t* dst, int width)
+{
+    int x = 0;
+#if defined(VIDEO_SCALER_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi32(1 << (kVerticalShift - 1));
+    for (; x + 8 <= width; x += 8)
+    {
+        __m128i lo = round;
+        __m128i hi = round;
+        //ͷ 16 λԣһ madd 
+        for (int t = 0; t < taps; t += 2)
+        {
+            __m128i a = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + t * srcStride + x)), zero);
+            __m128i b = zero;
+            int16_t w1 = 0;
+            if (t + 1 < taps)
+            {
+                b = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + (t + 1) * srcStride + x)), zero);
+                w1 = weights[t + 1];
+            }
+            __m128i w = _mm_set1_epi32((int)(((uint32_t)(uint16_t)w1 << 16) | (uint16_t)weights[t]));
+            lo = _mm_add_epi32(lo, _mm_madd_epi16(_mm_unpacklo_epi16(a, b), w));
+            hi = _mm_add_epi32(hi, _mm_madd_epi16(_mm_unpackhi_epi16(a, b), w));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x),
+            _mm_packs_epi32(_mm_srai_epi32(lo, kVerticalShift), _mm_srai_epi32(hi, kVerticalShift)));
+    }
+#elif defined(VIDEO_SCALER_NEON)
+    for (; x + 8 <= width; x += 8)
+    {
+        int32x4_t lo = vdupq_n_s32(1 << (kVerticalShift - 1));
+        int32x4_t hi = lo;
+        for (int t = 0; t < taps; ++t)
+        {
+            int16x8_t a = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(src + t * srcStride + x)));
+            lo = vmlal_n_s16(lo, vget_low_s16(a), weights[t]);
+            hi = vmlal_n_s16(hi, vget_high_s16(a), weights[t]);
+        }
+        vst1q_s16(dst + x, vcombine_s16(vshrn_n_s32(lo, kVerticalShift), vshrn_n_s32(hi, kVerticalShift)));
+    }
+#endif
+    for (; x < width; ++x)
+    {
+        int sum = 1 << (kVerticalShift - 1);
+        for (int t = 0; t < taps; ++t)
+            sum += src[t * srcStride + x] * weights[t];
+        dst[x] = (int16_t)(sum >> kVerticalShift);
+    }
+}
+
+static uint8_t clampPixel(int value)
+{
+    return (uint8_t)(value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+//ˮƽ򣬵ͨrow ĩβ stride Ԫ
+static void horizontalPass1(const int16_t* row, const TRTCVideoScaler::AxisTable& table, uint8_t* dst)
+{
+    const int round = 1 << (kHorizontalShift - 1);
+    if (table.taps <= 2)
+    {
+        //˫ԷŴֻͷֱȲ뵽 8 ͷ汾
+        for (int x = 0; x < table.dstSize; ++x)
+        {
+            const int16_t* p = row + table.start[x];
+            const int16_t* w = &table.weights[(size_t)x * table.stride];
+            dst[x] = clampPixel((p[0] * w[0] + p[1] * w[1] + round) >> kHorizontalShift);
+        }
+        return;
+    }
+
+    for (int x = 0; x < table.dstSize; ++x)
+    {
+        const int16_t* p = row + table.start[x];
+        const int16_t* w = &table.weights[(size_t)x * table.stride];
+#if defined(VIDEO_SCALER_SSE2)
+        __m128i acc = _mm_setzero_si128();
+        for (int t = 0; t < table.taps; t += kTapAlign)
+            acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + t)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(w + t))));
+        acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+        acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+        int sum = _mm_cvtsi128_si32(acc);
+#else
+        int sum = 0;
+        for (int t = 0; t < table.taps; ++t)
+            sum += p[t] * w[t];
+#endif
+        dst[x] = clampPixel((sum + round) >> kHorizontalShift);
+    }
+}
+
+//ˮƽBGRA ͨһ
+static void horizontalPass4(const int16_t* row, const TRTCVideoScaler::AxisTable& table, uint8_t* dst)
+{
+    const int round = 1 << (kHorizontalShift - 1);
+    for (int x = 0; x < table.dstSize; ++x)
+    {
+        const int16_t* p = row + table.start[x] * 4;
+        const int16_t* w = &table.weights[(size_t)x * table.stride];
+#if defined(VIDEO_SCALER_SSE2)
+        __m128i acc = _mm_set1_epi32(round);
+        for (int t = 0; t < table.taps; t += 2)
+        {
+            //صͬһͨ 16 λԣmadd õĸͨԵĺ
+            __m128i a = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p + t * 4));
+            __m128i b = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p + t * 4 + 4));
+            __m128i pair = _mm_set1_epi32((int)(((uint32_t)(uint16_t)w[t + 1] << 16) | (uint16_t)w[t]));
+            acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_unpacklo_epi16(a, b), pair));
+        }
+        acc = _mm_srai_epi32(acc, kHorizontalShift);
+        acc = _mm_packs_epi32(acc, acc);
+        int pixel = _mm_cvtsi128_si32(_mm_packus_epi16(acc, acc));
+        memcpy(dst + x * 4, &pixel, 4);
+#else
+        for (int c = 0; c < 4; ++c)
+        {
+            int sum = round;
+            for (int t = 0; t < table.taps; ++t)
+                sum += p[t * 4 + c] * w[t];
+            dst[x * 4 + c] = clampPixel(sum >> kHorizontalShift);
+        }
+#endif
+    }
+}
+
+static void fillPlane(uint8_t* dst, int stride, int width, int height, uint8_t value)
+{
+    for (int y = 0; y < height; ++y)
+        memset(dst + y * stride, value, width);
+}
+
+//////////////////////////////////////////////////////////////////////////TRTCVideoScaler
+
+TRTCVideoScaler::TRTCVideoScaler(TRTCScaleFilter filter)
+    : m_filter(filter)
+{
+}
+
+TRTCVideoScaler::~TRTCVideoScaler()
+{
+}
+
+void TRTCVideoScaler::setFilter(TRTCScaleFilter filter)
+{
+    m_filter = filter;
+}
+
+TRTCScaleFilter TRTCVideoScaler::filter() const
+{
+    return m_filter;
+}
+
+std::shared_ptr<const TRTCVideoScaler::AxisTable> TRTCVideoScaler::axisTable(int srcSize, int dstSize)
+{
+    for (size_t i = 0; i < m_tables.size(); ++i)
+    {
+        const AxisTable& table = *m_tables[i];
+        if (table.filter == m_filter && table.srcSize == srcSize && table.dstSize == dstSize)
+        {
+            std::shared_ptr<const AxisTable> found = m_tables[i];
+            m_tables.erase(m_tables.begin() + i);
+            m_tables.push_back(found);
+            return found;
+        }
+    }
+
+    std::shared_ptr<const AxisTable> table = buildAxisTable(m_filter, srcSize, dstSize);
+    if (m_tables.size() >= kMaxCachedTables)
+        m_tables.erase(m_tables.begin());
+    m_tables.push_back(table);
+    return table;
+}
+
+void TRTCVideoScaler::scalePlane(const uint8_t* src, int srcStride, int srcWidth, int srcHeight,
+    uint8_t* dst, int dstStride, int dstWidth, int dstHeight, int channels)
+{
+    if (srcWidth <= 0 || srcHeight <= 0 || dstWidth <= 0 || dstHeight <= 0 || (channels != 1 && channels != 4))
+        return;
+
+    std::shared_ptr<const AxisTable> xTable = axisTable(srcWidth, dstWidth);
+    std::shared_ptr<const AxisTable> yTable = axisTable(srcHeight, dstHeight);
+
+    //ˮƽ򰴶ĳͷȡмĩβ
+    int rowWidth = srcWidth * channels;
+    size_t rowSize = (size_t)rowWidth + (size_t)(xTable->stride + 1) * channels;
+    if (m_row.size() < rowSize)
+        m_row.assign(rowSize, 0);
+    else
+        std::fill(m_row.begin() + rowWidth, m_row.begin() + rowSize, (int16_t)0);
+
+    int16_t* row = &m_row[0];
+    for (int y = 0; y < dstHeight; ++y)
+    {
+        verticalPass(src + (size_t)yTable->start[y] * srcStride, srcStride, yTable->taps,
+            &yTable->weights[(size_t)y * yTable->stride], row, rowWidth);
+        if (channels == 1)
+            horizontalPass1(row, *xTable, dst + (size_t)y * dstStride);
+        else
+            horizontalPass4(row, *xTable, dst + (size_t)y * dstStride);
+    }
+}
+
+bool TRTCVideoScaler::scaleFrame(const TRTCVideoFrame& src, TRTCVideoFrame& dst, TRTCVideoFillMode fillMode)
+{
+    TRTCVideoPixelFormat format = src.videoFormat;
+    if (dst.videoFormat != format || (format != TRTCVideoPixelFormat_I420 && format != TRTCVideoPixelFormat_BGRA32)
+        || src.bufferType != TRTCVideoBufferType_Buffer || src.data == NULL || dst.data == NULL
+        || src.width == 0 || src.height == 0 || dst.width == 0 || dst.height == 0
+        || src.length < TRTCVideoConvert::frameLength(format, src.width, src.height)
+        || dst.length < TRTCVideoConvert::frameLength(format, dst.width, dst.height))
+        return false;
+
+    RECT srcRect;
+    RECT dstRect;
+    fillModeRects(src.width, src.height, dst.width, dst.height, fillMode, srcRect, dstRect);
+    bool bLetterbox = dstRect.left != 0 || dstRect.top != 0 || dstRect.right != (LONG)dst.width || dstRect.bottom != (LONG)dst.height;
+
+    const uint8_t* srcData = reinterpret_cast<const uint8_t*>(src.data);
+    uint8_t* dstData = reinterpret_cast<uint8_t*>(dst.data);
+    if (format == TRTCVideoPixelFormat_BGRA32)
+    {
+        if (bLetterbox)
+        {
+            //ڱΪ͸ɫ
+            const uint8_t black[4] = { 0, 0, 0, 255 };
+            for (uint32_t i = 0; i < dst.width * dst.height; ++i)
+                memcpy(dstData + i * 4, black, 4);
+        }
+        scalePlane(srcData + (srcRect.top * src.width + srcRect.left) * 4, src.width * 4,
+            srcRect.right - srcRect.left, srcRect.bottom - srcRect.top,
+            dstData + (dstRect.top * dst.width + dstRect.left) * 4, dst.width * 4,
+            dstRect.right - dstRect.left, dstRect.bottom - dstRect.top, 4);
+    }
+    else
+    {
+        //ɫƽõ±ȡ
+        for (int plane = 0; plane < 3; ++plane)
+        {
+            int shift = plane == 0 ? 0 : 1;
+            int srcStride = ((int)src.width + shift) >> shift;
+            int srcPlaneHeight = ((int)src.height + shift) >> shift;
+            int dstStride = ((int)dst.width + shift) >> shift;
+            int dstPlaneHeight = ((int)dst.height + shift) >> shift;
+            const uint8_t* srcPlane = srcData;
+            uint8_t* dstPlane = dstData;
+            if (plane > 0)
+            {
+                srcPlane += src.width * src.height + (plane - 1) * srcStride * srcPlaneHeight;
+                dstPlane += dst.width * dst.height + (plane - 1) * dstStride * dstPlaneHeight;
+            }
+
+            if (bLetterbox)
+                fillPlane(dstPlane, dstStride, dstStride, dstPlaneHeight, plane == 0 ? 16 : 128);
+
+            int sx = srcRect.left >> shift;
+            int sy = srcRect.top >> shift;
+            int dx = dstRect.left >> shift;
+            int dy = dstRect.top >> shift;
+            scalePlane(srcPlane + sy * srcStride + sx, srcStride,
+                ((srcRect.right + shift) >> shift) - sx, ((srcRect.bottom + shift) >> shift) - sy,
+                dstPlane + dy * dstStride + dx, dstStride,
+                ((dstRect.right + shift) >> shift) - dx, ((dstRect.bottom + shift) >> shift) - dy, 1);
+        }
+    }
+
+    dst.timestamp = src.timestamp;
+    dst.rotation = src.rotation;
+    return true;
+}
+
+void TRTCVideoScaler::fillModeRects(uint32_t srcWidth, uint32_t srcHeight, uint32_t dstWidth, uint32_t dstHeight,
+    TRTCVideoFillMode fillMode, RECT& srcRect, RECT& dstRect)
+{
+    srcRect.left = srcRect.top = 0;
+    srcRect.right = (LONG)srcWidth;
+    srcRect.bottom = (LONG)srcHeight;
+    dstRect.left = dstRect.top = 0;
+    dstRect.right = (LONG)dstWidth;
+    dstRect.bottom = (LONG)dstHeight;
+
+    //Ƚ srcWidth / srcHeight  dstWidth / dstHeight
+    bool bSrcWider = (uint64_t)srcWidth * dstHeight > (uint64_t)srcHeight * dstWidth;
+    if (fillMode == TRTCVideoFillMode_Fit)
+    {
+        //̱߾ڱ
+        if (bSrcWider)
+        {
+            LONG height = std::max<LONG>(1, (LONG)((uint64_t)srcHeight * dstWidth / srcWidth));
+            dstRect.top = ((LONG)dstHeight - height) / 2 & ~1;
+            dstRect.bottom = dstRect.top + height;
+        }
+        else
+        {
+            LONG width = std::max<LONG>(1, (LONG)((uint64_t)srcWidth * dstHeight / srcHeight));
+            dstRect.left = ((LONG)dstWidth - width) / 2 & ~1;
+            dstRect.right = dstRect.left + width;
+        }
+    }
+    else
+    {
+        //Ŀ껭棬ԴĲ־вõ
+        if (bSrcWider)
+        {
+            LONG width = std::max<LONG>(1, (LONG)((uint64_t)srcHeight * dstWidth / dstHeight));
+            srcRect.left = ((LONG)srcWidth - width) / 2 & ~1;
+            srcRect.right = srcRect.left + width;
+        }
+        else
+        {
+            LONG height = std::max<LONG>(1, (LONG)((uint64_t)srcWidth * dstHeight / dstWidth));
+            srcRect.top = ((LONG)srcHeight - height) / 2 & ~1;
+            srcRect.bottom = srcRect.top + height;
+        }
+    }
+}
+
+void TRTCVideoScaler::resolutionSize(TRTCVideoResolution resolution, TRTCVideoResolutionMode mode, uint32_t& width, uint32_t& height)
+{
+    switch (resolution)
+    {
+    case TRTCVideoResolution_120_120: width = 120; height = 120; break;
+    case TRTCVideoResolution_160_160: width = 160; height = 160; break;
+    case TRTCVideoResolution_270_270: width = 270; height = 270; break;
+    case TRTCVideoResolution_480_480: width = 480; height = 480; break;
+    case TRTCVideoResolution_160_120: width = 160; height = 120; break;
+    case TRTCVideoResolution_240_180: width = 240; height = 180; break;
+    case TRTCVideoResolution_280_210: width = 280; height = 210; break;
+    case TRTCVideoResolution_320_240: width = 320; height = 240; break;
+    case TRTCVideoResolution_400_300: width = 400; height = 300; break;
+    case TRTCVideoResolution_480_360: width = 480; height = 360; break;
+    case TRTCVideoResolution_640_480: width = 640; height = 480; break;
+    case TRTCVideoResolution_960_720: width = 960; height = 720; break;
+    case TRTCVideoResolution_160_90: width = 160; height = 90; break;
+    case TRTCVideoResolution_256_144: width = 256; height = 144; break;
+    case TRTCVideoResolution_320_180: width = 320; height = 180; break;
+    case TRTCVideoResolution_480_270: width = 480; height = 270; break;
+    case TRTCVideoResolution_960_540: width = 960; height = 540; break;
+    case TRTCVideoResolution_1280_720: width = 1280; height = 720; break;
+    case TRTCVideoResolution_1920_1080: width = 1920; height = 1080; break;
+    case TRTCVideoResolution_640_360:
+    default: width = 640; height = 360; break;
+    }
+    if (mode == TRTCVideoResolutionModePortrait)
+        std::swap(width, height);
+}
+
+uint32_t TRTCVideoScaler::cachedTableCount() const
+{
+    return (uint32_t)m_tables.size();
+}
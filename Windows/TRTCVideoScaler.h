@@ -0,0 +1,68 @@
+#pragma once
+/*
+* Module:   TRTCVideoScaler
+*
+* Function: ԶȾ·ϵĻţ I420  BGRA32  LiteAVVideoFrame ŵⴰڴС TRTCVideoResolution 涨ĳߴ
+*
+*    1. ֧˫ԡ˫κƽ˲ˮƽֱֿ㣻Сʱ˲ڰſݡ
+*
+*    2. ÿĳͷλú 14 λȨذ (˲ʽ, Դߴ, Ŀߴ) һű棬ֱʲʱÿ֡㡣
+*
+*    3. ֱԴмȨһ 16 λмˮƽ򰴱ȡͷȨ SSE2 ʵ֣
+*       ֱ NEON ʵ֣ñ롣
+*
+*    4. scaleFrame  TRTCVideoFillMode ߱ȣFill вõԴĲ֣Fit Ŀ껭߲ڱߡ
+*
+*    5. ʵڲлʱУڶ߳ͬʱʹãÿȾ̸߳һ
+*/
+
+#include "TRTCCloudDef.h"
+
+#include <vector>
+#include <memory>
+#include <stdint.h>
+
+enum TRTCScaleFilter
+{
+    TRTCScaleFilterBilinear = 0,
+    TRTCScaleFilterBicubic = 1,
+    TRTCScaleFilterArea = 2,        //ȨʺϴС
+};
+
+class TRTCVideoScaler
+{
+public:
+    explicit TRTCVideoScaler(TRTCScaleFilter filter = TRTCScaleFilterBilinear);
+    ~TRTCVideoScaler();
+
+    void setFilter(TRTCScaleFilter filter);
+    TRTCScaleFilter filter() const;
+
+    //һƽ棬channels Ϊ 1I420  YUV ƽ棩 4BGRA32
+    void scalePlane(const uint8_t* src, int srcStride, int srcWidth, int srcHeight,
+        uint8_t* dst, int dstStride, int dstWidth, int dstHeight, int channels);
+
+    //src  dst  videoFormat ֻ֧ͬ I420  BGRA32dst  widthheight ɵ÷д
+    //dst.data ɵ÷䣬 TRTCVideoConvert::frameLength ֽڣtimestamp  rotation  src 
+    bool scaleFrame(const TRTCVideoFrame& src, TRTCVideoFrame& dst, TRTCVideoFillMode fillMode);
+
+    //ʱõԴĿϽǶ뵽żԱ I420 ɫƽ
+    static void fillModeRects(uint32_t srcWidth, uint32_t srcHeight, uint32_t dstWidth, uint32_t dstHeight,
+        TRTCVideoFillMode fillMode, RECT& srcRect, RECT& dstRect);
+
+    //TRTCVideoResolution ӦĿߣģʽ
+    static void resolutionSize(TRTCVideoResolution resolution, TRTCVideoResolutionMode mode, uint32_t& width, uint32_t& height);
+
+    uint32_t cachedTableCount() const;
+
+    struct AxisTable;
+private:
+    TRTCVideoScaler(const TRTCVideoScaler&);
+    TRTCVideoScaler& operator =(const TRTCVideoScaler&);
+
+    std::shared_ptr<const AxisTable> axisTable(int srcSize, int dstSize);
+private:
+    TRTCScaleFilter m_filter;
+    std::vector<std::shared_ptr<const AxisTable>> m_tables;     //ùں
+    std::vector<int16_t> m_row;         //ֱȨм
+};
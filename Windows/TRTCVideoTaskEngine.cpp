@@ -0,0 +1,354 @@
+/*
+* Module:   TRTCVideoTaskEngine
+*
+* Function: ·֡п󽻸̳߳زִУͷȼ̴̵߳߳Ķ͵
+*/
+
+#include "TRTCVideoTaskEngine.h"
+#include "Base.h"
+#include "LatencyHistogram.h"
+
+#include <deque>
+#include <chrono>
+#include <algorithm>
+
+typedef std::chrono::steady_clock TaskClock;
+
+static const int kLaneCount = 3;
+
+// >  > С棬ͨԽСȼԽ
+static int laneOf(TRTCVideoStreamType streamType)
+{
+    switch (streamType)
+    {
+    case TRTCVideoStreamTypeBig: return 0;
+    case TRTCVideoStreamTypeSub: return 1;
+    default: return 2;
+    }
+}
+
+static uint64_t elapsedUs(TaskClock::time_point from, TaskClock::time_point to)
+{
+    return to > from ? (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(to - from).count() : 0;
+}
+
+//////////////////////////////////////////////////////////////////////////TRTCVideoTaskJob
+
+struct TRTCVideoTaskJob::State
+{
+    std::function<void(int, int)> func;
+    TRTCVideoStreamType streamType = TRTCVideoStreamTypeBig;
+    std::string stage;
+    int rowCount = 0;
+    int tileRows = 0;
+    int tileCount = 0;
+    TaskClock::time_point submitTime;
+    TaskClock::time_point startTime;    //ȡ 0 ߳д룬ɺŶȡ
+
+    std::atomic<int> nextTile;          //һδȡĿ
+    std::atomic<int> remaining;         //δִĿ
+    std::atomic<int> stolen;
+    std::atomic<uint64_t> workUs;
+
+    std::mutex mutex;                   //ֻڵȴ
+    std::condition_variable cond;
+    bool bDone = false;
+
+    TRTCVideoTaskEngine* engine = NULL;
+
+    State() : nextTile(0), remaining(0), stolen(0), workUs(0) {}
+
+    //ȡִһ飬ûпĿʱ false
+    bool runTile(bool bStolen)
+    {
+        int tile = nextTile.fetch_add(1);
+        if (tile >= tileCount)
+            return false;
+
+        TaskClock::time_point begin = TaskClock::now();
+        if (tile == 0)
+            startTime = begin;
+        if (bStolen)
+            ++stolen;
+
+        int row0 = tile * tileRows;
+        func(row0, std::min(row0 + tileRows, rowCount));
+        workUs += elapsedUs(begin, TaskClock::now());
+
+        if (remaining.fetch_sub(1) == 1)
+            engine->finishJob(*this);
+        return true;
+    }
+};
+
+TRTCVideoTaskJob::TRTCVideoTaskJob(const std::shared_ptr<State>& state)
+    : m_state(state)
+{
+}
+
+bool TRTCVideoTaskJob::isDone() const
+{
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    return m_state->bDone;
+}
+
+void TRTCVideoTaskJob::wait()
+{
+    //ȰִбʣµĿ飬Ӧ֮ᱻ
+    while (m_state->runTile(false))
+        ;
+
+    std::unique_lock<std::mutex> lock(m_state->mutex);
+    m_state->cond.wait(lock, [this] { return m_state->bDone; });
+}
+
+//////////////////////////////////////////////////////////////////////////TRTCVideoTaskEngine
+
+typedef std::shared_ptr<TRTCVideoTaskJob::State> JobPtr;
+
+struct TRTCVideoTaskEngine::Worker
+{
+    std::mutex mutex;
+    std::deque<JobPtr> lanes[kLaneCount];   //ÿԪһƣԼβȡ̴߳ͷ͵
+};
+
+struct TRTCVideoTaskEngine::StageRecord
+{
+    uint64_t jobCount = 0;
+    uint64_t tileCount = 0;
+    uint64_t stolenTileCount = 0;
+    uint64_t totalQueueUs = 0;
+    uint64_t maxQueueUs = 0;
+    uint64_t totalLatencyUs = 0;
+    uint64_t maxLatencyUs = 0;
+    uint64_t totalWorkUs = 0;
+    CLatencyHistogram queueHistogram;
+    CLatencyHistogram latencyHistogram;
+};
+
+TRTCVideoTaskEngine::TRTCVideoTaskEngine(uint32_t threadCount)
+    : m_nextWorker(0)
+    , m_pendingTokens(0)
+{
+    if (threadCount == 0)
+        threadCount = std::max<uint32_t>(std::thread::hardware_concurrency(), 1);
+
+    for (uint32_t i = 0; i < threadCount; ++i)
+        m_workers.push_back(std::unique_ptr<Worker>(new Worker()));
+    for (uint32_t i = 0; i < threadCount; ++i)
+        m_threads.push_back(std::thread(&TRTCVideoTaskEngine::workerThread, this, (size_t)i));
+}
+
+TRTCVideoTaskEngine::~TRTCVideoTaskEngine()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_bQuit = true;
+    }
+    m_sleepCond.notify_all();
+    for (size_t i = 0; i < m_threads.size(); ++i)
+        m_threads[i].join();
+}
+
+uint32_t TRTCVideoTaskEngine::threadCount() const
+{
+    return (uint32_t)m_workers.size();
+}
+
+std::shared_ptr<TRTCVideoTaskJob> TRTCVideoTaskEngine::submitRows(TRTCVideoStreamType streamType, const char* stage,
+    int rowCount, int tileRows, const std::function<void(int, int)>& func)
+{
+    JobPtr job = std::make_shared<TRTCVideoTaskJob::State>();
+    job->func = func;
+    job->streamType = streamType;
+    job->stage = stage ? stage : "";
+    job->rowCount = std::max(rowCount, 0);
+    job->tileRows = std::max(tileRows, 1);
+    job->tileCount = (job->rowCount + job->tileRows - 1) / job->tileRows;
+    job->remaining.store(job->tileCount);
+    job->engine = this;
+    job->submitTime = TaskClock::now();
+    job->startTime = job->submitTime;
+
+    std::shared_ptr<TRTCVideoTaskJob> handle(new TRTCVideoTaskJob(job));
+    if (job->tileCount == 0)
+    {
+        finishJob(*job);
+        return handle;
+    }
+
+    //Ŀָ̣߳ڵоͬһ߳ϴ
+    int lane = laneOf(streamType);
+    size_t workerCount = m_workers.size();
+    size_t first = m_nextWorker.fetch_add(1) % workerCount;
+    size_t perWorker = (job->tileCount + workerCount - 1) / workerCount;
+    int pushed = 0;
+    for (size_t w = 0; w < workerCount && pushed < job->tileCount; ++w)
+    {
+        Worker& worker = *m_workers[(first + w) % workerCount];
+        int count = (int)std::min<size_t>(perWorker, job->tileCount - pushed);
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        for (int i = 0; i < count; ++i)
+            worker.lanes[lane].push_back(job);
+        pushed += count;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_pendingTokens += job->tileCount;
+    }
+    if (job->tileCount > 1)
+        m_sleepCond.notify_all();
+    else
+        m_sleepCond.notify_one();
+    return handle;
+}
+
+void TRTCVideoTaskEngine::parallelRows(TRTCVideoStreamType streamType, const char* stage, int rowCount, int tileRows,
+    const std::function<void(int, int)>& func)
+{
+    submitRows(streamType, stage, rowCount, tileRows, func)->wait();
+}
+
+bool TRTCVideoTaskEngine::takeToken(size_t index, JobPtr& job, bool& bStolen)
+{
+    size_t workerCount = m_workers.size();
+    for (int lane = 0; lane < kLaneCount; ++lane)
+    {
+        for (size_t w = 0; w < workerCount; ++w)
+        {
+            Worker& worker = *m_workers[(index + w) % workerCount];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            std::deque<JobPtr>& tokens = worker.lanes[lane];
+            if (tokens.empty())
+                continue;
+
+            bStolen = (w != 0);
+            if (bStolen)
+            {
+                job = tokens.front();
+                tokens.pop_front();
+            }
+            else
+            {
+                job = tokens.back();
+                tokens.pop_back();
+            }
+            --m_pendingTokens;
+            return true;
+        }
+    }
+    return false;
+}
+
+void TRTCVideoTaskEngine::workerThread(size_t index)
+{
+    for (;;)
+    {
+        JobPtr job;
+        bool bStolen = false;
+        if (takeToken(index, job, bStolen))
+        {
+            //ƶӦĿѾȴ߳
+            job->runTile(bStolen);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_sleepCond.wait(lock, [this] { return m_bQuit || m_pendingTokens.load() > 0; });
+        if (m_bQuit && m_pendingTokens.load() <= 0)
+            break;
+    }
+}
+
+void TRTCVideoTaskEngine::finishJob(TRTCVideoTaskJob::State& job)
+{
+    TaskClock::time_point now = TaskClock::now();
+    uint64_t queueUs = elapsedUs(job.submitTime, job.startTime);
+    uint64_t latencyUs = elapsedUs(job.submitTime, now);
+    {
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        std::unique_ptr<StageRecord>& record = m_stages[std::make_pair(job.stage, (int)job.streamType)];
+        if (!record)
+            record.reset(new StageRecord());
+        record->jobCount += 1;
+        record->tileCount += job.tileCount;
+        record->stolenTileCount += job.stolen.load();
+        record->totalQueueUs += queueUs;
+        record->maxQueueUs = std::max(record->maxQueueUs, queueUs);
+        record->totalLatencyUs += latencyUs;
+        record->maxLatencyUs = std::max(record->maxLatencyUs, latencyUs);
+        record->totalWorkUs += job.workUs.load();
+        record->queueHistogram.Add(queueUs);
+        record->latencyHistogram.Add(latencyUs);
+    }
+
+    std::lock_guard<std::mutex> lock(job.mutex);
+    job.bDone = true;
+    job.cond.notify_all();
+}
+
+std::vector<TRTCVideoTaskStageStats> TRTCVideoTaskEngine::getStats() const
+{
+    std::vector<TRTCVideoTaskStageStats> result;
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    for (auto it = m_stages.begin(); it != m_stages.end(); ++it)
+    {
+        const StageRecord& record = *it->second;
+        TRTCVideoTaskStageStats stats;
+        stats.stage = it->first.first;
+        stats.streamType = (TRTCVideoStreamType)it->first.second;
+        stats.jobCount = record.jobCount;
+        stats.tileCount = record.tileCount;
+        stats.stolenTileCount = record.stolenTileCount;
+        stats.maxLatencyUs = record.maxLatencyUs;
+        if (record.jobCount > 0)
+        {
+            stats.avgQueueUs = record.totalQueueUs / record.jobCount;
+            stats.avgLatencyUs = record.totalLatencyUs / record.jobCount;
+            stats.avgWorkUs = record.totalWorkUs / record.jobCount;
+        }
+        stats.p99QueueUs = record.queueHistogram.P99(record.maxQueueUs);
+        stats.p99LatencyUs = record.latencyHistogram.P99(record.maxLatencyUs);
+        result.push_back(stats);
+    }
+
+    //ͬһ׶ΰͨȼ
+    std::stable_sort(result.begin(), result.end(), [](const TRTCVideoTaskStageStats& a, const TRTCVideoTaskStageStats& b) {
+        if (a.stage != b.stage)
+            return a.stage < b.stage;
+        return laneOf(a.streamType) < laneOf(b.streamType);
+    });
+    return result;
+}
+
+void TRTCVideoTaskEngine::resetStats()
+{
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    m_stages.clear();
+}
+
+static const char* streamTypeName(TRTCVideoStreamType streamType)
+{
+    switch (streamType)
+    {
+    case TRTCVideoStreamTypeBig: return "big";
+    case TRTCVideoStreamTypeSub: return "sub";
+    default: return "small";
+    }
+}
+
+std::string TRTCVideoTaskEngine::formatStats(const std::vector<TRTCVideoTaskStageStats>& stats)
+{
+    std::string report;
+    format_to(report, "%-12s %6s %8s %8s %8s %10s %10s %10s %10s %10s %10s\r\n",
+        "stage", "lane", "jobs", "tiles", "stolen", "avg queue", "p99 queue", "avg us", "p99 us", "max us", "work us");
+    for (size_t i = 0; i < stats.size(); ++i)
+    {
+        const TRTCVideoTaskStageStats& s = stats[i];
+        format_to(report, "%-12s %6s %8llu %8llu %8llu %10llu %10llu %10llu %10llu %10llu %10llu\r\n",
+            s.stage.c_str(), streamTypeName(s.streamType), s.jobCount, s.tileCount, s.stolenTileCount,
+            s.avgQueueUs, s.p99QueueUs, s.avgLatencyUs, s.p99LatencyUs, s.maxLatencyUs, s.avgWorkUs);
+    }
+    return report;
+}
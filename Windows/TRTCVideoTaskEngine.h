@@ -0,0 +1,111 @@
+#pragma once
+/*
+* Module:   TRTCVideoTaskEngine
+*
+* Function: ·֡תšӵȣп󽻸̳߳زִУȫеڻص߳
+*
+*    1. һύһ񣺰 [0, rowCount)  tileRows гɿ飬ͬһڲͬ߳ϴͬĿ顣
+*       첽ύ waitҲ parallelRows ύȴȴ̻߳һִбûʼĿ顣
+*
+*    2. ÿ̰߳ TRTCVideoStreamType ȼͨ >  > С棩һ˫˶С
+*       ύʱ鱻̵ֵ߳Ķ߳ȴԼĶβȡٴ̵߳Ķͷ͵
+*       ÿȡ鶼ȼͨ𣬴ĿСĿ鱻ִС
+*
+*    3. ŵġơִһڲԭӼ˵ȴֱ߳̿ȡĿ飬
+*       ߵĿӦ֮ȡʱֱӶ
+*
+*    4. getStats ׶, ͨÿ׶ε͵Ŀύʼִк͵ȫɵʱӣ
+*       p99  2 ݷͰͳƣͰϽ硣
+*/
+
+#include "TRTCCloudDef.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <map>
+#include <stdint.h>
+
+struct TRTCVideoTaskStageStats
+{
+    std::string stage;
+    TRTCVideoStreamType streamType = TRTCVideoStreamTypeBig;
+    uint64_t jobCount = 0;
+    uint64_t tileCount = 0;
+    uint64_t stolenTileCount = 0;       //̴̶߳߳͵Ŀ
+
+    //ύһ鿪ʼִУ΢룩
+    uint64_t avgQueueUs = 0;
+    uint64_t p99QueueUs = 0;
+    //ύһִ꣨΢룩
+    uint64_t avgLatencyUs = 0;
+    uint64_t p99LatencyUs = 0;
+    uint64_t maxLatencyUs = 0;
+    uint64_t avgWorkUs = 0;             //ÿпִʱ֮
+};
+
+class TRTCVideoTaskJob
+{
+public:
+    bool isDone() const;
+    //ȴɣȴڼڵǰִ߳бûʼĿ
+    void wait();
+
+    struct State;
+private:
+    friend class TRTCVideoTaskEngine;
+    explicit TRTCVideoTaskJob(const std::shared_ptr<State>& state);
+
+    std::shared_ptr<State> m_state;
+};
+
+class TRTCVideoTaskEngine
+{
+public:
+    //threadCount Ϊ 0 ʱȡ CPU 
+    explicit TRTCVideoTaskEngine(uint32_t threadCount = 0);
+    //ύȫִ˳
+    ~TRTCVideoTaskEngine();
+
+    uint32_t threadCount() const;
+
+    //func(row0, row1)  [row0, row1) Уڶ߳ͬʱãstage ΪͳõĽ׶
+    std::shared_ptr<TRTCVideoTaskJob> submitRows(TRTCVideoStreamType streamType, const char* stage, int rowCount, int tileRows,
+        const std::function<void(int, int)>& func);
+    //ύȴ
+    void parallelRows(TRTCVideoStreamType streamType, const char* stage, int rowCount, int tileRows,
+        const std::function<void(int, int)>& func);
+
+    std::vector<TRTCVideoTaskStageStats> getStats() const;
+    void resetStats();
+    static std::string formatStats(const std::vector<TRTCVideoTaskStageStats>& stats);
+
+    struct Worker;
+    struct StageRecord;
+private:
+    friend struct TRTCVideoTaskJob::State;
+
+    TRTCVideoTaskEngine(const TRTCVideoTaskEngine&);
+    TRTCVideoTaskEngine& operator =(const TRTCVideoTaskEngine&);
+
+    void workerThread(size_t index);
+    bool takeToken(size_t index, std::shared_ptr<TRTCVideoTaskJob::State>& job, bool& bStolen);
+    void finishJob(TRTCVideoTaskJob::State& job);
+private:
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::vector<std::thread> m_threads;
+    std::atomic<uint32_t> m_nextWorker;
+
+    std::atomic<int64_t> m_pendingTokens;   //ж
+    std::mutex m_sleepMutex;
+    std::condition_variable m_sleepCond;
+    bool m_bQuit = false;
+
+    mutable std::mutex m_statsMutex;
+    std::map<std::pair<std::string, int>, std::unique_ptr<StageRecord>> m_stages;
+};
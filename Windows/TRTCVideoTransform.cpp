@@ -0,0 +1,541 @@
+/*
+* Module:   TRTCVideoTransform
+*
+* Function:  LiteAVVideoFrame ĸʽת rotation ˳ʱת setLocalVideoMirror Ҿϳһα
+*/
+
+#include "TRTCVideoTransform.h"
+#include "Base.h"
+#include "Benchmark.h"
+
+#include <random>
+#include <algorithm>
+#include <string.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define VIDEO_TRANSFORM_SSE2
+#endif
+
+static const int kBlockSize = 32;       //ֿ߳أBGRA32 һ 4KB64 ʱ 720p ת 90/270 Ա
+
+//һ֡ĸƽ棬I420 Ϊ YUV ƽ棬BGRA32 Ϊһƽ
+struct FramePlanes
+{
+    int count;
+    int pixelSize;
+    uint8_t* data[3];
+    int stride[3];
+    int width[3];
+    int height[3];
+};
+
+static FramePlanes framePlanes(uint8_t* data, TRTCVideoPixelFormat format, int width, int height)
+{
+    FramePlanes planes;
+    memset(&planes, 0, sizeof(planes));
+    if (format == TRTCVideoPixelFormat_BGRA32)
+    {
+        planes.count = 1;
+        planes.pixelSize = 4;
+        planes.data[0] = data;
+        planes.stride[0] = width * 4;
+        planes.width[0] = width;
+        planes.height[0] = height;
+        return planes;
+    }
+
+    int chromaWidth = (width + 1) / 2;
+    int chromaHeight = (height + 1) / 2;
+    planes.count = 3;
+    planes.pixelSize = 1;
+    for (int i = 0; i < 3; ++i)
+    {
+        planes.stride[i] = planes.width[i] = i == 0 ? width : chromaWidth;
+        planes.height[i] = i == 0 ? height : chromaHeight;
+    }
+    if (data != NULL)
+    {
+        planes.data[0] = data;
+        planes.data[1] = data + width * height;
+        planes.data[2] = planes.data[1] + chromaWidth * chromaHeight;
+    }
+    return planes;
+}
+
+//Դƽ (x, y) дĿƽ origin + x * colStep + y * rowStepֽƫƣ
+struct PlaneOrientation
+{
+    ptrdiff_t origin;
+    ptrdiff_t colStep;
+    ptrdiff_t rowStep;
+};
+
+static PlaneOrientation planeOrientation(int width, int height, int pixelSize, int dstStride, TRTCVideoRotation rotation, bool bMirror)
+{
+    //Ŀ ox = ax * x + bx * y + cxoy = ay * x + by * y + cy
+    int ax = 1, bx = 0, cx = 0;
+    int ay = 0, by = 1, cy = 0;
+    int outWidth = width;
+    switch (rotation)
+    {
+    case TRTCVideoRotation90:
+        ax = 0; bx = -1; cx = height - 1;
+        ay = 1; by = 0; cy = 0;
+        outWidth = height;
+        break;
+    case TRTCVideoRotation180:
+        ax = -1; bx = 0; cx = width - 1;
+        ay = 0; by = -1; cy = height - 1;
+        break;
+    case TRTCVideoRotation270:
+        ax = 0; bx = 1; cx = 0;
+        ay = -1; by = 0; cy = width - 1;
+        outWidth = height;
+        break;
+    default:
+        break;
+    }
+    //ת֮󣬶ӦʾĻҷת
+    if (bMirror)
+    {
+        ax = -ax;
+        bx = -bx;
+        cx = outWidth - 1 - cx;
+    }
+
+    PlaneOrientation orientation;
+    orientation.origin = (ptrdiff_t)cx * pixelSize + (ptrdiff_t)cy * dstStride;
+    orientation.colStep = (ptrdiff_t)ax * pixelSize + (ptrdiff_t)ay * dstStride;
+    orientation.rowStep = (ptrdiff_t)bx * pixelSize + (ptrdiff_t)by * dstStride;
+    return orientation;
+}
+
+static void orientPixels(const uint8_t* src, int srcStride, int x0, int x1, int y0, int y1, int pixelSize,
+    uint8_t* dst, ptrdiff_t colStep, ptrdiff_t rowStep)
+{
+    for (int y = y0; y < y1; ++y)
+    {
+        const uint8_t* s = src + y * srcStride;
+        uint8_t* d = dst + y * rowStep;
+        if (pixelSize == 1)
+        {
+            for (int x = x0; x < x1; ++x)
+                d[x * colStep] = s[x];
+        }
+        else
+        {
+            for (int x = x0; x < x1; ++x)
+                memcpy(d + x * colStep, s + x * 4, 4);
+        }
+    }
+}
+
+//dst ָ 0 صλã x д dst - x * pixelSize
+static void reverseRow(const uint8_t* src, uint8_t* dst, int width, int pixelSize, bool bSimd)
+{
+    int x = 0;
+#if defined(VIDEO_TRANSFORM_SSE2)
+    if (bSimd && pixelSize == 1)
+    {
+        for (; x + 16 <= width; x += 16)
+        {
+            //ȷת 4  32 λٷת 32 λڵ 16 λ󽻻 16 λڵֽ
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x));
+            v = _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));
+            v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+            v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst - x - 15), v);
+        }
+    }
+    else if (bSimd)
+    {
+        for (; x + 4 <= width; x += 4)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * 4));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst - (x + 3) * 4), _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3)));
+        }
+    }
+#endif
+    orientPixels(src, 0, x, width, 0, 1, pixelSize, dst, -pixelSize, 0);
+}
+
+#if defined(VIDEO_TRANSFORM_SSE2)
+
+//8x8 ֽתãrowStep Ϊ -1 ʱԴУÿһжַд
+static void transpose8x8SSE2(const uint8_t* src, int srcStride, uint8_t* dst, ptrdiff_t colStep, ptrdiff_t rowStep)
+{
+    __m128i r[8];
+    for (int i = 0; i < 8; ++i)
+        r[i] = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + (rowStep > 0 ? i : 7 - i) * srcStride));
+    if (rowStep < 0)
+        dst += 7 * rowStep;
+
+    __m128i t0 = _mm_unpacklo_epi8(r[0], r[1]);
+    __m128i t1 = _mm_unpacklo_epi8(r[2], r[3]);
+    __m128i t2 = _mm_unpacklo_epi8(r[4], r[5]);
+    __m128i t3 = _mm_unpacklo_epi8(r[6], r[7]);
+    __m128i u0 = _mm_unpacklo_epi16(t0, t1);
+    __m128i u1 = _mm_unpackhi_epi16(t0, t1);
+    __m128i u2 = _mm_unpacklo_epi16(t2, t3);
+    __m128i u3 = _mm_unpackhi_epi16(t2, t3);
+    //ÿĴ
+    __m128i cols[4] = {
+        _mm_unpacklo_epi32(u0, u2),
+        _mm_unpackhi_epi32(u0, u2),
+        _mm_unpacklo_epi32(u1, u3),
+        _mm_unpackhi_epi32(u1, u3),
+    };
+    for (int i = 0; i < 4; ++i)
+    {
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + (2 * i) * colStep), cols[i]);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + (2 * i + 1) * colStep), _mm_unpackhi_epi64(cols[i], cols[i]));
+    }
+}
+
+//4x4 أ32 λת
+static void transpose4x4SSE2(const uint8_t* src, int srcStride, uint8_t* dst, ptrdiff_t colStep, ptrdiff_t rowStep)
+{
+    __m128i r[4];
+    for (int i = 0; i < 4; ++i)
+        r[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + (rowStep > 0 ? i : 3 - i) * srcStride));
+    if (rowStep < 0)
+        dst += 3 * rowStep;
+
+    __m128i t0 = _mm_unpacklo_epi32(r[0], r[1]);
+    __m128i t1 = _mm_unpacklo_epi32(r[2], r[3]);
+    __m128i t2 = _mm_unpackhi_epi32(r[0], r[1]);
+    __m128i t3 = _mm_unpackhi_epi32(r[2], r[3]);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi64(t0, t1));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + colStep), _mm_unpackhi_epi64(t0, t1));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * colStep), _mm_unpacklo_epi64(t2, t3));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 3 * colStep), _mm_unpackhi_epi64(t2, t3));
+}
+
+#endif
+
+//Դƽ width x height һдĿλãdst ΪһϽĿƽϵĵַ
+static void orientBlock(const uint8_t* src, int srcStride, int width, int height, int pixelSize,
+    uint8_t* dst, ptrdiff_t colStep, ptrdiff_t rowStep, bool bSimd)
+{
+    if (colStep == pixelSize)
+    {
+        for (int y = 0; y < height; ++y)
+            memcpy(dst + y * rowStep, src + y * srcStride, width * pixelSize);
+        return;
+    }
+    if (colStep == -pixelSize)
+    {
+        for (int y = 0; y < height; ++y)
+            reverseRow(src + y * srcStride, dst + y * rowStep, width, pixelSize, bSimd);
+        return;
+    }
+
+    //ת 90/270 ȣԴһбĿһ
+    int y = 0;
+#if defined(VIDEO_TRANSFORM_SSE2)
+    if (bSimd)
+    {
+        const int tile = pixelSize == 1 ? 8 : 4;
+        for (; y + tile <= height; y += tile)
+        {
+            int x = 0;
+            for (; x + tile <= width; x += tile)
+            {
+                const uint8_t* s = src + y * srcStride + x * pixelSize;
+                uint8_t* d = dst + x * colStep + y * rowStep;
+                if (pixelSize == 1)
+                    transpose8x8SSE2(s, srcStride, d, colStep, rowStep);
+                else
+                    transpose4x4SSE2(s, srcStride, d, colStep, rowStep);
+            }
+            orientPixels(src, srcStride, x, width, y, y + tile, pixelSize, dst, colStep, rowStep);
+        }
+    }
+#endif
+    orientPixels(src, srcStride, 0, width, y, height, pixelSize, dst, colStep, rowStep);
+}
+
+static bool checkFrames(const TRTCVideoFrame& src, const TRTCVideoFrame& dst, TRTCVideoRotation rotation, uint32_t& outWidth, uint32_t& outHeight)
+{
+    if (src.bufferType != TRTCVideoBufferType_Buffer || src.data == NULL || dst.data == NULL || src.width == 0 || src.height == 0)
+        return false;
+    if ((src.videoFormat != TRTCVideoPixelFormat_I420 && src.videoFormat != TRTCVideoPixelFormat_BGRA32)
+        || (dst.videoFormat != TRTCVideoPixelFormat_I420 && dst.videoFormat != TRTCVideoPixelFormat_BGRA32)
+        || rotation < TRTCVideoRotation0 || rotation > TRTCVideoRotation270)
+        return false;
+
+    TRTCVideoTransform::rotatedSize(src.width, src.height, rotation, outWidth, outHeight);
+    return src.length >= TRTCVideoConvert::frameLength(src.videoFormat, src.width, src.height)
+        && dst.length >= TRTCVideoConvert::frameLength(dst.videoFormat, outWidth, outHeight);
+}
+
+static void finishFrame(const TRTCVideoFrame& src, TRTCVideoFrame& dst, uint32_t outWidth, uint32_t outHeight)
+{
+    dst.bufferType = TRTCVideoBufferType_Buffer;
+    dst.length = TRTCVideoConvert::frameLength(dst.videoFormat, outWidth, outHeight);
+    dst.width = outWidth;
+    dst.height = outHeight;
+    dst.timestamp = src.timestamp;
+    dst.rotation = TRTCVideoRotation0;
+}
+
+//////////////////////////////////////////////////////////////////////////TRTCVideoTransform
+
+void TRTCVideoTransform::rotatedSize(uint32_t width, uint32_t height, TRTCVideoRotation rotation, uint32_t& outWidth, uint32_t& outHeight)
+{
+    bool bSwap = rotation == TRTCVideoRotation90 || rotation == TRTCVideoRotation270;
+    outWidth = bSwap ? height : width;
+    outHeight = bSwap ? width : height;
+}
+
+bool TRTCVideoTransform::transformFrame(const TRTCVideoFrame& src, TRTCVideoFrame& dst, TRTCVideoRotation rotation, bool bMirror,
+    const TRTCColorSpace& colorSpace, TRTCConvertKernel kernel)
+{
+    uint32_t outWidth = 0;
+    uint32_t outHeight = 0;
+    if (!checkFrames(src, dst, rotation, outWidth, outHeight))
+        return false;
+
+    if (rotation == TRTCVideoRotation0 && !bMirror)
+    {
+        if (!TRTCVideoConvert::convertFrame(src, dst, colorSpace, kernel))
+            return false;
+        dst.rotation = TRTCVideoRotation0;
+        return true;
+    }
+
+    int width = (int)src.width;
+    int height = (int)src.height;
+    bool bSimd = kernel != TRTCConvertKernelScalar;
+    FramePlanes in = framePlanes(reinterpret_cast<uint8_t*>(src.data), src.videoFormat, width, height);
+    FramePlanes out = framePlanes(reinterpret_cast<uint8_t*>(dst.data), dst.videoFormat, (int)outWidth, (int)outHeight);
+    //תתǰƽߴ磬ÿƽд
+    FramePlanes converted = framePlanes(NULL, dst.videoFormat, width, height);
+    PlaneOrientation orientations[3];
+    for (int p = 0; p < out.count; ++p)
+        orientations[p] = planeOrientation(converted.width[p], converted.height[p], out.pixelSize, out.stride[p], rotation, bMirror);
+
+    //һתĽʽͬʱ
+    alignas(16) uint8_t block[kBlockSize * kBlockSize * 4];
+    const int blockStride[3] = { kBlockSize * out.pixelSize, kBlockSize / 2, kBlockSize / 2 };
+    uint8_t* blockPlanes[3] = { block, block + kBlockSize * kBlockSize, block + kBlockSize * kBlockSize + kBlockSize * kBlockSize / 4 };
+
+    bool bConvert = src.videoFormat != dst.videoFormat;
+    for (int by = 0; by < height; by += kBlockSize)
+    {
+        int bh = std::min(kBlockSize, height - by);
+        for (int bx = 0; bx < width; bx += kBlockSize)
+        {
+            int bw = std::min(kBlockSize, width - bx);
+            if (bConvert && src.videoFormat == TRTCVideoPixelFormat_I420)
+            {
+                TRTCVideoConvert::i420ToBGRA(in.data[0] + by * in.stride[0] + bx, in.stride[0],
+                    in.data[1] + (by / 2) * in.stride[1] + bx / 2, in.stride[1],
+                    in.data[2] + (by / 2) * in.stride[2] + bx / 2, in.stride[2],
+                    block, blockStride[0], bw, bh, colorSpace, kernel);
+            }
+            else if (bConvert)
+            {
+                TRTCVideoConvert::bgraToI420(in.data[0] + by * in.stride[0] + bx * 4, in.stride[0],
+                    blockPlanes[0], blockStride[0], blockPlanes[1], blockStride[1], blockPlanes[2], blockStride[2],
+                    bw, bh, colorSpace, kernel);
+            }
+
+            for (int p = 0; p < out.count; ++p)
+            {
+                //ɫƽĿʹС룬һȡ
+                int shift = p == 0 ? 0 : 1;
+                int x = bx >> shift;
+                int y = by >> shift;
+                int w = (bw + shift) >> shift;
+                int h = (bh + shift) >> shift;
+                const PlaneOrientation& o = orientations[p];
+                const uint8_t* s = bConvert ? blockPlanes[p] : in.data[p] + y * in.stride[p] + x * in.pixelSize;
+                int sStride = bConvert ? blockStride[p] : in.stride[p];
+                orientBlock(s, sStride, w, h, out.pixelSize, out.data[p] + o.origin + x * o.colStep + y * o.rowStep,
+                    o.colStep, o.rowStep, bSimd);
+            }
+        }
+    }
+
+    finishFrame(src, dst, outWidth, outHeight);
+    return true;
+}
+
+bool TRTCVideoTransform::transformFrameMultiPass(const TRTCVideoFrame& src, TRTCVideoFrame& dst, TRTCVideoRotation rotation, bool bMirror,
+    std::vector<uint8_t>& scratch, const TRTCColorSpace& colorSpace, TRTCConvertKernel kernel)
+{
+    uint32_t outWidth = 0;
+    uint32_t outHeight = 0;
+    if (!checkFrames(src, dst, rotation, outWidth, outHeight))
+        return false;
+
+    int width = (int)src.width;
+    int height = (int)src.height;
+    uint32_t length = TRTCVideoConvert::frameLength(dst.videoFormat, outWidth, outHeight);
+    if (scratch.size() < (size_t)length * 2)
+        scratch.resize((size_t)length * 2);
+
+    //һ飺֡תʽͬʱ
+    uint8_t* converted = reinterpret_cast<uint8_t*>(src.data);
+    if (src.videoFormat != dst.videoFormat)
+    {
+        TRTCVideoFrame convertedFrame = dst;
+        convertedFrame.data = reinterpret_cast<char*>(&scratch[0]);
+        convertedFrame.length = length;
+        if (!TRTCVideoConvert::convertFrame(src, convertedFrame, colorSpace, kernel))
+            return false;
+        converted = &scratch[0];
+    }
+
+    //ڶ飺תתʱ
+    FramePlanes in = framePlanes(converted, dst.videoFormat, width, height);
+    FramePlanes mid = in;
+    int pixelSize = in.pixelSize;
+    if (rotation != TRTCVideoRotation0)
+    {
+        mid = framePlanes(&scratch[length], dst.videoFormat, (int)outWidth, (int)outHeight);
+        for (int p = 0; p < in.count; ++p)
+        {
+            int w = in.width[p];
+            int h = in.height[p];
+            for (int oy = 0; oy < mid.height[p]; ++oy)
+            {
+                for (int ox = 0; ox < mid.width[p]; ++ox)
+                {
+                    int sx = w - 1 - ox;
+                    int sy = h - 1 - oy;
+                    if (rotation == TRTCVideoRotation90)
+                    {
+                        sx = oy;
+                        sy = h - 1 - ox;
+                    }
+                    else if (rotation == TRTCVideoRotation270)
+                    {
+                        sx = w - 1 - oy;
+                        sy = ox;
+                    }
+                    memcpy(mid.data[p] + oy * mid.stride[p] + ox * pixelSize, in.data[p] + sy * in.stride[p] + sx * pixelSize, pixelSize);
+                }
+            }
+        }
+    }
+
+    //飺ҷתתʱ dst
+    FramePlanes out = framePlanes(reinterpret_cast<uint8_t*>(dst.data), dst.videoFormat, (int)outWidth, (int)outHeight);
+    for (int p = 0; p < out.count; ++p)
+    {
+        int w = out.width[p];
+        for (int y = 0; y < out.height[p]; ++y)
+        {
+            const uint8_t* s = mid.data[p] + y * mid.stride[p];
+            uint8_t* d = out.data[p] + y * out.stride[p];
+            if (!bMirror)
+            {
+                memcpy(d, s, w * pixelSize);
+                continue;
+            }
+            for (int x = 0; x < w; ++x)
+                memcpy(d + x * pixelSize, s + (w - 1 - x) * pixelSize, pixelSize);
+        }
+    }
+
+    finishFrame(src, dst, outWidth, outHeight);
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////ܲ
+
+static TRTCVideoFrame makeBenchFrame(TRTCVideoPixelFormat format, std::vector<char>& buffer, uint32_t width, uint32_t height)
+{
+    TRTCVideoFrame frame;
+    frame.videoFormat = format;
+    frame.bufferType = TRTCVideoBufferType_Buffer;
+    frame.data = buffer.data();
+    frame.length = (uint32_t)buffer.size();
+    frame.width = width;
+    frame.height = height;
+    return frame;
+}
+
+std::vector<TRTCVideoTransformBenchResult> TRTCVideoTransform::runBenchmark(uint32_t durationMs)
+{
+    static const uint32_t kSizes[][2] = { { 640, 360 }, { 1280, 720 }, { 1920, 1080 } };
+    static const TRTCVideoPixelFormat kFormats[][2] = {
+        { TRTCVideoPixelFormat_I420, TRTCVideoPixelFormat_BGRA32 },
+        { TRTCVideoPixelFormat_BGRA32, TRTCVideoPixelFormat_I420 },
+        { TRTCVideoPixelFormat_I420, TRTCVideoPixelFormat_I420 },
+        { TRTCVideoPixelFormat_BGRA32, TRTCVideoPixelFormat_BGRA32 },
+    };
+    static const TRTCVideoRotation kRotations[] = { TRTCVideoRotation0, TRTCVideoRotation90, TRTCVideoRotation180, TRTCVideoRotation270 };
+
+    std::vector<TRTCVideoTransformBenchResult> results;
+    std::mt19937 random(20190101);
+    for (size_t i = 0; i < _countof(kSizes); ++i)
+    {
+        uint32_t width = kSizes[i][0];
+        uint32_t height = kSizes[i][1];
+        for (size_t f = 0; f < _countof(kFormats); ++f)
+        {
+            std::vector<char> input(TRTCVideoConvert::frameLength(kFormats[f][0], width, height));
+            for (size_t j = 0; j < input.size(); ++j)
+                input[j] = (char)random();
+            std::vector<char> fused(TRTCVideoConvert::frameLength(kFormats[f][1], width, height));
+            std::vector<char> multiPass(fused.size());
+            TRTCVideoFrame src = makeBenchFrame(kFormats[f][0], input, width, height);
+
+            for (size_t r = 0; r < _countof(kRotations); ++r)
+            {
+                for (int mirror = 0; mirror < 2; ++mirror)
+                {
+                    TRTCVideoTransformBenchResult result;
+                    result.width = width;
+                    result.height = height;
+                    result.srcFormat = kFormats[f][0];
+                    result.dstFormat = kFormats[f][1];
+                    result.rotation = kRotations[r];
+                    result.bMirror = mirror != 0;
+
+                    TRTCVideoFrame fusedFrame = makeBenchFrame(result.dstFormat, fused, width, height);
+                    TRTCVideoFrame multiPassFrame = makeBenchFrame(result.dstFormat, multiPass, width, height);
+                    std::vector<uint8_t> scratch;
+                    result.fusedMs = MeasureAverageMs(durationMs, [&]() {
+                        transformFrame(src, fusedFrame, result.rotation, result.bMirror);
+                    });
+                    result.multiPassMs = MeasureAverageMs(durationMs, [&]() {
+                        transformFrameMultiPass(src, multiPassFrame, result.rotation, result.bMirror, scratch);
+                    });
+                    result.bMatch = fused == multiPass;
+                    results.push_back(result);
+                }
+            }
+        }
+    }
+    return results;
+}
+
+static const char* formatName(TRTCVideoPixelFormat format)
+{
+    return format == TRTCVideoPixelFormat_I420 ? "i420" : "bgra";
+}
+
+std::string TRTCVideoTransform::formatBenchmark(const std::vector<TRTCVideoTransformBenchResult>& results)
+{
+    std::string report;
+    format_to(report, "%10s %10s %6s %6s %10s %13s %8s %6s\r\n",
+        "resolution", "format", "rotate", "mirror", "fused ms", "multipass ms", "speedup", "match");
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const TRTCVideoTransformBenchResult& r = results[i];
+        char resolution[32] = { 0 };
+        char format[32] = { 0 };
+        _snprintf_s(resolution, _countof(resolution), _TRUNCATE, "%ux%u", r.width, r.height);
+        _snprintf_s(format, _countof(format), _TRUNCATE, "%s>%s", formatName(r.srcFormat), formatName(r.dstFormat));
+        format_to(report, "%10s %10s %6d %6s %10.3f %13.3f %8.2f %6s\r\n",
+            resolution, format, (int)r.rotation * 90, r.bMirror ? "yes" : "no",
+            r.fusedMs, r.multiPassMs, r.fusedMs > 0 ? r.multiPassMs / r.fusedMs : 0.0,
+            r.bMatch ? "yes" : "NO");
+    }
+    return report;
+}
@@ -0,0 +1,58 @@
+#pragma once
+/*
+* Module:   TRTCVideoTransform
+*
+* Function:  LiteAVVideoFrame ĸʽת rotation ˳ʱת setLocalVideoMirror Ҿϳһα
+*
+*    1. Դ水 32x32 ֿ鴦 TRTCVideoConvert תһתĿʽڻٰһдתλã
+*       ԴĿÿֻֽڴһΡʽͬʱʡתֱӴԴдĿλá
+*
+*    2. ת 90/270 ൱תãSSE2 ° 8x8 ֽڣI420 ƽ棩 4x4 أBGRA32СڼĴתã
+*       ֻоת 180 ʱзת
+*
+*    3. תԴķϽУI420 ɫƽ水ͬķʽת롰תתپ鴦ֽһ¡
+*
+*    4. transformFrameMultiPass 鴦runBenchmark ܶղУ
+*/
+
+#include "TRTCCloudDef.h"
+#include "TRTCVideoConvert.h"
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+struct TRTCVideoTransformBenchResult
+{
+    uint32_t width = 0;
+    uint32_t height = 0;
+    TRTCVideoPixelFormat srcFormat = TRTCVideoPixelFormat_I420;
+    TRTCVideoPixelFormat dstFormat = TRTCVideoPixelFormat_I420;
+    TRTCVideoRotation rotation = TRTCVideoRotation0;
+    bool bMirror = false;
+    double fusedMs = 0;             //֡ƽʱ룩
+    double multiPassMs = 0;
+    bool bMatch = true;             //һ
+};
+
+class TRTCVideoTransform
+{
+public:
+    //תĿߣ90/270 ʱ
+    static void rotatedSize(uint32_t width, uint32_t height, TRTCVideoRotation rotation, uint32_t& outWidth, uint32_t& outHeight);
+
+    // src ת dst.videoFormatI420  BGRA32˳ʱת rotation ٰ bMirror ҷת
+    //dst.data ɵ÷䣬 frameLength ֽڣɹʱд dst  lengthתĿߺʱdst.rotation Ϊ 0
+    static bool transformFrame(const TRTCVideoFrame& src, TRTCVideoFrame& dst, TRTCVideoRotation rotation, bool bMirror,
+        const TRTCColorSpace& colorSpace = TRTCColorSpace(), TRTCConvertKernel kernel = TRTCConvertKernelAuto);
+
+    //֡ת֡ת֡תɣͽ transformFrame ͬscratch мʱ
+    static bool transformFrameMultiPass(const TRTCVideoFrame& src, TRTCVideoFrame& dst, TRTCVideoRotation rotation, bool bMirror,
+        std::vector<uint8_t>& scratch, const TRTCColorSpace& colorSpace = TRTCColorSpace(), TRTCConvertKernel kernel = TRTCConvertKernelAuto);
+
+    //ֳ÷ֱÿָʽϡתǶȺ; durationMs 
+    static std::vector<TRTCVideoTransformBenchResult> runBenchmark(uint32_t durationMs = 50);
+    static std::string formatBenchmark(const std::vector<TRTCVideoTransformBenchResult>& results);
+private:
+    TRTCVideoTransform();
+};
@@ -0,0 +1,402 @@
+/*
+* Module:   TRTCVideoWatermark
+*
+* Function:  TRTCCloud::setWaterMark ĲڱػϵˮӡÿֱַֻԤšԤһΣÿֻ֡ˮӡǵ
+*/
+
+#include "TRTCVideoWatermark.h"
+
+#include <algorithm>
+#include <string.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define VIDEO_WATERMARK_SSE2
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#include <arm_neon.h>
+#define VIDEO_WATERMARK_NEON
+#endif
+
+static const size_t kMaxLayoutCount = 4;
+
+static int markIndex(TRTCVideoStreamType streamType)
+{
+    switch (streamType)
+    {
+    case TRTCVideoStreamTypeBig: return 0;
+    case TRTCVideoStreamTypeSub: return 1;
+    default: return -1;
+    }
+}
+
+static inline uint8_t div255(uint32_t value)
+{
+    //value  255 * 255 value / 255 
+    value += 128;
+    return (uint8_t)((value + (value >> 8)) >> 8);
+}
+
+//dst = premul + dst * inv / 255inv Ϊ 255 - alpha
+static void blendRow(uint8_t* dst, const uint8_t* premul, const uint8_t* inv, int count)
+{
+    int x = 0;
+#if defined(VIDEO_WATERMARK_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi16(128);
+    for (; x + 16 <= count; x += 16)
+    {
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + x));
+        __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(premul + x));
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inv + x));
+        //ֵ 255 * 255 + 128 + 254  16 λ޷ŷΧڣ߼
+        __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), _mm_unpacklo_epi8(a, zero)), round);
+        __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), _mm_unpackhi_epi8(a, zero)), round);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), _mm_adds_epu8(_mm_packus_epi16(lo, hi), p));
+    }
+#elif defined(VIDEO_WATERMARK_NEON)
+    const uint16x8_t round = vdupq_n_u16(128);
+    for (; x + 16 <= count; x += 16)
+    {
+        uint8x16_t d = vld1q_u8(dst + x);
+        uint8x16_t p = vld1q_u8(premul + x);
+        uint8x16_t a = vld1q_u8(inv + x);
+        uint16x8_t lo = vaddq_u16(vmull_u8(vget_low_u8(d), vget_low_u8(a)), round);
+        uint16x8_t hi = vaddq_u16(vmull_u8(vget_high_u8(d), vget_high_u8(a)), round);
+        uint8x16_t mixed = vcombine_u8(vshrn_n_u16(vsraq_n_u16(lo, lo, 8), 8), vshrn_n_u16(vsraq_n_u16(hi, hi, 8), 8));
+        vst1q_u8(dst + x, vqaddq_u8(mixed, p));
+    }
+#endif
+    for (; x < count; ++x)
+        dst[x] = (uint8_t)std::min<uint32_t>(premul[x] + div255(dst[x] * inv[x]), 255);
+}
+
+//////////////////////////////////////////////////////////////////////////Mark / Layout
+
+struct TRTCVideoWatermark::Mark
+{
+    uint32_t width = 0;
+    uint32_t height = 0;
+    float xOffset = 0;
+    float yOffset = 0;
+    float widthRatio = 0;
+    std::vector<uint8_t> premultiplied;     //Ԥ alpha  BGRA
+    std::vector<std::shared_ptr<const Layout>> layouts;     //ùں
+};
+
+//һֱʺ͸ʽ׼õˮӡֻ滭ڿɼĲ
+struct TRTCVideoWatermark::Layout
+{
+    TRTCVideoPixelFormat format = TRTCVideoPixelFormat_I420;
+    uint32_t frameWidth = 0;
+    uint32_t frameHeight = 0;
+    RECT rect;                      //ɼI420 ʱϽż
+    //BGRA32 ֻõ 0 ƽ棻I420  YUVȾп
+    int planeWidth[3];
+    int planeHeight[3];
+    std::vector<uint8_t> premul[3];
+    std::vector<uint8_t> inv[3];    //I420  UV  inv[1]
+
+    Layout()
+    {
+        SetRectEmpty(&rect);
+        memset(planeWidth, 0, sizeof(planeWidth));
+        memset(planeHeight, 0, sizeof(planeHeight));
+    }
+};
+
+//ˮӡڻϵ򣨲üI420 ʱϽǺͿ߶뵽ż
+static void markRect(const TRTCVideoWatermark::Mark& mark, TRTCVideoPixelFormat format, uint32_t width, uint32_t height, RECT& rect)
+{
+    int x = (int)(mark.xOffset * width);
+    int y = (int)(mark.yOffset * height);
+    int w = (int)(mark.widthRatio * width + 0.5f);
+    int h = (int)((double)w * mark.height / mark.width + 0.5);
+    if (format == TRTCVideoPixelFormat_I420)
+    {
+        x &= ~1;
+        y &= ~1;
+        w = (w + 1) & ~1;
+        h = (h + 1) & ~1;
+    }
+    SetRect(&rect, x, y, x + w, y + h);
+}
+
+static void clipRect(const RECT& full, uint32_t width, uint32_t height, RECT& rect)
+{
+    RECT frame;
+    SetRect(&frame, 0, 0, (int)width, (int)height);
+    if (full.right <= full.left || full.bottom <= full.top || !IntersectRect(&rect, &full, &frame))
+        SetRectEmpty(&rect);
+}
+
+//////////////////////////////////////////////////////////////////////////TRTCVideoWatermark
+
+TRTCVideoWatermark::TRTCVideoWatermark()
+{
+}
+
+TRTCVideoWatermark::~TRTCVideoWatermark()
+{
+}
+
+bool TRTCVideoWatermark::setWaterMark(TRTCVideoStreamType streamType, const char* srcData, TRTCWaterMarkSrcType srcType,
+    uint32_t nWidth, uint32_t nHeight, float xOffset, float yOffset, float fWidthRatio)
+{
+    int index = markIndex(streamType);
+    if (index < 0)
+        return false;
+
+    if (srcData == NULL)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_marks[index].reset();
+        return true;
+    }
+
+    if ((srcType != TRTCWaterMarkSrcTypeBGRA32 && srcType != TRTCWaterMarkSrcTypeRGBA32)
+        || nWidth == 0 || nHeight == 0 || !(fWidthRatio > 0))
+        return false;
+
+    std::shared_ptr<Mark> mark = std::make_shared<Mark>();
+    mark->width = nWidth;
+    mark->height = nHeight;
+    mark->xOffset = std::max(xOffset, 0.0f);
+    mark->yOffset = std::max(yOffset, 0.0f);
+    mark->widthRatio = std::min(fWidthRatio, 1.0f);
+    mark->premultiplied.resize(nWidth * nHeight * 4);
+
+    //ͳһ BGRA Ԥˣʱ͸صɫԵ
+    const uint8_t* src = reinterpret_cast<const uint8_t*>(srcData);
+    int red = srcType == TRTCWaterMarkSrcTypeBGRA32 ? 2 : 0;
+    for (uint32_t i = 0; i < nWidth * nHeight; ++i)
+    {
+        const uint8_t* s = src + i * 4;
+        uint8_t* d = &mark->premultiplied[i * 4];
+        uint32_t alpha = s[3];
+        d[0] = div255(s[2 - red] * alpha);
+        d[1] = div255(s[1] * alpha);
+        d[2] = div255(s[red] * alpha);
+        d[3] = (uint8_t)alpha;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_marks[index] = mark;
+    return true;
+}
+
+bool TRTCVideoWatermark::hasWaterMark(TRTCVideoStreamType streamType) const
+{
+    int index = markIndex(streamType);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return index >= 0 && m_marks[index];
+}
+
+void TRTCVideoWatermark::setColorSpace(const TRTCColorSpace& colorSpace)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (colorSpace.matrix == m_colorSpace.matrix && colorSpace.range == m_colorSpace.range)
+        return;
+    m_colorSpace = colorSpace;
+    for (int i = 0; i < 2; ++i)
+    {
+        if (m_marks[i])
+            m_marks[i]->layouts.clear();
+    }
+}
+
+bool TRTCVideoWatermark::waterMarkRect(TRTCVideoStreamType streamType, uint32_t width, uint32_t height, RECT& rect) const
+{
+    SetRectEmpty(&rect);
+    int index = markIndex(streamType);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (index < 0 || !m_marks[index])
+        return false;
+
+    RECT full;
+    markRect(*m_marks[index], TRTCVideoPixelFormat_BGRA32, width, height, full);
+    clipRect(full, width, height, rect);
+    return !IsRectEmpty(&rect);
+}
+
+uint32_t TRTCVideoWatermark::cachedLayoutCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint32_t count = 0;
+    for (int i = 0; i < 2; ++i)
+    {
+        if (m_marks[i])
+            count += (uint32_t)m_marks[i]->layouts.size();
+    }
+    return count;
+}
+
+std::shared_ptr<const TRTCVideoWatermark::Layout> TRTCVideoWatermark::layout(Mark& mark, TRTCVideoPixelFormat format,
+    uint32_t width, uint32_t height)
+{
+    for (size_t i = 0; i < mark.layouts.size(); ++i)
+    {
+        std::shared_ptr<const Layout> cached = mark.layouts[i];
+        if (cached->format == format && cached->frameWidth == width && cached->frameHeight == height)
+        {
+            mark.layouts.erase(mark.layouts.begin() + i);
+            mark.layouts.push_back(cached);
+            return cached;
+        }
+    }
+
+    std::shared_ptr<Layout> result = std::make_shared<Layout>();
+    result->format = format;
+    result->frameWidth = width;
+    result->frameHeight = height;
+
+    RECT full;
+    markRect(mark, format, width, height, full);
+    clipRect(full, width, height, result->rect);
+    if (!IsRectEmpty(&result->rect))
+    {
+        //ŵСֻɼ֣Ŵ˫ԣСƽ alpha ɫ
+        int fullWidth = full.right - full.left;
+        int fullHeight = full.bottom - full.top;
+        bool bShrink = fullWidth < (int)mark.width || fullHeight < (int)mark.height;
+        m_scaler.setFilter(bShrink ? TRTCScaleFilterArea : TRTCScaleFilterBilinear);
+        std::vector<uint8_t> scaled(fullWidth * fullHeight * 4);
+        m_scaler.scalePlane(&mark.premultiplied[0], mark.width * 4, mark.width, mark.height,
+            &scaled[0], fullWidth * 4, fullWidth, fullHeight, 4);
+
+        int w = result->rect.right - result->rect.left;
+        int h = result->rect.bottom - result->rect.top;
+        std::vector<uint8_t> visible(w * h * 4);
+        for (int y = 0; y < h; ++y)
+        {
+            const uint8_t* s = &scaled[((result->rect.top - full.top + y) * fullWidth + result->rect.left - full.left) * 4];
+            uint8_t* d = &visible[y * w * 4];
+            for (int x = 0; x < w * 4; x += 4)
+            {
+                d[x] = std::min(s[x], s[x + 3]);
+                d[x + 1] = std::min(s[x + 1], s[x + 3]);
+                d[x + 2] = std::min(s[x + 2], s[x + 3]);
+                d[x + 3] = s[x + 3];
+            }
+        }
+
+        if (format == TRTCVideoPixelFormat_BGRA32)
+        {
+            result->planeWidth[0] = w * 4;
+            result->planeHeight[0] = h;
+            result->inv[0].resize(w * h * 4);
+            for (int i = 0; i < w * h; ++i)
+                memset(&result->inv[0][i * 4], 255 - visible[i * 4 + 3], 4);
+            result->premul[0].swap(visible);
+        }
+        else
+        {
+            int cw = (w + 1) / 2;
+            int ch = (h + 1) / 2;
+            result->planeWidth[0] = w;
+            result->planeHeight[0] = h;
+            for (int plane = 1; plane < 3; ++plane)
+            {
+                result->planeWidth[plane] = cw;
+                result->planeHeight[plane] = ch;
+            }
+            for (int plane = 0; plane < 3; ++plane)
+                result->premul[plane].resize(result->planeWidth[plane] * result->planeHeight[plane]);
+            TRTCVideoConvert::bgraToI420(&visible[0], w * 4, &result->premul[0][0], w, &result->premul[1][0], cw,
+                &result->premul[2][0], cw, w, h, m_colorSpace);
+
+            //Ԥɫֱתõ offset + k * rgbȥ (255 - alpha) ƫƺ alpha * yuv
+            int lumaOffset = m_colorSpace.range == TRTCColorRangeLimited ? 16 : 0;
+            result->inv[0].resize(w * h);
+            for (int i = 0; i < w * h; ++i)
+            {
+                int inv = 255 - visible[i * 4 + 3];
+                result->inv[0][i] = (uint8_t)inv;
+                result->premul[0][i] = (uint8_t)std::max(result->premul[0][i] - div255(lumaOffset * inv), 0);
+            }
+
+            //ɫȵ alpha  bgraToI420 һȡ 2x2 ƽֵظһ
+            result->inv[1].resize(cw * ch);
+            for (int cy = 0; cy < ch; ++cy)
+            {
+                int y0 = cy * 2;
+                int y1 = std::min(y0 + 1, h - 1);
+                for (int cx = 0; cx < cw; ++cx)
+                {
+                    int x0 = cx * 2;
+                    int x1 = std::min(x0 + 1, w - 1);
+                    int alpha = (visible[(y0 * w + x0) * 4 + 3] + visible[(y0 * w + x1) * 4 + 3]
+                        + visible[(y1 * w + x0) * 4 + 3] + visible[(y1 * w + x1) * 4 + 3] + 2) >> 2;
+                    int inv = 255 - alpha;
+                    int i = cy * cw + cx;
+                    result->inv[1][i] = (uint8_t)inv;
+                    for (int plane = 1; plane < 3; ++plane)
+                    {
+                        int value = result->premul[plane][i] - div255(128 * inv);
+                        result->premul[plane][i] = (uint8_t)std::min(std::max(value, 0), alpha);
+                    }
+                }
+            }
+        }
+    }
+
+    if (mark.layouts.size() >= kMaxLayoutCount)
+        mark.layouts.erase(mark.layouts.begin());
+    mark.layouts.push_back(result);
+    return result;
+}
+
+bool TRTCVideoWatermark::apply(TRTCVideoStreamType streamType, TRTCVideoFrame& frame)
+{
+    TRTCVideoPixelFormat format = frame.videoFormat;
+    if ((format != TRTCVideoPixelFormat_I420 && format != TRTCVideoPixelFormat_BGRA32)
+        || frame.bufferType != TRTCVideoBufferType_Buffer || frame.data == NULL || frame.width == 0 || frame.height == 0
+        || frame.length < TRTCVideoConvert::frameLength(format, frame.width, frame.height))
+        return false;
+
+    int index = markIndex(streamType);
+    if (index < 0)
+        return false;
+
+    std::shared_ptr<const Layout> prepared;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_marks[index])
+            return true;
+        prepared = layout(*m_marks[index], format, frame.width, frame.height);
+    }
+    if (IsRectEmpty(&prepared->rect))
+        return true;
+
+    uint8_t* data = reinterpret_cast<uint8_t*>(frame.data);
+    const RECT& rect = prepared->rect;
+    if (format == TRTCVideoPixelFormat_BGRA32)
+    {
+        int stride = frame.width * 4;
+        int bytes = prepared->planeWidth[0];
+        uint8_t* dst = data + rect.top * stride + rect.left * 4;
+        for (int y = 0; y < prepared->planeHeight[0]; ++y)
+            blendRow(dst + y * stride, &prepared->premul[0][y * bytes], &prepared->inv[0][y * bytes], bytes);
+    }
+    else
+    {
+        int chromaStride = (frame.width + 1) / 2;
+        int chromaHeight = (frame.height + 1) / 2;
+        for (int plane = 0; plane < 3; ++plane)
+        {
+            int shift = plane == 0 ? 0 : 1;
+            int stride = plane == 0 ? (int)frame.width : chromaStride;
+            uint8_t* planeData = data;
+            if (plane > 0)
+                planeData += frame.width * frame.height + (plane - 1) * chromaStride * chromaHeight;
+
+            int w = prepared->planeWidth[plane];
+            const std::vector<uint8_t>& inv = prepared->inv[plane == 0 ? 0 : 1];
+            uint8_t* dst = planeData + (rect.top >> shift) * stride + (rect.left >> shift);
+            for (int y = 0; y < prepared->planeHeight[plane]; ++y)
+                blendRow(dst + y * stride, &prepared->premul[plane][y * w], &inv[y * w], w);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,62 @@
+#pragma once
+/*
+* Module:   TRTCVideoWatermark
+*
+* Function:  TRTCCloud::setWaterMark Ĳڱػϵˮӡڱ¼Ƶĺϳɻ棬Ч SDK ʱӵˮӡһ
+*
+*    1.  setWaterMark ͬxOffsetyOffset ˮӡϽԻߵıfWidthRatio ˮӡռȵı
+*       ߶ȰˮӡͼƬĿ߱ȼ㣻srcData Ϊ NULL ʱȥˮӡֻ֧ BGRA32/RGBA32 ڴ飬С֧ˮӡ
+*
+*    2. ÿֱʺ͸ʽֻ׼һΣˮӡԤ alpha  TRTCVideoScaler ŵĿСõĲ֣
+*       I420 滹ҪԤ˺ɫת YUVɫȵ alpha ȡ 2x2 صƽֵ
+*
+*    3. ÿֻ֡ˮӡǵdst = premultiplied + dst * (255 - alpha) / 255SSE2/NEON һδ 16 ֽڣ
+*       I420 ƽ BGRA32 ĸͨͬһϺ
+*
+*    4. setWaterMark  apply ڲ̵ͬ߳á
+*/
+
+#include "TRTCCloudDef.h"
+#include "TRTCVideoConvert.h"
+#include "TRTCVideoScaler.h"
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+
+class TRTCVideoWatermark
+{
+public:
+    TRTCVideoWatermark();
+    ~TRTCVideoWatermark();
+
+    //srcType ֻ֧ TRTCWaterMarkSrcTypeBGRA32  TRTCWaterMarkSrcTypeRGBA32srcData  nWidth * nHeight * 4 ֽڶȡ
+    bool setWaterMark(TRTCVideoStreamType streamType, const char* srcData, TRTCWaterMarkSrcType srcType,
+        uint32_t nWidth, uint32_t nHeight, float xOffset, float yOffset, float fWidthRatio);
+    bool hasWaterMark(TRTCVideoStreamType streamType) const;
+
+    //I420 Ԥɫת YUV ʱʹõɫʿռ䣬޸ĺ׼
+    void setColorSpace(const TRTCColorSpace& colorSpace);
+
+    // frame ԭص streamType ˮӡframe  I420  BGRA32 ڴ֡ûˮӡʱֱӷ true
+    bool apply(TRTCVideoStreamType streamType, TRTCVideoFrame& frame);
+
+    //ˮӡ width x height ϵλãüڣɼʱΪվ
+    bool waterMarkRect(TRTCVideoStreamType streamType, uint32_t width, uint32_t height, RECT& rect) const;
+
+    uint32_t cachedLayoutCount() const;
+
+    struct Mark;
+    struct Layout;
+private:
+    TRTCVideoWatermark(const TRTCVideoWatermark&);
+    TRTCVideoWatermark& operator =(const TRTCVideoWatermark&);
+
+    std::shared_ptr<const Layout> layout(Mark& mark, TRTCVideoPixelFormat format, uint32_t width, uint32_t height);
+private:
+    mutable std::mutex m_mutex;
+    std::shared_ptr<Mark> m_marks[2];       //͸
+    TRTCColorSpace m_colorSpace;
+    TRTCVideoScaler m_scaler;
+};
@@ -5,8 +5,10 @@
 #include <Windows.h>
 #include <string>
 #include <memory>
+#include <type_traits>
 #include <stdio.h>
 #include <assert.h>
+#include "UTFConvert.h"
 
 #define DISALLOW_COPY_AND_ASSIGN(TypeName) \
     TypeName(const TypeName&);               \
@@ -14,107 +16,160 @@
 
 static std::wstring UTF82Wide(const std::string& strUTF8)
 {
-    int nWide = ::MultiByteToWideChar(CP_UTF8, 0, strUTF8.c_str(), strUTF8.size(), NULL, 0);
+    static_assert(sizeof(wchar_t) == sizeof(uint16_t), "wchar_t must be UTF-16");
 
-    std::unique_ptr<wchar_t[]> buffer(new wchar_t[nWide + 1]);
-    if (!buffer)
+    // UTF-16 Ԫᳬ UTF-8 ֱֽתַ
+    std::wstring strWide(strUTF8.size(), L'\0');
+    if (!strUTF8.empty())
     {
-        return L"";
+        size_t nWide = ::UTF8ToUTF16(strUTF8.data(), strUTF8.size(), reinterpret_cast<uint16_t*>(&strWide[0]));
+        strWide.resize(nWide);
     }
 
-    ::MultiByteToWideChar(CP_UTF8, 0, strUTF8.c_str(), strUTF8.size(), buffer.get(), nWide);
-    buffer[nWide] = L'\0';
-
-    return buffer.get();
+    return strWide;
 }
 
 static std::wstring Ansi2Wide(const std::string& strAnsi)
 {
-    int nWide = ::MultiByteToWideChar(CP_ACP, 0, strAnsi.c_str(), strAnsi.size(), NULL, 0);
-
-    std::unique_ptr<wchar_t[]> buffer(new wchar_t[nWide + 1]);
-    if (!buffer)
+    // ASCII  ANSI ҳжͬصϵͳ API
+    if (::IsASCII(strAnsi.data(), strAnsi.size()))
     {
-        return L"";
+        return std::wstring(strAnsi.begin(), strAnsi.end());
     }
 
-    ::MultiByteToWideChar(CP_ACP, 0, strAnsi.c_str(), strAnsi.size(), buffer.get(), nWide);
-    buffer[nWide] = L'\0';
+    // ֽڴҳתĿַᳬֽ
+    std::wstring strWide(strAnsi.size(), L'\0');
+    int nWide = ::MultiByteToWideChar(CP_ACP, 0, strAnsi.c_str(), strAnsi.size(), &strWide[0], strWide.size());
+    strWide.resize(nWide > 0 ? nWide : 0);
 
-    return buffer.get();
+    return strWide;
 }
 
 static std::string Wide2UTF8(const std::wstring& strWide)
 {
-    int nUTF8 = ::WideCharToMultiByte(CP_UTF8, 0, strWide.c_str(), strWide.size(), NULL, 0, NULL, NULL);
+    static_assert(sizeof(wchar_t) == sizeof(uint16_t), "wchar_t must be UTF-16");
 
-    std::unique_ptr<char[]> buffer(new char[nUTF8 + 1]);
-    if (!buffer)
+    // ÿ UTF-16 ԪӦ 3 ֽ
+    std::string strUTF8(strWide.size() * 3, '\0');
+    if (!strWide.empty())
     {
-        return "";
+        size_t nUTF8 = ::UTF16ToUTF8(reinterpret_cast<const uint16_t*>(strWide.data()), strWide.size(), &strUTF8[0]);
+        strUTF8.resize(nUTF8);
     }
 
-    ::WideCharToMultiByte(CP_UTF8, 0, strWide.c_str(), strWide.size(), buffer.get(), nUTF8, NULL, NULL);
-    buffer[nUTF8] = '\0';
-
-    return buffer.get();
+    return strUTF8;
 }
 
 static std::string Wide2Ansi(const std::wstring& strWide)
 {
     int nAnsi = ::WideCharToMultiByte(CP_ACP, 0, strWide.c_str(), strWide.size(), NULL, 0, NULL, NULL);
-
-    std::unique_ptr<char[]> buffer(new char[nAnsi + 1]);
-    if (!buffer)
+    if (nAnsi <= 0)
     {
         return "";
     }
 
-    ::WideCharToMultiByte(CP_ACP, 0, strWide.c_str(), strWide.size(), buffer.get(), nAnsi, NULL, NULL);
-    buffer[nAnsi] = '\0';
+    std::string strAnsi(nAnsi, '\0');
+    ::WideCharToMultiByte(CP_ACP, 0, strWide.c_str(), strWide.size(), &strAnsi[0], nAnsi, NULL, NULL);
 
-    return buffer.get();
+    return strAnsi;
 }
 
 static std::string Ansi2UTF8(const std::string& strAnsi)
 {
+    if (::IsASCII(strAnsi.data(), strAnsi.size()))
+    {
+        return strAnsi;
+    }
+
     return Wide2UTF8(Ansi2Wide(strAnsi));
 }
 
-static std::wstring format(const wchar_t* pszFormat, ...)
+//  printf ıδݣֵֻöٺָ룻 std::string/std::wstring  c_str() ʱ뱨
+template <typename... Args>
+struct FormatArgsCheck;
+
+template <>
+struct FormatArgsCheck<>
 {
-    wchar_t buffer[MAX_PATH] = { 0 };
+    static const bool value = true;
+};
 
-    va_list ap;
-    va_start(ap, pszFormat);
-    int nCount = ::vswprintf_s(buffer, _countof(buffer), pszFormat, ap);
-    va_end(ap);
+template <typename T, typename... Rest>
+struct FormatArgsCheck<T, Rest...>
+{
+    static const bool value = (std::is_arithmetic<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value
+        || std::is_null_pointer<T>::value) && FormatArgsCheck<Rest...>::value;
+};
+
+// ʽ׷ӵ dst ĩβ϶̵Ľдջϻʱٰʵʳݣıᱻض
+template <typename... Args>
+inline void format_to(std::wstring& dst, _Printf_format_string_ const wchar_t* pszFormat, Args... args)
+{
+    static_assert(FormatArgsCheck<Args...>::value, "format() only accepts numbers, enums and C strings");
 
+    wchar_t buffer[512];
+    int nCount = ::_snwprintf_s(buffer, _countof(buffer), _TRUNCATE, pszFormat, args...);
+    if (nCount >= 0)
+    {
+        dst.append(buffer, nCount);
+        return;
+    }
+
+    nCount = ::_scwprintf(pszFormat, args...);
     if (nCount < 0)
     {
         assert(false);
-        return pszFormat;
+        dst.append(pszFormat);
+        return;
     }
 
-    return buffer;
+    size_t nOffset = dst.size();
+    dst.resize(nOffset + nCount + 1);
+    ::swprintf_s(&dst[nOffset], nCount + 1, pszFormat, args...);
+    dst.resize(nOffset + nCount);
 }
 
-static std::string format(const char* pszFormat, ...)
+template <typename... Args>
+inline void format_to(std::string& dst, _Printf_format_string_ const char* pszFormat, Args... args)
 {
-    char buffer[MAX_PATH] = { 0 };
+    static_assert(FormatArgsCheck<Args...>::value, "format() only accepts numbers, enums and C strings");
 
-    va_list ap;
-    va_start(ap, pszFormat);
-    int nCount = ::vsprintf_s(buffer, _countof(buffer), pszFormat, ap);
-    va_end(ap);
+    char buffer[512];
+    int nCount = ::_snprintf_s(buffer, _countof(buffer), _TRUNCATE, pszFormat, args...);
+    if (nCount >= 0)
+    {
+        dst.append(buffer, nCount);
+        return;
+    }
 
+    nCount = ::_scprintf(pszFormat, args...);
     if (nCount < 0)
     {
         assert(false);
-        return pszFormat;
+        dst.append(pszFormat);
+        return;
     }
 
-    return buffer;
+    size_t nOffset = dst.size();
+    dst.resize(nOffset + nCount + 1);
+    ::sprintf_s(&dst[nOffset], nCount + 1, pszFormat, args...);
+    dst.resize(nOffset + nCount);
+}
+
+template <typename... Args>
+inline std::wstring format(_Printf_format_string_ const wchar_t* pszFormat, Args... args)
+{
+    std::wstring result;
+    format_to(result, pszFormat, args...);
+    return result;
+}
+
+template <typename... Args>
+inline std::string format(_Printf_format_string_ const char* pszFormat, Args... args)
+{
+    std::string result;
+    format_to(result, pszFormat, args...);
+    return result;
 }
 
 #endif  // _BASE_H_
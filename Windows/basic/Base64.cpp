@@ -0,0 +1,75 @@
+#include "Base64.h"
+
+static const char kBase64Chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+std::string Base64Encode(const void* data, size_t size)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    std::string result;
+    result.reserve((size + 2) / 3 * 4);
+
+    size_t i = 0;
+    for (; i + 3 <= size; i += 3)
+    {
+        unsigned value = (bytes[i] << 16) | (bytes[i + 1] << 8) | bytes[i + 2];
+        result.push_back(kBase64Chars[(value >> 18) & 0x3F]);
+        result.push_back(kBase64Chars[(value >> 12) & 0x3F]);
+        result.push_back(kBase64Chars[(value >> 6) & 0x3F]);
+        result.push_back(kBase64Chars[value & 0x3F]);
+    }
+
+    if (i < size)
+    {
+        unsigned value = bytes[i] << 16;
+        if (i + 1 < size)
+            value |= bytes[i + 1] << 8;
+        result.push_back(kBase64Chars[(value >> 18) & 0x3F]);
+        result.push_back(kBase64Chars[(value >> 12) & 0x3F]);
+        result.push_back(i + 1 < size ? kBase64Chars[(value >> 6) & 0x3F] : '=');
+        result.push_back('=');
+    }
+    return result;
+}
+
+bool Base64Decode(const char* src, size_t srcLen, std::string& dst)
+{
+    static signed char s_table[256];
+    static bool s_tableReady = []()
+    {
+        for (int i = 0; i < 256; ++i)
+            s_table[i] = -1;
+        for (int i = 0; i < 64; ++i)
+            s_table[(unsigned char)kBase64Chars[i]] = (signed char)i;
+        return true;
+    }();
+    (void)s_tableReady;
+
+    unsigned value = 0;
+    int bits = 0;
+    bool padding = false;
+    for (size_t i = 0; i < srcLen; ++i)
+    {
+        unsigned char c = (unsigned char)src[i];
+        if (c == ' ' || c == '\r' || c == '\n' || c == '\t')
+            continue;
+        if (c == '=')
+        {
+            padding = true;
+            continue;
+        }
+
+        int digit = s_table[c];
+        if (digit < 0 || padding)
+            return false;
+        value = (value << 6) | digit;
+        bits += 6;
+        if (bits >= 8)
+        {
+            bits -= 8;
+            dst.push_back((char)((value >> bits) & 0xFF));
+        }
+    }
+
+    //ʣ಻һֽڵλ 0 䣬ֻʣ 6 λ˵ݱض
+    return bits < 6 && (value & ((1u << bits) - 1)) == 0;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <stddef.h>
+#include <string>
+
+/*
+* Module:   Base64
+*
+* Function: ׼ Base64RFC 4648
+*
+*    1. ʱԿհַĩβ '=' пޡ
+*
+*    2. UserSig ʹõǰ '+''/''=' 滻Ϊ '*''-''_' ı壬÷滻ַٱ롣
+*/
+
+std::string Base64Encode(const void* data, size_t size);
+
+//׷ӵ dstǷַ false
+bool Base64Decode(const char* src, size_t srcLen, std::string& dst);
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <chrono>
+
+/*
+* Module:   Benchmark
+*
+* Function:  /xxxbench ܲԹõļʱͱ
+*
+*    1. MeasureAverageMs ȵһԤȣٷֱۼ durationMs Ҳ 3 Σصƽʱ룩
+*
+*    2. WriteBenchmarkReport ѸʽõıԭдǰĿ¼µļС
+*/
+
+typedef std::chrono::steady_clock BenchmarkClock;
+
+template <typename Func>
+inline double MeasureAverageMs(uint32_t durationMs, Func func)
+{
+    func();     //Ԥȣû뻺
+
+    uint32_t count = 0;
+    BenchmarkClock::duration elapsed;
+    BenchmarkClock::time_point begin = BenchmarkClock::now();
+    do
+    {
+        func();
+        ++count;
+        elapsed = BenchmarkClock::now() - begin;
+    } while (elapsed < std::chrono::milliseconds(durationMs) || count < 3);
+
+    return std::chrono::duration<double, std::milli>(elapsed).count() / count;
+}
+
+//ÿκʱ ms 봦 count λÿ봦ĵλ
+inline double PerSecond(double count, double ms)
+{
+    return ms > 0 ? count * 1000.0 / ms : 0.0;
+}
+
+inline bool WriteBenchmarkReport(const wchar_t* fileName, const std::string& report)
+{
+    FILE* file = NULL;
+    if (_wfopen_s(&file, fileName, L"wb") != 0 || file == NULL)
+        return false;
+
+    bool bSuccess = fwrite(report.data(), 1, report.size(), file) == report.size();
+    fclose(file);
+    return bSuccess;
+}
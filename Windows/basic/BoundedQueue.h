@@ -0,0 +1,132 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <vector>
+#include <utility>
+#include "Base.h"
+
+/*
+* Module:   CBoundedQueue
+*
+* Function: ̶߶߶
+*
+*    1. ÿλһţߺ߸ CAS λãֻдԼĲλҪҲû ABA ⡣
+*
+*    2. ڹʱȷȡ 2 ݣʱ TryPush ֱӷ falseɵ÷ԡ
+*
+*    3. ԪذֵţʺϷָСTryPop ֮λľֵᱻߡ
+*/
+template <typename T>
+class CBoundedQueue
+{
+public:
+    explicit CBoundedQueue(size_t capacity)
+    {
+        size_t size = 2;
+        while (size < capacity)
+            size <<= 1;
+        m_mask = size - 1;
+        m_cells = std::vector<Cell>(size);
+        for (size_t i = 0; i < size; ++i)
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        m_enqueuePos.store(0, std::memory_order_relaxed);
+        m_dequeuePos.store(0, std::memory_order_relaxed);
+    }
+
+    bool TryPush(T value)
+    {
+        Cell* cell = NULL;
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            cell = &m_cells[pos & m_mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+            if (diff == 0)
+            {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                return false;   //
+            }
+            else
+            {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool TryPop(T& value)
+    {
+        Cell* cell = NULL;
+        size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            cell = &m_cells[pos & m_mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+            if (diff == 0)
+            {
+                if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                return false;   //Ϊ
+            }
+            else
+            {
+                pos = m_dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        value = std::move(cell->value);
+        cell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t Capacity() const
+    {
+        return m_mask + 1;
+    }
+
+    //дʱֻǽֵ
+    size_t SizeApprox() const
+    {
+        size_t enqueuePos = m_enqueuePos.load(std::memory_order_relaxed);
+        size_t dequeuePos = m_dequeuePos.load(std::memory_order_relaxed);
+        return enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0;
+    }
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        T value;
+
+        Cell() : sequence(0), value() {}
+        Cell(const Cell& other) : sequence(other.sequence.load(std::memory_order_relaxed)), value(other.value) {}
+        Cell& operator =(const Cell& other)
+        {
+            sequence.store(other.sequence.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            value = other.value;
+            return *this;
+        }
+    };
+private:
+    DISALLOW_COPY_AND_ASSIGN(CBoundedQueue);
+
+    std::vector<Cell> m_cells;
+    size_t m_mask = 0;
+    //ߺߵλ÷ֿڲͬĻУα
+    char m_pad0[64];
+    std::atomic<size_t> m_enqueuePos;
+    char m_pad1[64];
+    std::atomic<size_t> m_dequeuePos;
+    char m_pad2[64];
+};
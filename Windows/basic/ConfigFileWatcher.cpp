@@ -0,0 +1,115 @@
+#include "ConfigFileWatcher.h"
+
+//ļ仯ȴһСʱٱȽϣ༭ļֶд
+static const DWORD kSettleDelayMs = 200;
+
+CConfigFileWatcher::CConfigFileWatcher()
+{
+
+}
+
+CConfigFileWatcher::~CConfigFileWatcher()
+{
+    Stop();
+}
+
+bool CConfigFileWatcher::Start(const std::wstring& filePath, ChangeCallback callback, DWORD pollIntervalMs)
+{
+    Stop();
+
+    std::wstring::size_type pos = filePath.find_last_of(L"\\/");
+    if (pos == std::wstring::npos || !callback)
+        return false;
+
+    m_filePath = filePath;
+    m_dirPath = filePath.substr(0, pos);
+    m_callback = callback;
+    m_pollIntervalMs = pollIntervalMs;
+    m_hStopEvent = ::CreateEventW(NULL, TRUE, FALSE, NULL);
+    if (m_hStopEvent == NULL)
+        return false;
+
+    m_watchThread = std::thread(&CConfigFileWatcher::WatchThreadProc, this);
+    return true;
+}
+
+void CConfigFileWatcher::Stop()
+{
+    if (m_hStopEvent != NULL)
+        ::SetEvent(m_hStopEvent);
+    if (m_watchThread.joinable())
+        m_watchThread.join();
+    if (m_hStopEvent != NULL)
+    {
+        ::CloseHandle(m_hStopEvent);
+        m_hStopEvent = NULL;
+    }
+}
+
+bool CConfigFileWatcher::QueryStamp(FileStamp& stamp) const
+{
+    WIN32_FILE_ATTRIBUTE_DATA attr = { 0 };
+    stamp.exist = ::GetFileAttributesExW(m_filePath.c_str(), GetFileExInfoStandard, &attr) != FALSE;
+    stamp.lastWriteTime = attr.ftLastWriteTime;
+    stamp.sizeHigh = attr.nFileSizeHigh;
+    stamp.sizeLow = attr.nFileSizeLow;
+    return stamp.exist;
+}
+
+bool CConfigFileWatcher::IsSameStamp(const FileStamp& a, const FileStamp& b)
+{
+    return a.exist == b.exist
+        && a.sizeHigh == b.sizeHigh
+        && a.sizeLow == b.sizeLow
+        && ::CompareFileTime(&a.lastWriteTime, &b.lastWriteTime) == 0;
+}
+
+void CConfigFileWatcher::WatchThreadProc()
+{
+    FileStamp lastStamp;
+    QueryStamp(lastStamp);
+
+    //Ŀ¼ļԭ滻д루MoveFileExỻļֻĿ¼֪ͨܳյ
+    HANDLE hChange = ::FindFirstChangeNotificationW(m_dirPath.c_str(), FALSE,
+        FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE);
+
+    while (true)
+    {
+        DWORD ret = 0;
+        if (hChange != INVALID_HANDLE_VALUE)
+        {
+            HANDLE handles[2] = { m_hStopEvent, hChange };
+            ret = ::WaitForMultipleObjects(2, handles, FALSE, m_pollIntervalMs);
+        }
+        else
+        {
+            ret = ::WaitForSingleObject(m_hStopEvent, m_pollIntervalMs);
+        }
+
+        if (ret == WAIT_OBJECT_0)
+            break;
+
+        if (ret == WAIT_OBJECT_0 + 1)
+        {
+            if (!::FindNextChangeNotification(hChange))
+            {
+                //֪ͨʧЧ˻Ϊѯ
+                ::FindCloseChangeNotification(hChange);
+                hChange = INVALID_HANDLE_VALUE;
+            }
+            if (::WaitForSingleObject(m_hStopEvent, kSettleDelayMs) == WAIT_OBJECT_0)
+                break;
+        }
+
+        FileStamp stamp;
+        QueryStamp(stamp);
+        if (IsSameStamp(stamp, lastStamp))
+            continue;   //Ŀ¼ļı仯ļûб仯
+
+        lastStamp = stamp;
+        m_callback();
+    }
+
+    if (hChange != INVALID_HANDLE_VALUE)
+        ::FindCloseChangeNotification(hChange);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+#include <thread>
+#include <functional>
+#include "Base.h"
+
+/*
+* Module:   CConfigFileWatcher
+*
+* Function: ļı仯
+*
+*    1. ʹ FindFirstChangeNotification ļĿ¼Ŀ¼ֱ֧֪ͨ粿繲Ŀ¼ʱ˻Ϊʱѯ
+*
+*    2. յ֪ͨѯȽļ޸ʱʹСֻļȷʵ仯ʱŻص½
+*
+*    3. صڼִ߳УҪĵ÷ PostMessage л̡߳
+*/
+class CConfigFileWatcher
+{
+public:
+    typedef std::function<void()> ChangeCallback;
+
+    CConfigFileWatcher();
+    ~CConfigFileWatcher();
+
+    //ʼpollIntervalMs Ϊѯʹñ֪ͨʱҲڶ׼飩
+    bool Start(const std::wstring& filePath, ChangeCallback callback, DWORD pollIntervalMs = 2000);
+    void Stop();
+private:
+    struct FileStamp
+    {
+        FILETIME lastWriteTime;
+        DWORD sizeHigh;
+        DWORD sizeLow;
+        bool exist;
+    };
+    bool QueryStamp(FileStamp& stamp) const;
+    static bool IsSameStamp(const FileStamp& a, const FileStamp& b);
+    void WatchThreadProc();
+private:
+    DISALLOW_COPY_AND_ASSIGN(CConfigFileWatcher);
+
+    std::wstring m_filePath;
+    std::wstring m_dirPath;
+    ChangeCallback m_callback;
+    DWORD m_pollIntervalMs = 2000;
+    HANDLE m_hStopEvent = NULL;
+    std::thread m_watchThread;
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <algorithm>
+
+/*
+* Module:   CLatencyHistogramT
+*
+* Function:  2 ݷͰʱֱͼͳ p99 ʱ
+*
+*    1.  0 Ͱͳ 0 ΢룬 i Ͱͳ [2^(i-1), 2^i) ΢룬һͰиֵ
+*
+*    2. P99 ۼƼﵽ 99% ͰϽ磬÷¼ֵ
+*
+*    3. CLatencyHistogram ɵ÷CAtomicLatencyHistogram ڶ߳ۼӣȡʱͰȡա
+*/
+template <typename Counter>
+class CLatencyHistogramT
+{
+public:
+    static const int kBucketCount = 32;
+
+    CLatencyHistogramT()
+    {
+        Reset();
+    }
+
+    void Add(uint64_t latencyUs)
+    {
+        ++m_buckets[BucketOf(latencyUs)];
+    }
+
+    void Reset()
+    {
+        for (int i = 0; i < kBucketCount; ++i)
+            m_buckets[i] = 0;
+    }
+
+    uint64_t P99(uint64_t maxUs) const
+    {
+        uint64_t buckets[kBucketCount];
+        uint64_t total = 0;
+        for (int b = 0; b < kBucketCount; ++b)
+        {
+            buckets[b] = m_buckets[b];
+            total += buckets[b];
+        }
+
+        uint64_t count = 0;
+        for (int b = 0; b < kBucketCount && total > 0; ++b)
+        {
+            count += buckets[b];
+            if (count * 100 >= total * 99)
+                return std::min<uint64_t>(b == 0 ? 0 : (1ull << b), maxUs);
+        }
+        return 0;
+    }
+
+    static int BucketOf(uint64_t latencyUs)
+    {
+        int bucket = 0;
+        while (bucket < kBucketCount - 1 && (1ull << bucket) <= latencyUs)
+            ++bucket;
+        return bucket;
+    }
+private:
+    CLatencyHistogramT(const CLatencyHistogramT&);
+    CLatencyHistogramT& operator =(const CLatencyHistogramT&);
+private:
+    Counter m_buckets[kBucketCount];
+};
+
+typedef CLatencyHistogramT<uint64_t> CLatencyHistogram;
+typedef CLatencyHistogramT<std::atomic<uint64_t> > CAtomicLatencyHistogram;
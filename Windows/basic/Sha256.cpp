@@ -0,0 +1,155 @@
+#include "Sha256.h"
+
+#include <string.h>
+
+static const uint32_t kRoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2 };
+
+static inline uint32_t RotateRight(uint32_t x, int n)
+{
+    return (x >> n) | (x << (32 - n));
+}
+
+static void Sha256Transform(uint32_t state[8], const uint8_t block[SHA256_BLOCK_SIZE])
+{
+    uint32_t w[64];
+    for (int i = 0; i < 16; ++i)
+    {
+        w[i] = ((uint32_t)block[i * 4] << 24) | ((uint32_t)block[i * 4 + 1] << 16)
+            | ((uint32_t)block[i * 4 + 2] << 8) | block[i * 4 + 3];
+    }
+    for (int i = 16; i < 64; ++i)
+    {
+        uint32_t s0 = RotateRight(w[i - 15], 7) ^ RotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = RotateRight(w[i - 2], 17) ^ RotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int i = 0; i < 64; ++i)
+    {
+        uint32_t t1 = h + (RotateRight(e, 6) ^ RotateRight(e, 11) ^ RotateRight(e, 25))
+            + ((e & f) ^ (~e & g)) + kRoundConstants[i] + w[i];
+        uint32_t t2 = (RotateRight(a, 2) ^ RotateRight(a, 13) ^ RotateRight(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+void Sha256Init(Sha256Context& ctx)
+{
+    static const uint32_t kInitState[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+    memcpy(ctx.state, kInitState, sizeof(kInitState));
+    ctx.totalSize = 0;
+    ctx.bufferSize = 0;
+}
+
+void Sha256Update(Sha256Context& ctx, const void* data, size_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    ctx.totalSize += size;
+
+    if (ctx.bufferSize > 0)
+    {
+        size_t n = SHA256_BLOCK_SIZE - ctx.bufferSize;
+        if (n > size)
+            n = size;
+        memcpy(ctx.buffer + ctx.bufferSize, bytes, n);
+        ctx.bufferSize += n;
+        bytes += n;
+        size -= n;
+        if (ctx.bufferSize < SHA256_BLOCK_SIZE)
+            return;
+        Sha256Transform(ctx.state, ctx.buffer);
+        ctx.bufferSize = 0;
+    }
+
+    for (; size >= SHA256_BLOCK_SIZE; size -= SHA256_BLOCK_SIZE, bytes += SHA256_BLOCK_SIZE)
+        Sha256Transform(ctx.state, bytes);
+
+    memcpy(ctx.buffer, bytes, size);
+    ctx.bufferSize = size;
+}
+
+void Sha256Final(Sha256Context& ctx, uint8_t digest[SHA256_DIGEST_SIZE])
+{
+    uint64_t bitCount = ctx.totalSize * 8;
+
+    ctx.buffer[ctx.bufferSize++] = 0x80;
+    if (ctx.bufferSize > SHA256_BLOCK_SIZE - 8)
+    {
+        memset(ctx.buffer + ctx.bufferSize, 0, SHA256_BLOCK_SIZE - ctx.bufferSize);
+        Sha256Transform(ctx.state, ctx.buffer);
+        ctx.bufferSize = 0;
+    }
+    memset(ctx.buffer + ctx.bufferSize, 0, SHA256_BLOCK_SIZE - 8 - ctx.bufferSize);
+    for (int i = 0; i < 8; ++i)
+        ctx.buffer[SHA256_BLOCK_SIZE - 1 - i] = (uint8_t)(bitCount >> (i * 8));
+    Sha256Transform(ctx.state, ctx.buffer);
+
+    for (int i = 0; i < 8; ++i)
+    {
+        digest[i * 4] = (uint8_t)(ctx.state[i] >> 24);
+        digest[i * 4 + 1] = (uint8_t)(ctx.state[i] >> 16);
+        digest[i * 4 + 2] = (uint8_t)(ctx.state[i] >> 8);
+        digest[i * 4 + 3] = (uint8_t)ctx.state[i];
+    }
+}
+
+CHmacSha256::CHmacSha256(const void* key, size_t keySize)
+{
+    uint8_t keyBlock[SHA256_BLOCK_SIZE] = { 0 };
+    if (keySize > SHA256_BLOCK_SIZE)
+    {
+        Sha256Context keyCtx;
+        Sha256Init(keyCtx);
+        Sha256Update(keyCtx, key, keySize);
+        Sha256Final(keyCtx, keyBlock);
+    }
+    else
+    {
+        memcpy(keyBlock, key, keySize);
+    }
+
+    uint8_t pad[SHA256_BLOCK_SIZE];
+    for (int i = 0; i < SHA256_BLOCK_SIZE; ++i)
+        pad[i] = keyBlock[i] ^ 0x36;
+    Sha256Init(m_inner);
+    Sha256Update(m_inner, pad, sizeof(pad));
+
+    for (int i = 0; i < SHA256_BLOCK_SIZE; ++i)
+        pad[i] = keyBlock[i] ^ 0x5c;
+    Sha256Init(m_outer);
+    Sha256Update(m_outer, pad, sizeof(pad));
+}
+
+void CHmacSha256::Sign(const void* data, size_t size, uint8_t mac[SHA256_DIGEST_SIZE]) const
+{
+    //Ԥõ״̬ÿ´Կ
+    Sha256Context inner = m_inner;
+    Sha256Update(inner, data, size);
+    uint8_t innerDigest[SHA256_DIGEST_SIZE];
+    Sha256Final(inner, innerDigest);
+
+    Sha256Context outer = m_outer;
+    Sha256Update(outer, innerDigest, sizeof(innerDigest));
+    Sha256Final(outer, mac);
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+* Module:   Sha256
+*
+* Function: SHA-256FIPS 180-4 HMAC-SHA256RFC 2104
+*
+*    1. CHmacSha256 ڹʱԤԿĹϣ״̬
+*       ͬһԿǩʱÿֻ账Ϣʺ UserSig
+*/
+
+#define SHA256_DIGEST_SIZE  32
+#define SHA256_BLOCK_SIZE   64
+
+struct Sha256Context
+{
+    uint32_t state[8];
+    uint64_t totalSize;
+    uint8_t buffer[SHA256_BLOCK_SIZE];
+    size_t bufferSize;
+};
+
+void Sha256Init(Sha256Context& ctx);
+void Sha256Update(Sha256Context& ctx, const void* data, size_t size);
+void Sha256Final(Sha256Context& ctx, uint8_t digest[SHA256_DIGEST_SIZE]);
+
+class CHmacSha256
+{
+public:
+    CHmacSha256(const void* key, size_t keySize);
+
+    void Sign(const void* data, size_t size, uint8_t mac[SHA256_DIGEST_SIZE]) const;
+private:
+    Sha256Context m_inner;
+    Sha256Context m_outer;
+};
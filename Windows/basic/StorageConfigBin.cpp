@@ -0,0 +1,139 @@
+#include "StorageConfigBin.h"
+#include "Base.h"
+
+#include <string.h>
+#include <mutex>
+
+//ˢ̻ص߳¼غͽ̶߳ȡöͬʱ棬ʱļǹ̶ģд滻봮
+static std::mutex s_saveMutex;
+
+uint32_t CConfigBinFile::Crc32(const void* data, size_t size)
+{
+    static uint32_t s_table[256] = { 0 };
+    static bool s_tableReady = []()
+    {
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit)
+                crc = (crc & 1) ? (0xEDB88320u ^ (crc >> 1)) : (crc >> 1);
+            s_table[i] = crc;
+        }
+        return true;
+    }();
+    (void)s_tableReady;
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i)
+        crc = s_table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFFu;
+}
+
+bool CConfigBinFile::Load(const std::wstring& path, TRTCStorageConfig& config)
+{
+    HANDLE hFile = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize = { 0 };
+    if (!::GetFileSizeEx(hFile, &fileSize) || fileSize.QuadPart < (LONGLONG)sizeof(TRTCStorageConfigBinHeader))
+    {
+        ::CloseHandle(hFile);
+        return false;
+    }
+
+    //ֱӳļݽУͶȡĶ
+    HANDLE hMapping = ::CreateFileMappingW(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    ::CloseHandle(hFile);
+    if (hMapping == NULL)
+        return false;
+    const uint8_t* view = static_cast<const uint8_t*>(::MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0));
+    ::CloseHandle(hMapping);
+    if (view == NULL)
+        return false;
+
+    bool bSuccess = false;
+    const TRTCStorageConfigBinHeader* header = reinterpret_cast<const TRTCStorageConfigBinHeader*>(view);
+    if (header->magic == TRTC_STORAGE_CONFIG_BIN_MAGIC
+        && header->version >= 1
+        && header->headerSize >= sizeof(TRTCStorageConfigBinHeader)
+        && header->payloadSize >= sizeof(TRTCStorageConfigBinPayloadV1)
+        && (LONGLONG)header->headerSize + header->payloadSize <= fileSize.QuadPart)
+    {
+        const uint8_t* payloadData = view + header->headerSize;
+        if (Crc32(payloadData, header->payloadSize) == header->checksum)
+        {
+            TRTCStorageConfigBinPayloadV1 payload;
+            memcpy(&payload, payloadData, sizeof(payload));
+            config.videoEncParams.videoResolution = (TRTCVideoResolution)payload.videoResolution;
+            config.videoEncParams.resMode = (TRTCVideoResolutionMode)payload.resMode;
+            config.videoEncParams.videoFps = payload.videoFps;
+            config.videoEncParams.videoBitrate = payload.videoBitrate;
+            config.qosParams.preference = (TRTCVideoQosPreference)payload.qosPreference;
+            config.qosParams.controlMode = (TRTCQosControlMode)payload.qosControlMode;
+            config.bPushSmallVideo = payload.bPushSmallVideo != 0;
+            config.bPlaySmallVideo = payload.bPlaySmallVideo != 0;
+            bSuccess = true;
+        }
+    }
+
+    ::UnmapViewOfFile(view);
+    return bSuccess;
+}
+
+bool CConfigBinFile::Save(const std::wstring& path, const TRTCStorageConfig& config)
+{
+    struct
+    {
+        TRTCStorageConfigBinHeader header;
+        TRTCStorageConfigBinPayloadV1 payload;
+    } data;
+    memset(&data, 0, sizeof(data));
+
+    data.payload.videoResolution = config.videoEncParams.videoResolution;
+    data.payload.resMode = config.videoEncParams.resMode;
+    data.payload.videoFps = config.videoEncParams.videoFps;
+    data.payload.videoBitrate = config.videoEncParams.videoBitrate;
+    data.payload.qosPreference = config.qosParams.preference;
+    data.payload.qosControlMode = config.qosParams.controlMode;
+    data.payload.bPushSmallVideo = config.bPushSmallVideo ? 1 : 0;
+    data.payload.bPlaySmallVideo = config.bPlaySmallVideo ? 1 : 0;
+
+    data.header.magic = TRTC_STORAGE_CONFIG_BIN_MAGIC;
+    data.header.version = TRTC_STORAGE_CONFIG_BIN_VERSION;
+    data.header.headerSize = sizeof(TRTCStorageConfigBinHeader);
+    data.header.payloadSize = sizeof(TRTCStorageConfigBinPayloadV1);
+    data.header.checksum = Crc32(&data.payload, sizeof(data.payload));
+
+    std::lock_guard<std::mutex> lock(s_saveMutex);
+    std::wstring tmp_path = path + L".tmp";
+    HANDLE hFile = ::CreateFileW(tmp_path.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE)
+        return false;
+
+    DWORD dwWritten = 0;
+    BOOL bSuccess = ::WriteFile(hFile, &data, sizeof(data), &dwWritten, NULL);
+    bSuccess = bSuccess && (dwWritten == sizeof(data)) && ::FlushFileBuffers(hFile);
+    ::CloseHandle(hFile);
+
+    if (!bSuccess || !::MoveFileExW(tmp_path.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+    {
+        ::DeleteFileW(tmp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool CConfigBinFile::IsUpToDate(const std::wstring& binPath, const std::wstring& iniPath)
+{
+    WIN32_FILE_ATTRIBUTE_DATA binAttr = { 0 };
+    if (!::GetFileAttributesExW(binPath.c_str(), GetFileExInfoStandard, &binAttr))
+        return false;
+
+    WIN32_FILE_ATTRIBUTE_DATA iniAttr = { 0 };
+    if (!::GetFileAttributesExW(iniPath.c_str(), GetFileExInfoStandard, &iniAttr))
+        return true;    //ûINIļļΨһԴ
+
+    return ::CompareFileTime(&binAttr.ftLastWriteTime, &iniAttr.ftLastWriteTime) >= 0;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <string>
+#include <stdint.h>
+#include "StorageConfigMgr.h"
+
+/*
+* Module:   CConfigBinFile
+*
+* Function: TRTCStorageConfig Ķƴ洢ʽ
+*
+*    1. ļɹ̶ȵļͷ͸ɣֶ TRTCVideoEncParam/TRTCNetworkQosParam һһӦ
+*       ȡʱֻӳļУļͷ CRC32ȻֱӿֶΣҪκַ
+*
+*    2. ļͷм¼ʽ汾͸سȣ°汾ֻڸĩβ׷ֶΣɰ汾ȡ֪ǰ׺ɡ
+*
+*    3. дʱдʱļԭ滻 CConfigMgr д INI ļķʽһ¡
+*/
+
+#pragma pack(push, 1)
+struct TRTCStorageConfigBinHeader
+{
+    uint32_t magic;             //̶Ϊ TRTC_STORAGE_CONFIG_BIN_MAGIC
+    uint16_t version;           //ظʽ汾
+    uint16_t headerSize;        //ļͷȣ sizeof(TRTCStorageConfigBinHeader)
+    uint32_t payloadSize;       //س
+    uint32_t checksum;          //ص CRC32
+};
+
+struct TRTCStorageConfigBinPayloadV1
+{
+    int32_t videoResolution;    //TRTCVideoEncParam::videoResolution
+    int32_t resMode;            //TRTCVideoEncParam::resMode
+    uint32_t videoFps;          //TRTCVideoEncParam::videoFps
+    uint32_t videoBitrate;      //TRTCVideoEncParam::videoBitrate
+    int32_t qosPreference;      //TRTCNetworkQosParam::preference
+    int32_t qosControlMode;     //TRTCNetworkQosParam::controlMode
+    uint8_t bPushSmallVideo;
+    uint8_t bPlaySmallVideo;
+    uint8_t reserved[2];
+};
+#pragma pack(pop)
+
+#define TRTC_STORAGE_CONFIG_BIN_MAGIC   0x43535254      // "TRSC"
+#define TRTC_STORAGE_CONFIG_BIN_VERSION 1
+
+class CConfigBinFile
+{
+public:
+    //ȡļļڡضϻУʧʱ falseconfig ֲ
+    static bool Load(const std::wstring& path, TRTCStorageConfig& config);
+
+    //ļʱļ + ԭ滻߳ͬʱʱִ
+    static bool Save(const std::wstring& path, const TRTCStorageConfig& config);
+
+    //ļǷڣҲ INI ļɣINI ֹ޸ĺҪǨƣ
+    static bool IsUpToDate(const std::wstring& binPath, const std::wstring& iniPath);
+
+    static uint32_t Crc32(const void* data, size_t size);
+};
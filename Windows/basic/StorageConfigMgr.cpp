@@ -4,25 +4,15 @@
 #include <cstdlib>
 #include <vector>
 #include <mutex>
+#include <iterator>
+#include <cstring>
+#include <chrono>
 #include "StorageConfigMgr.h"
 #include "Base.h"
+#include "StorageConfigBin.h"
+#include "Benchmark.h"
 
 //#define INIDEBUG
-//INIļ洢ṹ
-class ININode
-{
-public:
-    ININode(std::wstring root, std::wstring key, std::wstring value)
-    {
-        this->root = root;
-        this->key = key;
-        this->value = value;
-    }
-    std::wstring root;
-    std::wstring key;
-    std::wstring value;
-};
-//////////////////////////////////////////////////////////////////////////ININode
 
 CConfigMgr::CConfigMgr()
 {
@@ -35,12 +25,78 @@ CConfigMgr::CConfigMgr()
     int size = appPath.size();
     _IncFilePath = appPath.erase(pos, size);
     _IncFilePath += L"\\TRTStorageConfig.ini";
-    InitReadINI();
+    m_flushThread = std::thread(&CConfigMgr::FlushThreadProc, this);
 }
 
 CConfigMgr::~CConfigMgr()
 {
+    {
+        std::lock_guard<std::mutex> lock(m_dataMutex);
+        m_bExitFlush = true;
+    }
+    m_flushCond.notify_all();
+    if (m_flushThread.joinable())
+        m_flushThread.join();
     WriteINI();
+}
+
+//д̺ϲڣڵĶ SetValue ֻһд
+static const std::chrono::milliseconds kFlushDelay(500);
+
+void CConfigMgr::FlushThreadProc()
+{
+    std::unique_lock<std::mutex> lock(m_dataMutex);
+    while (!m_bExitFlush)
+    {
+        m_flushCond.wait(lock, [this] { return m_bExitFlush || m_dataVersion != m_savedVersion; });
+        if (m_bExitFlush)
+            break;
+
+        //ȴϲڽڼ޸Ļһд룻˳ʱһд
+        m_flushCond.wait_for(lock, kFlushDelay, [this] { return m_bExitFlush; });
+        if (m_bExitFlush)
+            break;
+
+        lock.unlock();
+        WriteINI();
+        lock.lock();
+    }
+}
+
+int CConfigMgr::Flush()
+{
+    return WriteINI();
+}
+
+int CConfigMgr::Reload()
+{
+    std::lock_guard<std::mutex> lock(m_dataMutex);
+    if (m_dataVersion != m_savedVersion)
+        return 0;   //ڴе޸Ļûд̣ڴΪ׼д̺ļᱻ
+    map_ini.clear();
+    m_bLoaded = true;
+    return InitReadINI();
+}
+
+uint64_t CConfigMgr::GetDataVersion()
+{
+    std::lock_guard<std::mutex> lock(m_dataMutex);
+    return m_dataVersion;
+}
+
+int CConfigMgr::GetSize()
+{
+    std::lock_guard<std::mutex> lock(m_dataMutex);
+    EnsureLoaded();
+    return map_ini.size();
+}
+
+void CConfigMgr::EnsureLoaded()
+{
+    if (m_bLoaded)
+        return;
+    m_bLoaded = true;
+    InitReadINI();
 }
 
 //************************************************************************
@@ -70,66 +126,77 @@ std::string &TrimString(std::string &str)
 //************************************************************************
 int CConfigMgr::InitReadINI()
 {
-    std::ifstream in_conf_file(_IncFilePath.c_str());
+    std::ifstream in_conf_file(_IncFilePath.c_str(), std::ios::in | std::ios::binary);
     if (!in_conf_file) return 0;
-    std::string str_line = "";
-    std::string str_root = "";
-    std::vector<ININode> vec_ini;
-    while (getline(in_conf_file, str_line))
-    {
-        std::string::size_type left_pos = 0;
-        std::string::size_type right_pos = 0;
-        std::string::size_type equal_div_pos = 0;
-        std::string str_key = "";
-        std::string str_value = "";
-        if ((str_line.npos != (left_pos = str_line.find("["))) && (str_line.npos != (right_pos = str_line.find("]"))))
-        {
-            //cout << str_line.substr(left_pos+1, right_pos-1) << endl;
-            str_root = str_line.substr(left_pos + 1, right_pos - 1);
-        }
 
-        if (str_line.npos != (equal_div_pos = str_line.find("=")))
-        {
-            str_key = str_line.substr(0, equal_div_pos);
-            str_value = str_line.substr(equal_div_pos + 1, str_line.size() - 1);
-            //str_key = TrimString(str_key);
-            //str_value = TrimString(str_value);
-            //cout << str_key << "=" << str_value << endl;
-        }
-
-        if ((!str_root.empty()) && (!str_key.empty()) && (!str_value.empty()))
-        {
-            ININode ini_node(UTF82Wide(str_root), UTF82Wide(str_key), UTF82Wide(str_value));
-            vec_ini.push_back(ini_node);
-            //cout << vec_ini.size() << endl;
-        }
-    }
+    //һԶļɨʱֱӶλǰڵ㣬ռٰڵ㷴
+    std::string str_data((std::istreambuf_iterator<char>(in_conf_file)), std::istreambuf_iterator<char>());
     in_conf_file.close();
     in_conf_file.clear();
 
-    //vector convert to map
-    std::map<std::wstring, std::wstring> map_tmp;
-    for (std::vector<ININode>::iterator itr = vec_ini.begin(); itr != vec_ini.end(); ++itr)
-    {
-        map_tmp.insert(std::pair<std::wstring, std::wstring>(itr->root, L""));
-    }	//ȡڵ
-    for (std::map<std::wstring, std::wstring>::iterator itr = map_tmp.begin(); itr != map_tmp.end(); ++itr)
+    return ParseINIData(str_data, map_ini);
+}
+
+//************************************************************************
+// :    	ParseINIData
+// Ȩ:    	public 
+// ˵:		INIıֱֵӲڵ
+// : 	const std::string & str_data	UTF-8 INIı
+// : 	std::map & map_ini				׷ӵ
+//   ֵ:   	int
+//************************************************************************
+int CConfigMgr::ParseINIData(const std::string& str_data, std::map<std::wstring, SubNode>& map_ini)
+{
+    std::string::size_type line_begin = 0;
+    if (str_data.compare(0, 3, "\xEF\xBB\xBF") == 0)
+        line_begin = 3;     //UTF-8 BOM
+
+    std::map<std::wstring, SubNode>::iterator root_itr = map_ini.end();
+    const std::string::size_type data_size = str_data.size();
+    while (line_begin < data_size)
     {
-#ifdef INIDEBUG
-        cout << "ڵ㣺 " << itr->first << endl;
-#endif	//INIDEBUG
-        SubNode sn;
-        for (std::vector<ININode>::iterator sub_itr = vec_ini.begin(); sub_itr != vec_ini.end(); ++sub_itr)
+        std::string::size_type line_end = str_data.find('\n', line_begin);
+        if (line_end == std::string::npos)
+            line_end = data_size;
+        std::string::size_type next_line = line_end + 1;
+        if (line_end > line_begin && str_data[line_end - 1] == '\r')
+            --line_end;
+
+        const char* line = str_data.data() + line_begin;
+        const std::string::size_type line_len = line_end - line_begin;
+        std::string::size_type first_char = 0;
+        while (first_char < line_len && (line[first_char] == ' ' || line[first_char] == '\t'))
+            ++first_char;
+        const char* left = (first_char < line_len && line[first_char] == '[') ? line + first_char : nullptr;
+        const char* right = left ? static_cast<const char*>(memchr(left, ']', line + line_len - left)) : nullptr;
+        if (left && right)
         {
-            if (sub_itr->root == itr->first)
+            //ڵ㣺ÿڵֻתһα
+            std::wstring str_root = UTF82Wide(std::string(left + 1, right));
+            root_itr = str_root.empty() ? map_ini.end() : map_ini.insert(std::make_pair(str_root, SubNode())).first;
+        }
+        else if (root_itr != map_ini.end())
+        {
+            const char* equal_div = static_cast<const char*>(memchr(line, '=', line_len));
+            if (equal_div && equal_div != line && equal_div + 1 != line + line_len)
             {
 #ifdef INIDEBUG
-                cout << "ֵԣ " << sub_itr->key << "=" << sub_itr->value << endl;
+                std::cout << "ֵԣ " << std::string(line, line_len) << std::endl;
 #endif	//INIDEBUG
-                sn.InsertElement(sub_itr->key, sub_itr->value);
+                root_itr->second.InsertElement(UTF82Wide(std::string(line, equal_div)),
+                    UTF82Wide(std::string(equal_div + 1, line + line_len)));
             }
         }
-        map_ini.insert(std::pair<std::wstring, SubNode>(itr->first, sn));
+        line_begin = next_line;
+    }
+
+    //ԭΪһ£ûκμֵԵĸڵ㲻
+    for (std::map<std::wstring, SubNode>::iterator itr = map_ini.begin(); itr != map_ini.end();)
+    {
+        if (itr->second.sub_node.empty())
+            itr = map_ini.erase(itr);
+        else
+            ++itr;
     }
     return 1;
 }
@@ -146,6 +213,8 @@ int CConfigMgr::InitReadINI()
 //************************************************************************
 std::wstring CConfigMgr::GetValue(std::wstring root, std::wstring key)
 {
+    std::lock_guard<std::mutex> lock(m_dataMutex);
+    EnsureLoaded();
     std::map<std::wstring, SubNode>::iterator itr = map_ini.find(root);
     if (map_ini.end() == itr)
         return L"";
@@ -165,29 +234,59 @@ std::wstring CConfigMgr::GetValue(std::wstring root, std::wstring key)
 // Ȩ:    	public 
 // :		2017/01/05
 //   :		
-// ˵:    XMLϢļ
-// : 	string path	INIļı·
-//   ֵ:   	int
+// ˵:    INIϢļУдʱļԭ滻
+//   ֵ:   	int		1 д̣0 ûиĶд̣-1 дʧ
 //************************************************************************
 int CConfigMgr::WriteINI()
 {
-    //...ļ򿪣ϢرļȲ
-    std::wofstream out_conf_file(_IncFilePath.c_str());
-    if (!out_conf_file)
-        return -1;
-    //cout << map_ini.size() << endl;
-    for (std::map<std::wstring, SubNode>::iterator itr = map_ini.begin(); itr != map_ini.end(); ++itr)
+    std::lock_guard<std::mutex> file_lock(m_fileMutex);
+
+    //лUTF-8ıдļʱٳдòᱻIO
+    std::string str_data;
+    uint64_t version = 0;
     {
-        //cout << itr->first << endl;
-        out_conf_file << "[" << Wide2UTF8(itr->first).c_str() << "]" << std::endl;
-        for (std::map<std::wstring, std::wstring>::iterator sub_itr = itr->second.sub_node.begin(); sub_itr != itr->second.sub_node.end(); ++sub_itr)
+        std::lock_guard<std::mutex> lock(m_dataMutex);
+        if (m_dataVersion == m_savedVersion)
+            return 0;   //ûиĶд
+        version = m_dataVersion;
+        for (std::map<std::wstring, SubNode>::iterator itr = map_ini.begin(); itr != map_ini.end(); ++itr)
         {
-            //cout << sub_itr->first << "=" << sub_itr->second << endl;
-            out_conf_file << Wide2UTF8(sub_itr->first).c_str() << "=" << Wide2UTF8(sub_itr->second).c_str() << std::endl;
+            str_data += "[";
+            str_data += Wide2UTF8(itr->first);
+            str_data += "]\r\n";
+            for (std::map<std::wstring, std::wstring>::iterator sub_itr = itr->second.sub_node.begin(); sub_itr != itr->second.sub_node.end(); ++sub_itr)
+            {
+                str_data += Wide2UTF8(sub_itr->first);
+                str_data += "=";
+                str_data += Wide2UTF8(sub_itr->second);
+                str_data += "\r\n";
+            }
         }
     }
-    out_conf_file.close();
-    out_conf_file.clear();
+
+    //дʱļˢ̣ԭ滻ԭļ̱ʱдһ
+    std::wstring tmp_path = _IncFilePath + L".tmp";
+    HANDLE hFile = ::CreateFileW(tmp_path.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE)
+        return -1;
+
+    DWORD dwWritten = 0;
+    BOOL bSuccess = ::WriteFile(hFile, str_data.data(), (DWORD)str_data.size(), &dwWritten, NULL);
+    bSuccess = bSuccess && (dwWritten == str_data.size()) && ::FlushFileBuffers(hFile);
+    ::CloseHandle(hFile);
+
+    if (!bSuccess || !::MoveFileExW(tmp_path.c_str(), _IncFilePath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+    {
+        ::DeleteFileW(tmp_path.c_str());
+        return -1;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_dataMutex);
+        m_savedVersion = version;
+    }
+    if (m_flushCallback)
+        m_flushCallback();
     return 1;
 }
 
@@ -200,21 +299,30 @@ int CConfigMgr::WriteINI()
 // : 	string root		ĸڵ
 // : 	string key		ļ
 // : 	string value	ֵ
-//   ֵ:   	std::vector<ININode>::size_type	
+//   ֵ:   	bool
 //************************************************************************
 bool CConfigMgr::SetValue(std::wstring root, std::wstring key, std::wstring value)
 {
-    std::map<std::wstring, SubNode>::iterator itr = map_ini.find(root);	//
-    if (map_ini.end() != itr)
-    {
-        itr->second.sub_node[key] = value;
-    }	//ڵѾˣֵ
-    else
     {
-        SubNode sn;
-        sn.InsertElement(key, value);
-        map_ini.insert(std::pair<std::wstring, SubNode>(root, sn));
-    }	//ڵ㲻ڣֵ
+        std::lock_guard<std::mutex> lock(m_dataMutex);
+        EnsureLoaded();
+        std::map<std::wstring, SubNode>::iterator itr = map_ini.find(root);	//
+        if (map_ini.end() != itr)
+        {
+            std::wstring& old_value = itr->second.sub_node[key];
+            if (old_value == value)
+                return true;    //ֵûб仯Ҫд
+            old_value = value;
+        }	//ڵѾˣֵ
+        else
+        {
+            SubNode sn;
+            sn.InsertElement(key, value);
+            map_ini.insert(std::pair<std::wstring, SubNode>(root, sn));
+        }	//ڵ㲻ڣֵ
+        ++m_dataVersion;
+    }
+    m_flushCond.notify_one();
 
     return true;
 }
@@ -241,6 +349,115 @@ void CConfigMgr::Travel()
     }
 }
 
+//////////////////////////////////////////////////////////////////////////ParseBenchmark
+//ԭȵĽʽռмֵԣٶÿڵһȫֵԣں͵Ա
+static void ParseINIDataRescan(const std::string& str_data, std::map<std::wstring, SubNode>& map_ini)
+{
+    struct RescanNode
+    {
+        std::wstring root;
+        std::wstring key;
+        std::wstring value;
+    };
+
+    std::istringstream in_conf(str_data);
+    std::string str_line;
+    std::string str_root;
+    std::vector<RescanNode> vec_ini;
+    while (getline(in_conf, str_line))
+    {
+        if (!str_line.empty() && str_line[str_line.size() - 1] == '\r')
+            str_line.erase(str_line.size() - 1);
+        std::string::size_type left_pos = str_line.find("[");
+        std::string::size_type right_pos = str_line.find("]");
+        if (left_pos != str_line.npos && right_pos != str_line.npos)
+            str_root = str_line.substr(left_pos + 1, right_pos - left_pos - 1);
+
+        std::string::size_type equal_div_pos = str_line.find("=");
+        if (equal_div_pos == str_line.npos || equal_div_pos == 0 || equal_div_pos + 1 == str_line.size() || str_root.empty())
+            continue;
+        RescanNode node = { UTF82Wide(str_root), UTF82Wide(str_line.substr(0, equal_div_pos)), UTF82Wide(str_line.substr(equal_div_pos + 1)) };
+        vec_ini.push_back(node);
+    }
+
+    std::map<std::wstring, std::wstring> map_tmp;
+    for (std::vector<RescanNode>::iterator itr = vec_ini.begin(); itr != vec_ini.end(); ++itr)
+        map_tmp.insert(std::pair<std::wstring, std::wstring>(itr->root, std::wstring()));
+    for (std::map<std::wstring, std::wstring>::iterator itr = map_tmp.begin(); itr != map_tmp.end(); ++itr)
+    {
+        SubNode sn;
+        for (std::vector<RescanNode>::iterator sub_itr = vec_ini.begin(); sub_itr != vec_ini.end(); ++sub_itr)
+        {
+            if (sub_itr->root == itr->first)
+                sn.InsertElement(sub_itr->key, sub_itr->value);
+        }
+        map_ini.insert(std::pair<std::wstring, SubNode>(itr->first, sn));
+    }
+}
+
+// sectionCount ڵ㡢ÿڵ keyCount ֵԵINIıֵһЩ
+static std::string MakeBenchINI(uint32_t sectionCount, uint32_t keyCount)
+{
+    std::string str_data = "\xEF\xBB\xBF";
+    for (uint32_t i = 0; i < sectionCount; ++i)
+    {
+        format_to(str_data, "[Section_%u]\r\n", i);
+        for (uint32_t j = 0; j < keyCount; ++j)
+            format_to(str_data, "INI_KEY_%u_%u=%u\xE6\xB5\x8B\xE8\xAF\x95_%u\r\n", i, j, i * 131 + j, j);
+    }
+    return str_data;
+}
+
+std::vector<CConfigParseBenchResult> CConfigMgr::RunBenchmark(uint32_t durationMs)
+{
+    static const uint32_t kShapes[][2] = { { 1, 8 }, { 16, 16 }, { 64, 64 }, { 256, 32 }, { 1024, 8 } };
+
+    std::vector<CConfigParseBenchResult> results;
+    for (size_t i = 0; i < _countof(kShapes); ++i)
+    {
+        CConfigParseBenchResult result;
+        result.sectionCount = kShapes[i][0];
+        result.keyCount = kShapes[i][1];
+        std::string str_data = MakeBenchINI(result.sectionCount, result.keyCount);
+        result.bytes = (uint32_t)str_data.size();
+
+        std::map<std::wstring, SubNode> single_pass;
+        std::map<std::wstring, SubNode> rescan;
+        result.singlePassMs = MeasureAverageMs(durationMs, [&]() {
+            single_pass.clear();
+            ParseINIData(str_data, single_pass);
+        });
+        result.rescanMs = MeasureAverageMs(durationMs, [&]() {
+            rescan.clear();
+            ParseINIDataRescan(str_data, rescan);
+        });
+
+        result.bMatch = single_pass.size() == rescan.size();
+        for (std::map<std::wstring, SubNode>::iterator itr = single_pass.begin(); result.bMatch && itr != single_pass.end(); ++itr)
+        {
+            std::map<std::wstring, SubNode>::iterator other = rescan.find(itr->first);
+            result.bMatch = other != rescan.end() && other->second.sub_node == itr->second.sub_node;
+        }
+        results.push_back(result);
+    }
+    return results;
+}
+
+std::string CConfigMgr::FormatBenchmark(const std::vector<CConfigParseBenchResult>& results)
+{
+    std::string report;
+    format_to(report, "%9s %6s %10s %14s %10s %8s %6s\r\n",
+        "sections", "keys", "bytes", "single pass ms", "rescan ms", "speedup", "match");
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const CConfigParseBenchResult& r = results[i];
+        format_to(report, "%9u %6u %10u %14.3f %10.3f %8.2f %6s\r\n",
+            r.sectionCount, r.keyCount, r.bytes, r.singlePassMs, r.rescanMs,
+            r.singlePassMs > 0 ? r.rescanMs / r.singlePassMs : 0.0, r.bMatch ? "yes" : "NO");
+    }
+    return report;
+}
+
 ////////////////////////////////////////////////////////////////////////// TRTCStorageConfig
 static std::shared_ptr<TRTCStorageConfigMgr> s_pInstance;
 static std::mutex engine_mex;
@@ -260,13 +477,21 @@ std::shared_ptr<TRTCStorageConfigMgr> TRTCStorageConfigMgr::GetInstance()
 TRTCStorageConfigMgr::TRTCStorageConfigMgr()
 {
     m_pConfigMgr = new CConfigMgr;
-    videoEncParams.videoResolution = TRTCVideoResolution_640_360;
-    videoEncParams.videoBitrate = 500;
-    videoEncParams.videoFps = 15;
+    std::shared_ptr<TRTCStorageConfig> config = std::make_shared<TRTCStorageConfig>();
+    config->videoEncParams.videoResolution = TRTCVideoResolution_640_360;
+    config->videoEncParams.videoBitrate = 500;
+    config->videoEncParams.videoFps = 15;
+    m_config = config;
+
+    std::wstring iniPath = m_pConfigMgr->GetFilePath();
+    m_binFilePath = iniPath.substr(0, iniPath.find_last_of(L'.')) + L".bin";
+    //INIд̳ɹͬ¶ļ֤ļINI
+    m_pConfigMgr->SetFlushCallback([this]() { CConfigBinFile::Save(m_binFilePath, *GetConfig()); });
 }
 
 TRTCStorageConfigMgr::~TRTCStorageConfigMgr()
 {
+    StopWatchConfigFile();
     WriteStorageConfig();
     if (m_pConfigMgr)
     {
@@ -278,54 +503,167 @@ TRTCStorageConfigMgr::~TRTCStorageConfigMgr()
 
 void TRTCStorageConfigMgr::ReadStorageConfig()
 {
-    if (m_pConfigMgr == false || m_pConfigMgr->GetSize() == 0)
+    std::lock_guard<std::mutex> lock(m_publishMutex);
+
+    //ȶȡãINIļȶļ£类ֹ޸Ĺļʱ´INIǨ
+    if (CConfigBinFile::IsUpToDate(m_binFilePath, m_pConfigMgr->GetFilePath()))
+    {
+        TRTCStorageConfig binConfig = *GetConfig();
+        if (CConfigBinFile::Load(m_binFilePath, binConfig))
+        {
+            std::atomic_store(&m_config, std::shared_ptr<const TRTCStorageConfig>(std::make_shared<TRTCStorageConfig>(binConfig)));
+            return;
+        }
+    }
+
+    //ڸϽɺ巢ȡῴֻһ
+    TRTCStorageConfig config = *GetConfig();
+    if (!ParseINIConfig(config))
         return;
+
+    std::atomic_store(&m_config, std::shared_ptr<const TRTCStorageConfig>(std::make_shared<TRTCStorageConfig>(config)));
+
+    //һǨƣֱ֮Ӷȡļ
+    CConfigBinFile::Save(m_binFilePath, config);
+}
+
+bool TRTCStorageConfigMgr::ParseINIConfig(TRTCStorageConfig& config)
+{
+    if (m_pConfigMgr == nullptr || m_pConfigMgr->GetSize() == 0)
+        return false;
+
     //Ƶ
     std::wstring strParam;
     strParam = m_pConfigMgr->GetValue(INI_ROOT_KEY, INI_KEY_VIDEO_BITRATE);
-    videoEncParams.videoBitrate = _wtoi(strParam.c_str());
+    config.videoEncParams.videoBitrate = _wtoi(strParam.c_str());
 
     strParam = m_pConfigMgr->GetValue(INI_ROOT_KEY, INI_KEY_VIDEO_RESOLUTION);
-    videoEncParams.videoResolution = (TRTCVideoResolution)_wtoi(strParam.c_str());
+    config.videoEncParams.videoResolution = (TRTCVideoResolution)_wtoi(strParam.c_str());
 
     strParam = m_pConfigMgr->GetValue(INI_ROOT_KEY, INI_KEY_VIDEO_FPS);
-    videoEncParams.videoFps = _wtoi(strParam.c_str());
+    config.videoEncParams.videoFps = _wtoi(strParam.c_str());
 
     strParam = m_pConfigMgr->GetValue(INI_ROOT_KEY, INI_KEY_VIDEO_QUALITY);
-    qosParams.preference = (TRTCVideoQosPreference)_wtoi(strParam.c_str());
+    config.qosParams.preference = (TRTCVideoQosPreference)_wtoi(strParam.c_str());
 
     //strParam = m_pConfigMgr->GetValue(INI_ROOT_KEY, INI_KEY_VIDEO_QUALITY_CONTROL);
-    qosParams.controlMode = TRTCQosControlModeServer;
+    config.qosParams.controlMode = TRTCQosControlModeServer;
 
     strParam = m_pConfigMgr->GetValue(INI_ROOT_KEY, INI_KEY_SET_PUSH_SMALLVIDEO);
-    bPushSmallVideo = _wtoi(strParam.c_str());
+    config.bPushSmallVideo = _wtoi(strParam.c_str());
 
     strParam = m_pConfigMgr->GetValue(INI_ROOT_KEY, INI_KEY_SET_PLAY_SMALLVIDEO);
-    bPlaySmallVideo = _wtoi(strParam.c_str());
+    config.bPlaySmallVideo = _wtoi(strParam.c_str());
+
+    return true;
 }
 
 void TRTCStorageConfigMgr::WriteStorageConfig()
 {
+    std::shared_ptr<const TRTCStorageConfig> config = GetConfig();
+
     //Ƶ
     std::wstring strFormat;
-    strFormat = format(L"%d", videoEncParams.videoBitrate);
+    strFormat = format(L"%d", config->videoEncParams.videoBitrate);
     m_pConfigMgr->SetValue(INI_ROOT_KEY, INI_KEY_VIDEO_BITRATE, strFormat.c_str());
 
-    strFormat = format(L"%d", videoEncParams.videoResolution);
+    strFormat = format(L"%d", config->videoEncParams.videoResolution);
     m_pConfigMgr->SetValue(INI_ROOT_KEY, INI_KEY_VIDEO_RESOLUTION, strFormat.c_str());
 
-    strFormat = format(L"%d", videoEncParams.videoFps);
+    strFormat = format(L"%d", config->videoEncParams.videoFps);
     m_pConfigMgr->SetValue(INI_ROOT_KEY, INI_KEY_VIDEO_FPS, strFormat.c_str());
 
-    strFormat = format(L"%d", qosParams.preference);
+    strFormat = format(L"%d", config->qosParams.preference);
     m_pConfigMgr->SetValue(INI_ROOT_KEY, INI_KEY_VIDEO_QUALITY, strFormat.c_str());
 
-    strFormat = format(L"%d", qosParams.controlMode);
+    strFormat = format(L"%d", config->qosParams.controlMode);
     m_pConfigMgr->SetValue(INI_ROOT_KEY, INI_KEY_VIDEO_QUALITY_CONTROL, strFormat.c_str());
 
-    strFormat = format(L"%d", bPushSmallVideo);
+    strFormat = format(L"%d", config->bPushSmallVideo);
     m_pConfigMgr->SetValue(INI_ROOT_KEY, INI_KEY_SET_PUSH_SMALLVIDEO, strFormat.c_str());
 
-    strFormat = format(L"%d", bPlaySmallVideo);
+    strFormat = format(L"%d", config->bPlaySmallVideo);
     m_pConfigMgr->SetValue(INI_ROOT_KEY, INI_KEY_SET_PLAY_SMALLVIDEO, strFormat.c_str());
 }
+
+std::shared_ptr<const TRTCStorageConfig> TRTCStorageConfigMgr::GetConfig() const
+{
+    return std::atomic_load(&m_config);
+}
+
+void TRTCStorageConfigMgr::SetConfig(const TRTCStorageConfig& config)
+{
+    std::lock_guard<std::mutex> lock(m_publishMutex);
+    std::atomic_store(&m_config, std::shared_ptr<const TRTCStorageConfig>(std::make_shared<TRTCStorageConfig>(config)));
+    WriteStorageConfig();   //̸̨߳д̣÷
+}
+
+static bool IsSameStorageConfig(const TRTCStorageConfig& a, const TRTCStorageConfig& b)
+{
+    return a.videoEncParams.videoResolution == b.videoEncParams.videoResolution
+        && a.videoEncParams.resMode == b.videoEncParams.resMode
+        && a.videoEncParams.videoFps == b.videoEncParams.videoFps
+        && a.videoEncParams.videoBitrate == b.videoEncParams.videoBitrate
+        && a.qosParams.preference == b.qosParams.preference
+        && a.qosParams.controlMode == b.qosParams.controlMode
+        && a.bPushSmallVideo == b.bPushSmallVideo
+        && a.bPlaySmallVideo == b.bPlaySmallVideo;
+}
+
+void TRTCStorageConfigMgr::ReloadStorageConfig()
+{
+    uint64_t version = m_pConfigMgr->GetDataVersion();
+    if (m_pConfigMgr->Reload() <= 0)
+        return;
+
+    std::shared_ptr<const TRTCStorageConfig> oldConfig;
+    TRTCStorageConfig newConfig;
+    {
+        std::lock_guard<std::mutex> lock(m_publishMutex);
+        //¼֮ SetConfig ַãڴеñļ£¼
+        if (m_pConfigMgr->GetDataVersion() != version)
+            return;
+
+        //Ƚ¾ãֻ仯ʱŷ֪ͨԼд̴ļ仯ᱻ˵
+        oldConfig = GetConfig();
+        newConfig = *oldConfig;
+        if (!ParseINIConfig(newConfig) || IsSameStorageConfig(*oldConfig, newConfig))
+            return;
+
+        std::atomic_store(&m_config, std::shared_ptr<const TRTCStorageConfig>(std::make_shared<TRTCStorageConfig>(newConfig)));
+    }
+    CConfigBinFile::Save(m_binFilePath, newConfig);
+
+    std::vector<ConfigChangedCallback> listeners;
+    {
+        std::lock_guard<std::mutex> lock(m_listenerMutex);
+        for (std::map<int, ConfigChangedCallback>::iterator itr = m_listeners.begin(); itr != m_listeners.end(); ++itr)
+            listeners.push_back(itr->second);
+    }
+    for (size_t i = 0; i < listeners.size(); ++i)
+        listeners[i](*oldConfig, newConfig);
+}
+
+int TRTCStorageConfigMgr::AddConfigListener(ConfigChangedCallback callback)
+{
+    std::lock_guard<std::mutex> lock(m_listenerMutex);
+    int listenerId = m_nextListenerId++;
+    m_listeners[listenerId] = callback;
+    return listenerId;
+}
+
+void TRTCStorageConfigMgr::RemoveConfigListener(int listenerId)
+{
+    std::lock_guard<std::mutex> lock(m_listenerMutex);
+    m_listeners.erase(listenerId);
+}
+
+void TRTCStorageConfigMgr::StartWatchConfigFile()
+{
+    m_configWatcher.Start(m_pConfigMgr->GetFilePath(), [this]() { ReloadStorageConfig(); });
+}
+
+void TRTCStorageConfigMgr::StopWatchConfigFile()
+{
+    m_configWatcher.Stop();
+}
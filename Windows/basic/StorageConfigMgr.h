@@ -2,7 +2,15 @@
 
 #include <map>
 #include <string>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <memory>
+#include <functional>
+#include <vector>
+#include <stdint.h>
 #include "TRTCCloudDef.h"
+#include "ConfigFileWatcher.h"
 //ֵԽṹ
 namespace Config {
     #define INI_ROOT_KEY L"TRTCDemo"
@@ -25,7 +33,21 @@ public:
     std::map<std::wstring, std::wstring> sub_node;
 };
 
+//ԭȰڵ㷴ĽʽĶԱȽ
+struct CConfigParseBenchResult
+{
+    uint32_t sectionCount = 0;
+    uint32_t keyCount = 0;              //ÿڵļֵ
+    uint32_t bytes = 0;
+    double singlePassMs = 0;            //νƽʱ룩
+    double rescanMs = 0;
+    bool bMatch = true;                 //ַʽĽһ
+};
+
 //INIļ
+//
+//д̲ԣSetValue ֵֻ仯ʱΪݲѺ̨д̣߳
+//̨̺߳ϲһʱڵĶ޸ĺдʱļԭ滻ԭļûиĶʱд̡
 class CConfigMgr
 {
 public:
@@ -34,24 +56,61 @@ public:
 public:
     std::wstring GetValue(std::wstring root, std::wstring key);			    //ɸͼȡֵ
     bool SetValue(std::wstring root, std::wstring key, std::wstring value);	//øͼȡֵ
-    int GetSize() { return map_ini.size(); }
+    int GetSize();
+    int Flush();            //ͬд̣δĸĶʱŻдļ
+    int Reload();           //´Ӵ̽INIļδд̵޸ʱ¼
+    uint64_t GetDataVersion();  //ڴݵİ汾ţÿЧ SetValue 
+    std::wstring GetFilePath() const { return _IncFilePath; }
+    void SetFlushCallback(std::function<void()> callback) { m_flushCallback = callback; }  //ÿγɹд̺д̻߳ص
+
+    static int ParseINIData(const std::string& str_data, std::map<std::wstring, SubNode>& map_ini);  //UTF-8INIı
+    //ָڵͼֵINIıÿٽ durationMs 
+    static std::vector<CConfigParseBenchResult> RunBenchmark(uint32_t durationMs = 100);
+    static std::string FormatBenchmark(const std::vector<CConfigParseBenchResult>& results);
 private:
     int WriteINI();			//дINIļ
     void Clear() { map_ini.clear(); }	//
     void Travel();						//ӡINIļ
     int InitReadINI();
+    void EnsureLoaded();    //״ηʱŽINIļ÷ m_dataMutex
+    void FlushThreadProc(); //̨д߳
 private:
     std::map<std::wstring, SubNode> map_ini;		//INIļݵĴ洢
     std::wstring _IncFilePath;                      //ļ·
+
+    std::mutex m_dataMutex;                         // map_ini Ͱ汾
+    std::mutex m_fileMutex;                         //֤ͬһʱֻһд̲
+    std::condition_variable m_flushCond;
+    std::thread m_flushThread;
+    uint64_t m_dataVersion = 0;                     //ÿЧ޸ĵ
+    uint64_t m_savedVersion = 0;                    //Ѿд̵İ汾
+    bool m_bExitFlush = false;
+    bool m_bLoaded = false;
+    std::function<void()> m_flushCallback;
 };
 
+//Ҫ־ûһͲ޸ģֻգ
+struct TRTCStorageConfig
+{
+    // Ƶ
+    TRTCVideoEncParam videoEncParams;
+    TRTCNetworkQosParam qosParams;
+    bool bPushSmallVideo = false; //˫־
+    bool bPlaySmallVideo = false; //ĬƵ־
+};
+
 /*
 * Module:   TRTCStorageConfigMgr
 *
 * Function: 洢־ûò
 *
 *    1. TRTCSettingViewControllerõĲҪ־ûء
+*
+*    2. ԲɱյʽȡSDKص̣߳ͨ GetConfig õһһµã
+*       д뷽µĿպͨ SetConfig ԭ滻ɿһȡͷźԶ١
 *
+*    3. StartWatchConfigFile ֮INIļⲿ޸ʱԶ½ȷб仯Żᷢ¿ղ֪ͨߡ
+*
 */
 class TRTCStorageConfigMgr
 {
@@ -62,13 +121,26 @@ public:
     void ReadStorageConfig();    //ʼSDKlocalϢ
     void WriteStorageConfig();
 
-public: //trtc 
-    // Ƶ
-    TRTCVideoEncParam videoEncParams;
-    TRTCNetworkQosParam qosParams;
-    bool bPushSmallVideo = false; //˫־
-    bool bPlaySmallVideo = false; //ĬƵ־
+    std::shared_ptr<const TRTCStorageConfig> GetConfig() const;    //ȡǰÿ
+    void SetConfig(const TRTCStorageConfig& config);              //µÿգں̨д
+
+    //ļⲿ޸Ĳ¼غ֪ͨļ߳лص
+    typedef std::function<void(const TRTCStorageConfig& oldConfig, const TRTCStorageConfig& newConfig)> ConfigChangedCallback;
+    int AddConfigListener(ConfigChangedCallback callback);        //ؼID RemoveConfigListener
+    void RemoveConfigListener(int listenerId);
+    void StartWatchConfigFile();
+    void StopWatchConfigFile();
+private:
+    bool ParseINIConfig(TRTCStorageConfig& config);               //INIݽãINIΪʱ false
+    void ReloadStorageConfig();                                   //INIļ仯¼
 private:
     CConfigMgr* m_pConfigMgr;
-};
+    std::wstring m_binFilePath;                                   //ļ·INIļͬĿ¼
+    std::shared_ptr<const TRTCStorageConfig> m_config;            //ֻͨ std::atomic_load/atomic_store 
+    std::mutex m_publishMutex;                                    //SetConfigReadStorageConfig  ReloadStorageConfig η
 
+    std::mutex m_listenerMutex;
+    std::map<int, ConfigChangedCallback> m_listeners;
+    int m_nextListenerId = 1;
+    CConfigFileWatcher m_configWatcher;
+};
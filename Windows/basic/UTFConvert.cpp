@@ -0,0 +1,404 @@
+#include "UTFConvert.h"
+#include "Base.h"
+#include "Benchmark.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define UTF_CONVERT_SSE2
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#include <arm_neon.h>
+#define UTF_CONVERT_NEON
+#endif
+
+#define UTF_REPLACEMENT_CHAR 0xFFFD
+
+//16 ֽǷȫΪ ASCIIչ 16  UTF-16 Ԫд dst
+static inline bool WidenASCIIBlock(const char* src, uint16_t* dst)
+{
+#if defined(UTF_CONVERT_SSE2)
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    if (_mm_movemask_epi8(bytes) != 0)
+        return false;
+    __m128i zero = _mm_setzero_si128();
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi8(bytes, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 8), _mm_unpackhi_epi8(bytes, zero));
+    return true;
+#elif defined(UTF_CONVERT_NEON)
+    uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8_t*>(src));
+    if (vmaxvq_u8(bytes) >= 0x80)
+        return false;
+    vst1q_u16(dst, vmovl_u8(vget_low_u8(bytes)));
+    vst1q_u16(dst + 8, vmovl_u8(vget_high_u8(bytes)));
+    return true;
+#else
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(src);
+    for (int i = 0; i < 16; ++i)
+    {
+        if (p[i] >= 0x80)
+            return false;
+    }
+    for (int i = 0; i < 16; ++i)
+        dst[i] = p[i];
+    return true;
+#endif
+}
+
+//8  UTF-16 ԪǷȫΪ ASCIIѹ 8 ֽд dst
+static inline bool NarrowASCIIBlock(const uint16_t* src, char* dst)
+{
+#if defined(UTF_CONVERT_SSE2)
+    __m128i units = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    //Ԫĸ 9 λΪ 0  ASCII
+    if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(units, _mm_set1_epi16((short)0xFF80)), _mm_setzero_si128())) != 0xFFFF)
+        return false;
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(units, units));
+    return true;
+#elif defined(UTF_CONVERT_NEON)
+    uint16x8_t units = vld1q_u16(src);
+    if (vmaxvq_u16(units) >= 0x80)
+        return false;
+    vst1_u8(reinterpret_cast<uint8_t*>(dst), vmovn_u16(units));
+    return true;
+#else
+    for (int i = 0; i < 8; ++i)
+    {
+        if (src[i] >= 0x80)
+            return false;
+    }
+    for (int i = 0; i < 8; ++i)
+        dst[i] = (char)src[i];
+    return true;
+#endif
+}
+
+bool IsASCII(const char* src, size_t len)
+{
+    size_t i = 0;
+#if defined(UTF_CONVERT_SSE2)
+    for (; i + 16 <= len; i += 16)
+    {
+        if (_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))) != 0)
+            return false;
+    }
+#elif defined(UTF_CONVERT_NEON)
+    for (; i + 16 <= len; i += 16)
+    {
+        if (vmaxvq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(src + i))) >= 0x80)
+            return false;
+    }
+#endif
+    for (; i < len; ++i)
+    {
+        if ((uint8_t)src[i] >= 0x80)
+            return false;
+    }
+    return true;
+}
+
+// src[i] ʼһ UTF-8 ַ㲢ǰ iǷֻһֽڲ U+FFFD
+static inline uint32_t DecodeUTF8Char(const uint8_t* src, size_t len, size_t& i)
+{
+    uint32_t c = src[i];
+    if (c < 0x80)
+    {
+        ++i;
+        return c;
+    }
+
+    size_t extra = 0;
+    uint32_t minValue = 0;
+    if ((c & 0xE0) == 0xC0)      { extra = 1; c &= 0x1F; minValue = 0x80; }
+    else if ((c & 0xF0) == 0xE0) { extra = 2; c &= 0x0F; minValue = 0x800; }
+    else if ((c & 0xF8) == 0xF0) { extra = 3; c &= 0x07; minValue = 0x10000; }
+    else
+    {
+        ++i;
+        return UTF_REPLACEMENT_CHAR;
+    }
+
+    if (i + extra >= len)
+    {
+        ++i;
+        return UTF_REPLACEMENT_CHAR;
+    }
+    for (size_t k = 1; k <= extra; ++k)
+    {
+        uint32_t cc = src[i + k];
+        if ((cc & 0xC0) != 0x80)
+        {
+            ++i;
+            return UTF_REPLACEMENT_CHAR;
+        }
+        c = (c << 6) | (cc & 0x3F);
+    }
+
+    //롢ͳ Unicode Χ㶼ΪǷ
+    if (c < minValue || (c >= 0xD800 && c <= 0xDFFF) || c > 0x10FFFF)
+    {
+        ++i;
+        return UTF_REPLACEMENT_CHAR;
+    }
+    i += extra + 1;
+    return c;
+}
+
+size_t UTF8ToUTF16(const char* src, size_t srcLen, uint16_t* dst)
+{
+    const uint8_t* in = reinterpret_cast<const uint8_t*>(src);
+    uint16_t* out = dst;
+    size_t i = 0;
+    while (i < srcLen)
+    {
+        if (i + 16 <= srcLen)
+        {
+            if (WidenASCIIBlock(src + i, out))
+            {
+                i += 16;
+                out += 16;
+                continue;
+            }
+
+            //ǰ麬з ASCII ַַ뵽βٳ·
+            size_t blockEnd = i + 16;
+            while (i < blockEnd)
+            {
+                uint32_t c = DecodeUTF8Char(in, srcLen, i);
+                if (c >= 0x10000)
+                {
+                    c -= 0x10000;
+                    *out++ = (uint16_t)(0xD800 | (c >> 10));
+                    *out++ = (uint16_t)(0xDC00 | (c & 0x3FF));
+                }
+                else
+                {
+                    *out++ = (uint16_t)c;
+                }
+            }
+            continue;
+        }
+
+        uint32_t c = DecodeUTF8Char(in, srcLen, i);
+        if (c >= 0x10000)
+        {
+            c -= 0x10000;
+            *out++ = (uint16_t)(0xD800 | (c >> 10));
+            *out++ = (uint16_t)(0xDC00 | (c & 0x3FF));
+        }
+        else
+        {
+            *out++ = (uint16_t)c;
+        }
+    }
+    return out - dst;
+}
+
+size_t UTF16ToUTF8(const uint16_t* src, size_t srcLen, char* dst)
+{
+    uint8_t* out = reinterpret_cast<uint8_t*>(dst);
+    size_t i = 0;
+    while (i < srcLen)
+    {
+        if (i + 8 <= srcLen && NarrowASCIIBlock(src + i, reinterpret_cast<char*>(out)))
+        {
+            i += 8;
+            out += 8;
+            continue;
+        }
+
+        uint32_t c = src[i++];
+        if (c < 0x80)
+        {
+            *out++ = (uint8_t)c;
+            continue;
+        }
+        if (c < 0x800)
+        {
+            *out++ = (uint8_t)(0xC0 | (c >> 6));
+            *out++ = (uint8_t)(0x80 | (c & 0x3F));
+            continue;
+        }
+        if (c >= 0xD800 && c <= 0xDFFF)
+        {
+            //ߴʹ򰴲ɶԴ
+            if (c <= 0xDBFF && i < srcLen && src[i] >= 0xDC00 && src[i] <= 0xDFFF)
+            {
+                c = 0x10000 + ((c - 0xD800) << 10) + (src[i++] - 0xDC00);
+                *out++ = (uint8_t)(0xF0 | (c >> 18));
+                *out++ = (uint8_t)(0x80 | ((c >> 12) & 0x3F));
+                *out++ = (uint8_t)(0x80 | ((c >> 6) & 0x3F));
+                *out++ = (uint8_t)(0x80 | (c & 0x3F));
+                continue;
+            }
+            c = UTF_REPLACEMENT_CHAR;
+        }
+        *out++ = (uint8_t)(0xE0 | (c >> 12));
+        *out++ = (uint8_t)(0x80 | ((c >> 6) & 0x3F));
+        *out++ = (uint8_t)(0x80 | (c & 0x3F));
+    }
+    return out - reinterpret_cast<uint8_t*>(dst);
+}
+
+//////////////////////////////////////////////////////////////////////////Benchmark
+//ԭ Base.h еʵ֣ȵһϵͳ API 󳤶ȣתʱ󿽱ַ
+static std::wstring SystemUTF82Wide(const std::string& strUTF8)
+{
+    int nWide = ::MultiByteToWideChar(CP_UTF8, 0, strUTF8.c_str(), strUTF8.size(), NULL, 0);
+
+    std::unique_ptr<wchar_t[]> buffer(new wchar_t[nWide + 1]);
+    ::MultiByteToWideChar(CP_UTF8, 0, strUTF8.c_str(), strUTF8.size(), buffer.get(), nWide);
+    buffer[nWide] = L'\0';
+
+    return buffer.get();
+}
+
+static std::string SystemWide2UTF8(const std::wstring& strWide)
+{
+    int nUTF8 = ::WideCharToMultiByte(CP_UTF8, 0, strWide.c_str(), strWide.size(), NULL, 0, NULL, NULL);
+
+    std::unique_ptr<char[]> buffer(new char[nUTF8 + 1]);
+    ::WideCharToMultiByte(CP_UTF8, 0, strWide.c_str(), strWide.size(), buffer.get(), nUTF8, NULL, NULL);
+    buffer[nUTF8] = '\0';
+
+    return buffer.get();
+}
+
+//Ĳοʵ֣ϵͳ API Ҳ·κƽ̨УתֻϷ UTF-8
+static std::wstring ScalarUTF82Wide(const std::string& strUTF8)
+{
+    std::wstring strWide;
+    const uint8_t* src = (const uint8_t*)strUTF8.data();
+    size_t i = 0;
+    while (i < strUTF8.size())
+    {
+        uint32_t lead = src[i++];
+        int extra = lead < 0x80 ? 0 : lead < 0xE0 ? 1 : lead < 0xF0 ? 2 : 3;
+        uint32_t cp = extra == 0 ? lead : (lead & (0x3F >> extra));
+        for (int k = 0; k < extra && i < strUTF8.size(); ++k)
+            cp = (cp << 6) | (src[i++] & 0x3F);
+
+        if (cp >= 0x10000)
+        {
+            cp -= 0x10000;
+            strWide += (wchar_t)(0xD800 | (cp >> 10));
+            strWide += (wchar_t)(0xDC00 | (cp & 0x3FF));
+        }
+        else
+        {
+            strWide += (wchar_t)cp;
+        }
+    }
+    return strWide;
+}
+
+static std::string ScalarWide2UTF8(const std::wstring& strWide)
+{
+    std::string strUTF8;
+    for (size_t i = 0; i < strWide.size(); ++i)
+    {
+        uint32_t cp = (uint16_t)strWide[i];
+        if (cp >= 0xD800 && cp < 0xDC00 && i + 1 < strWide.size())
+            cp = 0x10000 + ((cp - 0xD800) << 10) + ((uint16_t)strWide[++i] - 0xDC00);
+
+        if (cp < 0x80)
+        {
+            strUTF8 += (char)cp;
+        }
+        else if (cp < 0x800)
+        {
+            strUTF8 += (char)(0xC0 | (cp >> 6));
+            strUTF8 += (char)(0x80 | (cp & 0x3F));
+        }
+        else if (cp < 0x10000)
+        {
+            strUTF8 += (char)(0xE0 | (cp >> 12));
+            strUTF8 += (char)(0x80 | ((cp >> 6) & 0x3F));
+            strUTF8 += (char)(0x80 | (cp & 0x3F));
+        }
+        else
+        {
+            strUTF8 += (char)(0xF0 | (cp >> 18));
+            strUTF8 += (char)(0x80 | ((cp >> 12) & 0x3F));
+            strUTF8 += (char)(0x80 | ((cp >> 6) & 0x3F));
+            strUTF8 += (char)(0x80 | (cp & 0x3F));
+        }
+    }
+    return strUTF8;
+}
+
+//ظ unit ֱ bytes ֽ
+static std::string MakeBenchText(const char* unit, size_t bytes)
+{
+    std::string text;
+    while (text.size() < bytes)
+        text += unit;
+    return text;
+}
+
+static double ToMBps(size_t bytes, double ms)
+{
+    return PerSecond((double)bytes, ms) / 1000000.0;
+}
+
+std::vector<UTFConvertBenchResult> RunUTFConvertBenchmark(uint32_t durationMs)
+{
+    //userId ȵĶı INI/־ȵĳııÿռ 3  UTF-8 ֽڣռ 4 ֽڣUTF-16 ԣ
+    struct BenchText
+    {
+        const char* name;
+        std::string utf8;
+    };
+    const BenchText texts[] = {
+        { "ascii 32B", MakeBenchText("user_1234567890_", 32) },
+        { "ascii 64KB", MakeBenchText("INI_KEY_VIDEO_BITRATE=500\r\n", 64 * 1024) },
+        { "mixed 32B", MakeBenchText("user_\xE6\xB5\x8B\xE8\xAF\x95_", 32) },
+        { "mixed 64KB", MakeBenchText("roomId=1234 \xE7\x94\xA8\xE6\x88\xB7\xE5\x90\x8D=\xE6\xB5\x8B\xE8\xAF\x95\r\n", 64 * 1024) },
+        { "emoji 64KB", MakeBenchText("nick=\xF0\x9F\x98\x80\xC3\xA9\xE6\xB5\x8B\r\n", 64 * 1024) },
+    };
+
+    std::vector<UTFConvertBenchResult> results;
+    for (size_t i = 0; i < _countof(texts); ++i)
+    {
+        const std::string& utf8 = texts[i].utf8;
+        const std::wstring wide = ScalarUTF82Wide(utf8);
+
+        UTFConvertBenchResult toWide;
+        toWide.name = texts[i].name;
+        toWide.bToWide = true;
+        toWide.utf8Bytes = (uint32_t)utf8.size();
+        std::wstring transcoderWide;
+        std::wstring systemWide;
+        toWide.transcoderMBps = ToMBps(utf8.size(), MeasureAverageMs(durationMs, [&]() { transcoderWide = UTF82Wide(utf8); }));
+        toWide.systemMBps = ToMBps(utf8.size(), MeasureAverageMs(durationMs, [&]() { systemWide = SystemUTF82Wide(utf8); }));
+        toWide.bMatch = transcoderWide == wide && ScalarWide2UTF8(transcoderWide) == utf8;
+        toWide.bMatchSystem = transcoderWide == systemWide;
+        results.push_back(toWide);
+
+        UTFConvertBenchResult toUTF8;
+        toUTF8.name = texts[i].name;
+        toUTF8.bToWide = false;
+        toUTF8.utf8Bytes = (uint32_t)utf8.size();
+        std::string transcoderUTF8;
+        std::string systemUTF8;
+        toUTF8.transcoderMBps = ToMBps(utf8.size(), MeasureAverageMs(durationMs, [&]() { transcoderUTF8 = Wide2UTF8(wide); }));
+        toUTF8.systemMBps = ToMBps(utf8.size(), MeasureAverageMs(durationMs, [&]() { systemUTF8 = SystemWide2UTF8(wide); }));
+        toUTF8.bMatch = transcoderUTF8 == utf8 && ScalarWide2UTF8(wide) == utf8;
+        toUTF8.bMatchSystem = transcoderUTF8 == systemUTF8;
+        results.push_back(toUTF8);
+    }
+    return results;
+}
+
+std::string FormatUTFConvertBenchmark(const std::vector<UTFConvertBenchResult>& results)
+{
+    std::string report;
+    format_to(report, "%-12s %-12s %8s %16s %12s %8s %6s %7s\r\n",
+        "text", "direction", "bytes", "transcoder MB/s", "system MB/s", "speedup", "match", "system");
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const UTFConvertBenchResult& r = results[i];
+        format_to(report, "%-12s %-12s %8u %16.1f %12.1f %8.2f %6s %7s\r\n",
+            r.name.c_str(), r.bToWide ? "UTF-8->16" : "UTF-16->8", r.utf8Bytes, r.transcoderMBps, r.systemMBps,
+            r.systemMBps > 0 ? r.transcoderMBps / r.systemMBps : 0.0, r.bMatch ? "yes" : "NO", r.bMatchSystem ? "yes" : "NO");
+    }
+    return report;
+}
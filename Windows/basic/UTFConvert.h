@@ -0,0 +1,47 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*
+* Module:   UTFConvert
+*
+* Function: ϵͳ API  UTF-8 <-> UTF-16 ת
+*
+*    1.  ASCII ݿ飨userIdINI ֵȾʹ SSE2/NEON һδ 16 ֽڣ
+*        ASCII ַʱ˻ַ룬굱ǰٻص·
+*
+*    2. ÷ԤȷĿ껺תֱд룬ʱͶ⿽
+*
+*    3. Ƿ UTF-8 ֽкͲɶԵ UTF-16 滻Ϊ U+FFFD MultiByteToWideChar/WideCharToMultiByte ĬΪһ¡
+*
+*    4. RunUTFConvertBenchmark Ա Base.h еתԭȵϵͳ API ʵֻ֣ܲԣ
+*       תĲοʵΪ׼У飬ϵͳ APIκƽ̨϶С
+*/
+
+//UTF-8 ת UTF-16д UTF-16 Ԫdst Ҫ srcLen ԪĿռ
+size_t UTF8ToUTF16(const char* src, size_t srcLen, uint16_t* dst);
+
+//UTF-16 ת UTF-8дֽdst Ҫ srcLen * 3 ֽڵĿռ
+size_t UTF16ToUTF8(const uint16_t* src, size_t srcLen, char* dst);
+
+//жһǷȫ ASCII ַ
+bool IsASCII(const char* src, size_t len);
+
+//һݡһת UTF-8 ֽ
+struct UTFConvertBenchResult
+{
+    std::string name;
+    bool bToWide = true;            //true Ϊ UTF-8 ת UTF-16
+    uint32_t utf8Bytes = 0;         //ÿת UTF-8 ֽ
+    double transcoderMBps = 0;      //UTF82Wide/Wide2UTF8
+    double systemMBps = 0;          //MultiByteToWideChar/WideCharToMultiByte 󳤶ת
+    bool bMatch = true;             //οʵֵĽһ£תԭ
+    bool bMatchSystem = true;       //ϵͳ API Ľһ
+};
+
+// ASCII ӢĻϵĶ̡ıÿ durationMs 
+std::vector<UTFConvertBenchResult> RunUTFConvertBenchmark(uint32_t durationMs = 100);
+std::string FormatUTFConvertBenchmark(const std::vector<UTFConvertBenchResult>& results);
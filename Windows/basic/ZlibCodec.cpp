@@ -0,0 +1,458 @@
+#include "ZlibCodec.h"
+
+#include <memory>
+
+#define MAX_CODE_BITS   15
+#define MAX_LIT_CODES   288
+#define MAX_DIST_CODES  30
+#define WINDOW_SIZE     32768
+#define MIN_MATCH       3
+#define MAX_MATCH       258
+#define HASH_BITS       14
+
+//λȡ deflate λǰ
+struct BitReader
+{
+    const uint8_t* data;
+    size_t size;
+    size_t pos;
+    uint32_t bitBuf;
+    int bitCount;
+    bool overflow;
+
+    int Bits(int need)
+    {
+        while (bitCount < need)
+        {
+            if (pos >= size)
+            {
+                overflow = true;
+                return 0;
+            }
+            bitBuf |= (uint32_t)data[pos++] << bitCount;
+            bitCount += 8;
+        }
+        int value = (int)(bitBuf & ((1u << need) - 1));
+        bitBuf >>= need;
+        bitCount -= need;
+        return value;
+    }
+};
+
+//淶count[len] Ϊ볤Ϊ len ķŸsymbol ֵ˳
+struct Huffman
+{
+    short count[MAX_CODE_BITS + 1];
+    short symbol[MAX_LIT_CODES];
+};
+
+static const short kLengthBase[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+static const short kLengthExtra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+static const short kDistBase[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+static const short kDistExtra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+//볤볤ϳover-subscribedʱ false
+static bool BuildHuffman(Huffman& h, const short* length, int n)
+{
+    for (int len = 0; len <= MAX_CODE_BITS; ++len)
+        h.count[len] = 0;
+    for (int i = 0; i < n; ++i)
+        h.count[length[i]]++;
+    if (h.count[0] == n)
+        return true;
+
+    int left = 1;
+    for (int len = 1; len <= MAX_CODE_BITS; ++len)
+    {
+        left <<= 1;
+        left -= h.count[len];
+        if (left < 0)
+            return false;
+    }
+
+    short offs[MAX_CODE_BITS + 1];
+    offs[1] = 0;
+    for (int len = 1; len < MAX_CODE_BITS; ++len)
+        offs[len + 1] = offs[len] + h.count[len];
+    for (int i = 0; i < n; ++i)
+    {
+        if (length[i] != 0)
+            h.symbol[offs[length[i]]++] = (short)i;
+    }
+    return true;
+}
+
+//λһţʧܷ -1
+static int DecodeSymbol(BitReader& br, const Huffman& h)
+{
+    int code = 0;
+    int first = 0;
+    int index = 0;
+    for (int len = 1; len <= MAX_CODE_BITS; ++len)
+    {
+        code |= br.Bits(1);
+        if (br.overflow)
+            return -1;
+        int count = h.count[len];
+        if (code - count < first)
+            return h.symbol[index + (code - first)];
+        index += count;
+        first += count;
+        first <<= 1;
+        code <<= 1;
+    }
+    return -1;
+}
+
+static bool InflateCodes(BitReader& br, std::string& out, size_t outStart, const Huffman& lencode, const Huffman& distcode)
+{
+    while (true)
+    {
+        int symbol = DecodeSymbol(br, lencode);
+        if (symbol < 0)
+            return false;
+        if (symbol < 256)
+        {
+            out.push_back((char)symbol);
+            continue;
+        }
+        if (symbol == 256)
+            return true;
+
+        symbol -= 257;
+        if (symbol >= 29)
+            return false;
+        int len = kLengthBase[symbol] + br.Bits(kLengthExtra[symbol]);
+
+        symbol = DecodeSymbol(br, distcode);
+        if (symbol < 0 || symbol >= 30)
+            return false;
+        size_t dist = kDistBase[symbol] + br.Bits(kDistExtra[symbol]);
+        if (br.overflow || dist > out.size() - outStart)
+            return false;
+
+        //صҪֽڽ
+        size_t from = out.size() - dist;
+        for (int i = 0; i < len; ++i)
+            out.push_back(out[from + i]);
+    }
+}
+
+static bool InflateStored(BitReader& br, std::string& out)
+{
+    br.bitBuf = 0;
+    br.bitCount = 0;
+    if (br.pos + 4 > br.size)
+        return false;
+    unsigned len = br.data[br.pos] | (br.data[br.pos + 1] << 8);
+    unsigned nlen = br.data[br.pos + 2] | (br.data[br.pos + 3] << 8);
+    br.pos += 4;
+    if (len != (~nlen & 0xFFFF) || br.pos + len > br.size)
+        return false;
+    out.append(reinterpret_cast<const char*>(br.data + br.pos), len);
+    br.pos += len;
+    return true;
+}
+
+static bool InflateFixed(BitReader& br, std::string& out, size_t outStart)
+{
+    static Huffman s_lencode;
+    static Huffman s_distcode;
+    static bool s_ready = []()
+    {
+        short lengths[MAX_LIT_CODES];
+        int symbol = 0;
+        for (; symbol < 144; ++symbol) lengths[symbol] = 8;
+        for (; symbol < 256; ++symbol) lengths[symbol] = 9;
+        for (; symbol < 280; ++symbol) lengths[symbol] = 7;
+        for (; symbol < MAX_LIT_CODES; ++symbol) lengths[symbol] = 8;
+        BuildHuffman(s_lencode, lengths, MAX_LIT_CODES);
+        for (symbol = 0; symbol < MAX_DIST_CODES; ++symbol) lengths[symbol] = 5;
+        BuildHuffman(s_distcode, lengths, MAX_DIST_CODES);
+        return true;
+    }();
+    (void)s_ready;
+
+    return InflateCodes(br, out, outStart, s_lencode, s_distcode);
+}
+
+static bool InflateDynamic(BitReader& br, std::string& out, size_t outStart)
+{
+    static const short kCodeLengthOrder[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+    int nlen = br.Bits(5) + 257;
+    int ndist = br.Bits(5) + 1;
+    int ncode = br.Bits(4) + 4;
+    if (br.overflow || nlen > MAX_LIT_CODES || ndist > MAX_DIST_CODES)
+        return false;
+
+    short lengths[MAX_LIT_CODES + MAX_DIST_CODES] = { 0 };
+    for (int i = 0; i < ncode; ++i)
+        lengths[kCodeLengthOrder[i]] = (short)br.Bits(3);
+    if (br.overflow)
+        return false;
+
+    Huffman lencode;
+    Huffman distcode;
+    if (!BuildHuffman(lencode, lengths, 19))
+        return false;
+
+    int index = 0;
+    while (index < nlen + ndist)
+    {
+        int symbol = DecodeSymbol(br, lencode);
+        if (symbol < 0)
+            return false;
+        if (symbol < 16)
+        {
+            lengths[index++] = (short)symbol;
+            continue;
+        }
+
+        short len = 0;
+        int repeat = 0;
+        if (symbol == 16)
+        {
+            if (index == 0)
+                return false;
+            len = lengths[index - 1];
+            repeat = 3 + br.Bits(2);
+        }
+        else if (symbol == 17)
+        {
+            repeat = 3 + br.Bits(3);
+        }
+        else
+        {
+            repeat = 11 + br.Bits(7);
+        }
+        if (br.overflow || index + repeat > nlen + ndist)
+            return false;
+        while (repeat--)
+            lengths[index++] = len;
+    }
+
+    //бн
+    if (lengths[256] == 0)
+        return false;
+    if (!BuildHuffman(lencode, lengths, nlen) || !BuildHuffman(distcode, lengths + nlen, ndist))
+        return false;
+
+    return InflateCodes(br, out, outStart, lencode, distcode);
+}
+
+uint32_t Adler32(const void* data, size_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint32_t a = 1;
+    uint32_t b = 0;
+    while (size > 0)
+    {
+        //5552 Ǳ֤ b  32 λ
+        size_t n = size < 5552 ? size : 5552;
+        size -= n;
+        while (n--)
+        {
+            a += *bytes++;
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+    }
+    return (b << 16) | a;
+}
+
+bool ZlibUncompress(const void* src, size_t srcLen, std::string& dst)
+{
+    const uint8_t* data = static_cast<const uint8_t*>(src);
+    if (srcLen < 6)
+        return false;
+
+    //CMF/FLGֻ֧ deflateԤֵ
+    if ((data[0] & 0x0F) != 8 || ((data[0] << 8) | data[1]) % 31 != 0 || (data[1] & 0x20) != 0)
+        return false;
+
+    BitReader br = { data, srcLen - 4, 2, 0, 0, false };
+    size_t outStart = dst.size();
+    bool ok = true;
+    int last = 0;
+    do
+    {
+        last = br.Bits(1);
+        int type = br.Bits(2);
+        if (br.overflow)
+            return false;
+
+        if (type == 0)
+            ok = InflateStored(br, dst);
+        else if (type == 1)
+            ok = InflateFixed(br, dst, outStart);
+        else if (type == 2)
+            ok = InflateDynamic(br, dst, outStart);
+        else
+            ok = false;
+    } while (ok && !last);
+
+    if (!ok)
+    {
+        dst.resize(outStart);
+        return false;
+    }
+
+    const uint8_t* trailer = data + srcLen - 4;
+    uint32_t adler = ((uint32_t)trailer[0] << 24) | ((uint32_t)trailer[1] << 16) | ((uint32_t)trailer[2] << 8) | trailer[3];
+    if (adler != Adler32(dst.data() + outStart, dst.size() - outStart))
+    {
+        dst.resize(outStart);
+        return false;
+    }
+    return true;
+}
+
+//λд deflate λǰ
+struct BitWriter
+{
+    std::string& out;
+    uint32_t bitBuf;
+    int bitCount;
+
+    void PutBits(uint32_t value, int count)
+    {
+        bitBuf |= value << bitCount;
+        bitCount += count;
+        while (bitCount >= 8)
+        {
+            out.push_back((char)(bitBuf & 0xFF));
+            bitBuf >>= 8;
+            bitCount -= 8;
+        }
+    }
+
+    //밴λǰд룬Ҫȷת
+    void PutCode(uint32_t code, int length)
+    {
+        uint32_t reversed = 0;
+        for (int i = 0; i < length; ++i)
+        {
+            reversed = (reversed << 1) | (code & 1);
+            code >>= 1;
+        }
+        PutBits(reversed, length);
+    }
+
+    void Flush()
+    {
+        if (bitCount > 0)
+            out.push_back((char)(bitBuf & 0xFF));
+        bitBuf = 0;
+        bitCount = 0;
+    }
+};
+
+static void PutFixedLiteral(BitWriter& bw, int symbol)
+{
+    if (symbol < 144)
+        bw.PutCode(0x30 + symbol, 8);
+    else if (symbol < 256)
+        bw.PutCode(0x190 + symbol - 144, 9);
+    else if (symbol < 280)
+        bw.PutCode(symbol - 256, 7);
+    else
+        bw.PutCode(0xC0 + symbol - 280, 8);
+}
+
+static void PutFixedMatch(BitWriter& bw, int length, int distance)
+{
+    int code = 28;
+    while (kLengthBase[code] > length)
+        --code;
+    PutFixedLiteral(bw, 257 + code);
+    bw.PutBits(length - kLengthBase[code], kLengthExtra[code]);
+
+    code = 29;
+    while (kDistBase[code] > distance)
+        --code;
+    bw.PutCode(code, 5);
+    bw.PutBits(distance - kDistBase[code], kDistExtra[code]);
+}
+
+static inline uint32_t Hash3(const uint8_t* p)
+{
+    uint32_t value = ((uint32_t)p[0] << 16) | ((uint32_t)p[1] << 8) | p[2];
+    return (value * 2654435761u) >> (32 - HASH_BITS);
+}
+
+void ZlibCompress(const void* src, size_t srcLen, std::string& dst)
+{
+    const uint8_t* data = static_cast<const uint8_t*>(src);
+
+    //CMF = 0x78deflate32K ڣFLG = 0x01ѹ 31 ıУ飩
+    dst.push_back((char)0x78);
+    dst.push_back((char)0x01);
+
+    BitWriter bw = { dst, 0, 0 };
+    bw.PutBits(1, 1);   //BFINAL
+    bw.PutBits(1, 2);   //BTYPE = ̶
+
+    //ÿϣֻ¼һγֵλã+10 ʾգ
+    std::unique_ptr<uint32_t[]> head(new uint32_t[1 << HASH_BITS]());
+    size_t pos = 0;
+    while (pos < srcLen)
+    {
+        int bestLength = 0;
+        size_t bestDistance = 0;
+        if (pos + MIN_MATCH <= srcLen)
+        {
+            uint32_t hash = Hash3(data + pos);
+            size_t candidate = head[hash];
+            head[hash] = (uint32_t)pos + 1;
+            if (candidate != 0 && pos - (candidate - 1) <= WINDOW_SIZE)
+            {
+                const uint8_t* a = data + candidate - 1;
+                const uint8_t* b = data + pos;
+                size_t maxLength = srcLen - pos < MAX_MATCH ? srcLen - pos : MAX_MATCH;
+                int length = 0;
+                while ((size_t)length < maxLength && a[length] == b[length])
+                    ++length;
+                if (length >= MIN_MATCH)
+                {
+                    bestLength = length;
+                    bestDistance = pos - (candidate - 1);
+                }
+            }
+        }
+
+        if (bestLength == 0)
+        {
+            PutFixedLiteral(bw, data[pos]);
+            ++pos;
+            continue;
+        }
+
+        PutFixedMatch(bw, bestLength, (int)bestDistance);
+        //ƥڲλҲϣƥ䵽
+        size_t end = pos + bestLength;
+        for (++pos; pos < end; ++pos)
+        {
+            if (pos + MIN_MATCH <= srcLen)
+                head[Hash3(data + pos)] = (uint32_t)pos + 1;
+        }
+    }
+
+    PutFixedLiteral(bw, 256);
+    bw.Flush();
+
+    uint32_t adler = Adler32(data, srcLen);
+    dst.push_back((char)(adler >> 24));
+    dst.push_back((char)(adler >> 16));
+    dst.push_back((char)(adler >> 8));
+    dst.push_back((char)adler);
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+/*
+* Module:   ZlibCodec
+*
+* Function:  zlibRFC 1950/1951ѹѹ
+*
+*    1. ִ֧洢顢̶Ͷ̬飬ѹУ Adler-32
+*
+*    2. ѹֻʹù̶ӵѡ LZ77 ƥ䣬ѹʲ zlibǱ׼ʽκ zlib ʵֶܽѹ
+*
+*    3. ɺͽ UserSig Сݣ׷µ¡
+*/
+
+//ѹһ zlib ʽݣ׷ӵ dstݷǷ򱻽ضʱ false
+bool ZlibUncompress(const void* src, size_t srcLen, std::string& dst);
+
+//ѹһݣzlib ʽ׷ӵ dst
+void ZlibCompress(const void* src, size_t srcLen, std::string& dst);
+
+uint32_t Adler32(const void* data, size_t size);
@@ -0,0 +1,134 @@
+/*
+* Module:   TRTCFakeRoomProfile
+*
+* Function: Linux ģ SDK һ䣬ͳƻص TRTCCallbackDispatcher תʱӺȾص£ perf ȹܷ
+*
+*    ÷TRTCFakeRoomProfile [Զû] [Ⱦ֡] []Ĭ 16 ˡ15 ֡10 
+*/
+
+#include "TRTCCloud.h"
+#include "TRTCFakeSDK.h"
+#include "TRTCCallbackDispatcher.h"
+
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+
+//ڼ߳ϴصԶûʼͳƸص
+class ProfileListener : public ITRTCCloudCallback
+{
+public:
+    explicit ProfileListener(TRTCCloud* cloud) : m_cloud(cloud) {}
+
+    virtual void onError(TXLiteAVError errCode, const char* errMsg, void* arg)
+    {
+        fprintf(stderr, "onError %d %s\n", errCode, errMsg ? errMsg : "");
+    }
+    virtual void onWarning(TXLiteAVWarning warningCode, const char* warningMsg, void* arg) {}
+    virtual void onEnterRoom(uint64_t elapsed) { m_enterElapsed = elapsed; }
+    virtual void onExitRoom(int reason) {}
+    virtual void onUserEnter(const char* userId)
+    {
+        ++m_userEnterCount;
+        m_cloud->startRemoteView(userId, NULL);
+    }
+    virtual void onUserExit(const char* userId, int reason)
+    {
+        ++m_userExitCount;
+        m_cloud->stopRemoteView(userId);
+    }
+    virtual void onUserVoiceVolume(TRTCVolumeInfo* userVolumes, uint32_t userVolumesCount, uint32_t totalVolume) { ++m_volumeCount; }
+    virtual void onNetworkQuality(TRTCQualityInfo localQuality, TRTCQualityInfo* remoteQuality, uint32_t remoteQualityCount) { ++m_qualityCount; }
+    virtual void onStatistics(const TRTCStatistics& statis) { ++m_statisticsCount; }
+public:
+    std::atomic<uint64_t> m_enterElapsed{ 0 };
+    std::atomic<uint32_t> m_userEnterCount{ 0 };
+    std::atomic<uint32_t> m_userExitCount{ 0 };
+    std::atomic<uint32_t> m_volumeCount{ 0 };
+    std::atomic<uint32_t> m_qualityCount{ 0 };
+    std::atomic<uint32_t> m_statisticsCount{ 0 };
+private:
+    TRTCCloud* m_cloud;
+};
+
+// SDK ص߳ͳȾ֡һ黭ݣģ
+class ProfileRenderer : public ITRTCVideoRenderCallback
+{
+public:
+    virtual void onRenderVideoFrame(const char* userId, TRTCVideoStreamType streamType, TRTCVideoFrame* frame)
+    {
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(frame->data);
+        uint32_t checksum = 0;
+        for (uint32_t i = 0; i < frame->length; i += 64)
+            checksum += data[i];
+
+        ++m_frameCount;
+        m_byteCount += frame->length;
+        m_checksum += checksum;
+    }
+public:
+    std::atomic<uint64_t> m_frameCount{ 0 };
+    std::atomic<uint64_t> m_byteCount{ 0 };
+    std::atomic<uint32_t> m_checksum{ 0 };
+};
+
+int main(int argc, char* argv[])
+{
+    uint32_t userCount = argc > 1 ? (uint32_t)atoi(argv[1]) : 16;
+    uint32_t renderFps = argc > 2 ? (uint32_t)atoi(argv[2]) : 15;
+    uint32_t seconds = argc > 3 ? (uint32_t)atoi(argv[3]) : 10;
+
+    TRTCFakeCloudParams params;
+    params.statisticsIntervalMs = 1000;
+    params.networkQualityIntervalMs = 1000;
+    params.voiceVolumeIntervalMs = 300;
+    params.virtualUserCount = userCount;
+    params.userChurnIntervalMs = 1000;
+    params.virtualUserEncParam.videoResolution = TRTCVideoResolution_640_360;
+    params.virtualUserEncParam.videoFps = renderFps;
+    params.renderFps = renderFps;
+    TRTCFakeSDKSetCloudParams(params);
+
+    TRTCCloud cloud;
+    TRTCCallbackDispatcher dispatcher;
+    ProfileListener listener(&cloud);
+    ProfileRenderer renderer;
+    dispatcher.addListener(&listener);
+    cloud.addCallback(&dispatcher);
+    cloud.setRemoteVideoRenderCallback(NULL, TRTCVideoPixelFormat_I420, TRTCVideoBufferType_Buffer, &renderer);
+
+    TRTCParams enterParams;
+    enterParams.sdkAppId = 1400000000;
+    enterParams.roomId = 1;
+    enterParams.userId = "profile_local";
+    enterParams.userSig = "fake";       //ģ SDK Уǩǿռ
+    cloud.enterRoom(enterParams, TRTCAppSceneVideoCall);
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    double elapsedSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    cloud.exitRoom();
+    cloud.setRemoteVideoRenderCallback(NULL, TRTCVideoPixelFormat_I420, TRTCVideoBufferType_Buffer, NULL);
+    cloud.removeCallback(&dispatcher);
+    std::vector<TRTCCallbackListenerStats> stats = dispatcher.getStats();
+    dispatcher.removeListener(&listener);
+
+    printf("users %u, render fps %u, %.1f s\n", userCount, renderFps, elapsedSec);
+    printf("enter room %llu ms, user enter %u, user exit %u\n",
+        (unsigned long long)listener.m_enterElapsed, (uint32_t)listener.m_userEnterCount, (uint32_t)listener.m_userExitCount);
+    printf("statistics %u, network quality %u, voice volume %u\n",
+        (uint32_t)listener.m_statisticsCount, (uint32_t)listener.m_qualityCount, (uint32_t)listener.m_volumeCount);
+    printf("frames %llu (%.1f/s), %.1f MB/s\n", (unsigned long long)renderer.m_frameCount,
+        renderer.m_frameCount / elapsedSec, renderer.m_byteCount / elapsedSec / 1000000.0);
+    for (size_t i = 0; i < stats.size(); ++i)
+    {
+        printf("dispatcher delivered %llu, dropped %llu, coalesced %llu, latency avg %llu us, p99 %llu us, max %llu us\n",
+            (unsigned long long)stats[i].deliveredCount, (unsigned long long)stats[i].droppedCount,
+            (unsigned long long)stats[i].coalescedCount, (unsigned long long)stats[i].avgLatencyUs,
+            (unsigned long long)stats[i].p99LatencyUs, (unsigned long long)stats[i].maxLatencyUs);
+    }
+    return 0;
+}
@@ -0,0 +1,105 @@
+#pragma once
+/*
+* Module:   Windows.hLinux ݲ㣩
+*
+* Function: ֻṩ SDK ͷļ TRTCFakeSDK Դļõ Windows 뺯 Linux ϱģ SDK
+*
+*    1.  Windows API¼Դļõӿʱٰ貹䡣
+*
+*    2. SDK ͷļеĻص std::recursive_mutex ʵ֣ Windows һͬһ߳ظ
+*
+*    3. Base.h  format_to õխַʽ vsnprintf ʵַ֣ҳת _wfopen_s ֻ
+*       ģ SDK ãʱӽ׶α
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <mutex>
+
+#define __declspec(x)
+#define WINAPI
+#define FALSE 0
+#define TRUE 1
+#define INFINITE 0xFFFFFFFF
+#define MAX_PATH 260
+#define CP_ACP 0
+#define CP_UTF8 65001
+#define _TRUNCATE ((size_t)-1)
+#define _Printf_format_string_
+
+typedef int BOOL;
+typedef long LONG;
+typedef unsigned int UINT;
+typedef uint32_t DWORD;
+typedef void* HANDLE;
+typedef void* HWND;
+
+struct RECT { LONG left, top, right, bottom; };
+struct SIZE { LONG cx, cy; };
+
+#define _countof(a) (sizeof(a) / sizeof((a)[0]))
+
+inline HANDLE CreateMutex(void*, BOOL bInitialOwner, const void*)
+{
+    std::recursive_mutex* mutex = new std::recursive_mutex;
+    if (bInitialOwner)
+        mutex->lock();
+    return mutex;
+}
+
+inline DWORD WaitForSingleObject(HANDLE handle, DWORD)
+{
+    static_cast<std::recursive_mutex*>(handle)->lock();
+    return 0;
+}
+
+inline BOOL ReleaseMutex(HANDLE handle)
+{
+    static_cast<std::recursive_mutex*>(handle)->unlock();
+    return TRUE;
+}
+
+inline BOOL CloseHandle(HANDLE handle)
+{
+    delete static_cast<std::recursive_mutex*>(handle);
+    return TRUE;
+}
+
+int MultiByteToWideChar(UINT codePage, DWORD flags, const char* src, int srcLen, wchar_t* dst, int dstLen);
+int WideCharToMultiByte(UINT codePage, DWORD flags, const wchar_t* src, int srcLen, char* dst, int dstLen,
+    const char* defaultChar, BOOL* usedDefaultChar);
+
+// MSVC һضʱ -1
+inline int _snprintf_s(char* buffer, size_t size, size_t, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int count = vsnprintf(buffer, size, format, args);
+    va_end(args);
+    return (count < 0 || (size_t)count >= size) ? -1 : count;
+}
+
+inline int _scprintf(const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int count = vsnprintf(NULL, 0, format, args);
+    va_end(args);
+    return count;
+}
+
+inline int sprintf_s(char* buffer, size_t size, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int count = vsnprintf(buffer, size, format, args);
+    va_end(args);
+    return count;
+}
+
+int _snwprintf_s(wchar_t* buffer, size_t size, size_t count, const wchar_t* format, ...);
+int _scwprintf(const wchar_t* format, ...);
+int swprintf_s(wchar_t* buffer, size_t size, const wchar_t* format, ...);
+int _wfopen_s(FILE** file, const wchar_t* fileName, const wchar_t* mode);
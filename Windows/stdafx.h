@@ -49,4 +49,5 @@
 
 #define WM_CUSTOM_CLOSE_MAINVIEW (WM_USER + 1)
 #define WM_CUSTOM_CLOSE_SETTINGVIEW (WM_USER + 1)
+#define WM_CUSTOM_STORAGE_CONFIG_CHANGED (WM_USER + 2)
 